@@ -8,19 +8,115 @@
 #include "mram.h"
 #include "main.h"
 #include "octospi.h"
+#include <string.h>
 
 #define DCC MRAM_DEFAULT_DC
-
-// Global Variables related to SPI and addressing configurations
-
-uint32_t InstMode = 0; // Instruction mode
-uint32_t Read = 0;	   // Read Command
-uint32_t Write = 0;	   // Write Command
-uint32_t AddMode = 0;  // Address mode
-uint32_t DatMode = 0;  // Data mode
-uint32_t AddSize = 0;  // Address size
-uint32_t CfgDc = 0;	   // Dummy cycles for configuration phase
-uint32_t DC = 0;	   // Dummy cycles for operation phase
+#define EMXXLX_REG_MAX_SIZE 16U // Largest register access mirrored in dual-quad mode
+
+#if defined(EMXXLX_USE_STATS)
+#define EMXXLX_STATS_BEGIN()				uint32_t stats_start = DWT->CYCCNT
+#define EMXXLX_STATS_END(__HANDLE__, __OP__, __BYTES__, __STATUS__) \
+		EMXXLX_Stats_Record((__HANDLE__), (__OP__), (__BYTES__), stats_start, (__STATUS__))
+#else
+#define EMXXLX_STATS_BEGIN()
+#define EMXXLX_STATS_END(__HANDLE__, __OP__, __BYTES__, __STATUS__)
+#endif /* EMXXLX_USE_STATS */
+
+#if defined(EMXXLX_USE_TRACE)
+#define EMXXLX_TRACE(__HANDLE__, __CMD__)	EMXXLX_Trace_Record((__HANDLE__), (__CMD__))
+
+// Command trace, kept across resets so that it can be dumped after a fault
+
+EMXXLX_TraceTypeDef EMXXLX_Trace __attribute__((section(".sram4")));
+#else
+#define EMXXLX_TRACE(__HANDLE__, __CMD__)
+#endif /* EMXXLX_USE_TRACE */
+
+#if defined(EMXXLX_USE_POWER)
+#define EMXXLX_POWER_WAKE(__HANDLE__)		EMXXLX_Power_Wake(__HANDLE__)
+#else
+#define EMXXLX_POWER_WAKE(__HANDLE__)		HAL_OK
+#endif /* EMXXLX_USE_POWER */
+
+// Initialized devices, used to route the OSPI callbacks to their handle
+
+static EMXXLX_HandleTypeDef *Devices[EMXXLX_MAX_DEVICES] = {NULL};
+
+// Calibration reference, alternating and walking bit patterns
+
+static const uint8_t CalPattern[EMXXLX_CAL_PATTERN_SIZE] = {
+	0x00, 0xFF, 0x55, 0xAA, 0x33, 0xCC, 0x0F, 0xF0,
+	0x01, 0xFE, 0x02, 0xFD, 0x04, 0xFB, 0x08, 0xF7,
+	0x10, 0xEF, 0x20, 0xDF, 0x40, 0xBF, 0x80, 0x7F,
+	0x96, 0x69, 0xA5, 0x5A, 0xC3, 0x3C, 0xE1, 0x1E,
+};
+
+static uint8_t EMXXLX_Register(EMXXLX_HandleTypeDef *hmram);
+static EMXXLX_HandleTypeDef *EMXXLX_Get_Handle(OSPI_HandleTypeDef *hospi);
+static void EMXXLX_Build_Commands(EMXXLX_HandleTypeDef *hmram);
+static uint8_t EMXXLX_Set_DualQuad(EMXXLX_HandleTypeDef *hmram, uint32_t DualQuad);
+static uint8_t EMXXLX_Set_Wrap(EMXXLX_HandleTypeDef *hmram, uint8_t Wrap);
+static uint8_t EMXXLX_Set_Interface(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+									uint8_t InterfaceMode);
+static uint8_t EMXXLX_Write_Changed(EMXXLX_HandleTypeDef *hmram, uint8_t Volatile, uint8_t *pData);
+static uint8_t EMXXLX_Erase_Build(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+								  uint32_t address, uint32_t size);
+static uint32_t EMXXLX_Erase_Plan(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint32_t size);
+
+static uint32_t EMXXLX_Dies(EMXXLX_HandleTypeDef *hmram);
+static uint32_t EMXXLX_Alignment(EMXXLX_HandleTypeDef *hmram);
+static uint32_t EMXXLX_Reg_Count(EMXXLX_HandleTypeDef *hmram, uint32_t size);
+static void EMXXLX_Apply_Dtr(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand);
+static void EMXXLX_Apply_Xip(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand, uint8_t Confirm);
+static uint32_t EMXXLX_Cmd_Cycles(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+								  uint32_t size);
+static uint32_t EMXXLX_Phase_Cycles(uint32_t bits, uint32_t Mode, uint8_t Dtr, uint32_t Dies);
+static uint8_t EMXXLX_Apply_Calibration(EMXXLX_HandleTypeDef *hmram, EMXXLX_CalibrationTypeDef *Calibration);
+static uint8_t EMXXLX_Calibration_Window(EMXXLX_HandleTypeDef *hmram, EMXXLX_CalibrationTypeDef *Calibration,
+										 uint32_t address);
+static uint8_t EMXXLX_Check_Pattern(EMXXLX_HandleTypeDef *hmram, uint32_t address);
+static uint8_t EMXXLX_Reg_Read(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+							   uint8_t *Value);
+static uint8_t EMXXLX_Reg_Write(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+								uint8_t *pData);
+static uint8_t EMXXLX_Command(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+							  uint32_t Timeout);
+static uint8_t EMXXLX_Command_IT(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand);
+#if defined(EMXXLX_USE_LL_READ)
+static uint8_t EMXXLX_Read_LL(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
+							  uint32_t size);
+#endif
+static uint8_t EMXXLX_Xfer_Start(EMXXLX_HandleTypeDef *hmram, uint8_t State, uint32_t address,
+								 uint8_t *pData, uint32_t size, EMXXLX_CallbackTypeDef Callback,
+								 void *Context);
+static uint8_t EMXXLX_Xfer_Chunk(EMXXLX_HandleTypeDef *hmram);
+static uint8_t EMXXLX_Xfer_Data(EMXXLX_HandleTypeDef *hmram);
+static uint8_t EMXXLX_Xfer_Ready(EMXXLX_HandleTypeDef *hmram);
+static uint8_t EMXXLX_Stripe_Start(EMXXLX_StripeTypeDef *hstripe, uint8_t State, uint32_t address,
+								   uint8_t *pData, uint32_t size, EMXXLX_StripeCallbackTypeDef Callback,
+								   void *Context);
+static uint8_t EMXXLX_Stripe_Next(EMXXLX_StripeTypeDef *hstripe, uint8_t Device);
+static void EMXXLX_Stripe_Callback(EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context);
+static void EMXXLX_Stripe_Release(EMXXLX_StripeTypeDef *hstripe, uint8_t Device, uint8_t Status);
+static void EMXXLX_Xfer_Complete(EMXXLX_HandleTypeDef *hmram, uint8_t Status);
+static uint8_t EMXXLX_Xfer_Release(EMXXLX_HandleTypeDef *hmram, uint8_t State,
+								   EMXXLX_CallbackTypeDef *Callback, void **Context);
+static void EMXXLX_Xfer_Notify(EMXXLX_HandleTypeDef *hmram, uint8_t State,
+							   EMXXLX_CallbackTypeDef Callback, void *Context, uint8_t Status);
+#if defined(EMXXLX_USE_TRACE)
+static void EMXXLX_Trace_Record(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand);
+#endif
+#if defined(EMXXLX_USE_STATS)
+static void EMXXLX_Stats_Record(EMXXLX_HandleTypeDef *hmram, uint8_t Op, uint32_t Bytes,
+								uint32_t Start, uint8_t Status);
+#endif
+#if defined(EMXXLX_USE_POWER)
+static uint8_t EMXXLX_Power_Command(EMXXLX_HandleTypeDef *hmram, uint8_t Instruction);
+static void EMXXLX_Power_Account(EMXXLX_HandleTypeDef *hmram, uint8_t State);
+#endif
+static uint8_t EMXXLX_AutoPolling_Command(EMXXLX_HandleTypeDef *hmram, OSPI_AutoPollingTypeDef *Config);
+static void EMXXLX_AutoPolling_Config(EMXXLX_HandleTypeDef *hmram, OSPI_AutoPollingTypeDef *Config);
+static uint8_t EMXXLX_MemoryMapped_Start(EMXXLX_HandleTypeDef *hmram, OSPI_MemoryMappedTypeDef *sMemMappedCfg);
 
 /**
  * @brief Receive an amount of data in blocking mode.
@@ -44,28 +140,64 @@ uint32_t DC = 0;	   // Dummy cycles for operation phase
 /**
  *  @brief Initialize the device with the parameters on
  * 		   EMXXLX_ConfigurationTypeDef and InterfaceMode.
- * 	@param Ctx				SPI peripheral handle.
+ * 	@param hmram			MRAM device handle.
  *  @param Config			EMXXLX_ConfigurationTypeDef Contaning the parameters.
- *  @param InterfaceMode	Can be a either 1, 2, 4 or 8 based in the number of io lines.
+ *  @param InterfaceMode	Can be a either 1, 2, 4 or 8 based in the number of io lines,
+ * 							EMXXLX_DUALQUAD_MODE for two quad devices sharing the port, or
+ * 							EMXXLX_OCTAL_DTR_MODE / EMXXLX_QUAD_DTR_MODE for double transfer
+ * 							rate, Config.SpiInterfaceMode must then be MRAM_ODTR_x_DS or
+ * 							MRAM_QDTR_x_DS.
+ *  @note  In octal DTR mode addresses and sizes of memory transfers must be even.
+ *  @note  In dual-quad mode Config is written to both devices and the address
+ * 		   space doubles, even bytes are stored on the device of IO[3:0] and
+ * 		   odd bytes on the device of IO[7:4]. Addresses and sizes must be even.
+ *  @note  A device already running the target interface is not reset, and
+ * 		   only the configuration bytes which differ are written.
  *  @retval HAL status
  */
-uint8_t EMXXLX_Init(OSPI_HandleTypeDef *Ctx, EMXXLX_ConfigurationTypeDef Config,
+uint8_t EMXXLX_Init(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
 		uint8_t InterfaceMode) {
-	uint8_t nvol[9], vol[9], temp[9] = { 0 }, null = 0;
-	jesd_reset();
+	uint8_t nvol[9], vol[9], temp[9] = { 0 }, id[3] = { 0 }, null = 0, warm;
+
+	if (EMXXLX_Register(hmram) != HAL_OK) {
+		return HAL_ERROR;
+	}
+
+	/* The DTR modes need the matching device interface mode */
+	if ((InterfaceMode == EMXXLX_OCTAL_DTR_MODE
+			&& (Config.SpiInterfaceMode | MRAM_INTERFACE_DS) != MRAM_ODTR_W_DS)
+			|| (InterfaceMode == EMXXLX_QUAD_DTR_MODE
+			&& (Config.SpiInterfaceMode | MRAM_INTERFACE_DS) != MRAM_QDTR_W_DS)) {
+		return HAL_ERROR;
+	}
 
-	InstMode = HAL_OSPI_INSTRUCTION_1_LINE;
-	Read = MRAM_READ_FAST_CMD;
-	Write = MRAM_WRITE_CMD;
-	AddMode = HAL_OSPI_ADDRESS_1_LINE;
-	DatMode = HAL_OSPI_DATA_1_LINE;
-	AddSize = HAL_OSPI_ADDRESS_24_BITS;
+	if (EMXXLX_Set_DualQuad(hmram, (InterfaceMode == EMXXLX_DUALQUAD_MODE) ?
+			HAL_OSPI_DUALQUAD_ENABLE : HAL_OSPI_DUALQUAD_DISABLE) != HAL_OK) {
+		return HAL_ERROR;
+	}
 
+	hmram->XferState = EMXXLX_XFER_IDLE;
+	hmram->XferCallback = NULL;
+	hmram->XferContext = NULL;
+	hmram->RegsValid = 0;
+	hmram->Xip = Config.XIPConfiguration;
+	hmram->Wrap = Config.WrapConfiguration;
+	hmram->EraseValue = Config.EraseBitValue;
+#if defined(EMXXLX_USE_STATS)
+	EMXXLX_ResetStats(hmram);
+#endif
+#if defined(EMXXLX_USE_TRACE)
+	if (EMXXLX_Trace.Magic != EMXXLX_TRACE_MAGIC)
+	{
+		EMXXLX_Trace_Reset();
+	}
+#endif
 	nvol[0] = Config.SpiInterfaceMode;
 	nvol[1] = Config.DummyCycles;
 	nvol[2] = 0xFF;
 	nvol[3] = Config.DriverStrenght;
-	nvol[4] = Config.AddedDsDelay;
+	nvol[4] = ((hmram->Calibration.Valid != 0) && (hmram->Calibration.InterfaceMode == InterfaceMode)) ?
+			hmram->Calibration.DsDelay : Config.AddedDsDelay;
 	nvol[5] = Config.AddressMode;
 	nvol[6] = Config.XIPConfiguration;
 	nvol[7] = Config.WrapConfiguration;
@@ -74,50 +206,228 @@ uint8_t EMXXLX_Init(OSPI_HandleTypeDef *Ctx, EMXXLX_ConfigurationTypeDef Config,
 	for (uint8_t i = 0; i < 9; i++) {
 		vol[i] = nvol[i];
 	}
+	/* Indirect reads cross the wrap boundary, the wrap is only set in memory-mapped mode */
+	vol[7] = MRAM_CONTINUOUS_WRAP;
 	vol[8] = vol[8] | (Config.OtpLockEnable & 0x01) << 2;
-	EMXXLX_Clear_flags(Ctx);
-	EMXXLX_Write_Enable(Ctx);
 
-	EMXXLX_Read_Vol(Ctx, 0, temp, 9);
-	EMXXLX_Read_Nonvol(Ctx, 0, temp, 9);
+	/* Warm start when the device already answers in the target interface,
+	   the manufacturer ID cannot be faked by a floating bus */
+	if (EMXXLX_Set_Interface(hmram, Config, InterfaceMode) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	warm = (EMXXLX_Read_ID(hmram, id) == HAL_OK) && (id[0] == MRAM_MANUFACTURER_ID)
+			&& (EMXXLX_Read_Vol(hmram, 0, temp, 9) == HAL_OK) && (temp[0] == vol[0])
+			&& (temp[5] == vol[5]);
+
+	if (warm == 0) {
+		jesd_reset(hmram);
+
+		/* The reset reloads the volatile registers from the nonvolatile ones,
+		   the device answers in the target interface once they were written */
+		warm = (EMXXLX_Read_ID(hmram, id) == HAL_OK) && (id[0] == MRAM_MANUFACTURER_ID)
+				&& (EMXXLX_Read_Vol(hmram, 0, temp, 9) == HAL_OK) && (temp[0] == vol[0])
+				&& (temp[5] == vol[5]);
+	}
+
+	if (warm == 0) {
+		hmram->InstMode = HAL_OSPI_INSTRUCTION_1_LINE;
+		hmram->Read = MRAM_READ_FAST_CMD;
+		hmram->Write = MRAM_WRITE_CMD;
+		hmram->AddMode = HAL_OSPI_ADDRESS_1_LINE;
+		hmram->DatMode = HAL_OSPI_DATA_1_LINE;
+		hmram->AddSize = HAL_OSPI_ADDRESS_24_BITS;
+		hmram->Dtr = 0;
+		hmram->DQSMode = HAL_OSPI_DQS_DISABLE;
+		hmram->DC = MRAM_DEFAULT_DC;
+		hmram->CfgDc = 0;
+		EMXXLX_Build_Commands(hmram);
+	}
+	EMXXLX_Clear_flags(hmram);
+
+	/* Only the nonvolatile bytes which differ are written */
+	if (EMXXLX_Write_Changed(hmram, 0, nvol) != HAL_OK) {
+		return HAL_ERROR;
+	}
+
+	if (warm == 0) {
+		/* The interface switches as soon as the volatile registers are written */
+		EMXXLX_Write_Enable(hmram);
+		EMXXLX_Write_Vol(hmram, 0, vol, 9);
+
+		if (EMXXLX_Set_Interface(hmram, Config, InterfaceMode) != HAL_OK) {
+			return HAL_ERROR;
+		}
+	} else if (EMXXLX_Write_Changed(hmram, 1, vol) != HAL_OK) {
+		return HAL_ERROR;
+	}
+
+	EMXXLX_Write_Enable(hmram);
+	EMXXLX_Write_Status(hmram, &null);
+
+	EMXXLX_Read_Status(hmram, &temp[8]);
+	if ((temp[8] & 0x2) == 0) {
+		return HAL_ERROR;
+	}
+
+	EMXXLX_Read_Nonvol(hmram, 0, temp, 9);
+	for (uint8_t i = 0; i < 9; i++) {
+		if (temp[i] != nvol[i]) {
+			return HAL_ERROR;
+		}
+	}
+
+	EMXXLX_Read_Vol(hmram, 0, temp, 9);
+	for (uint8_t i = 0; i < 9; i++) {
+		if (temp[i] != vol[i]) {
+			return HAL_ERROR;
+		}
+	}
+
+	memcpy(hmram->Regs[0], nvol, 9);
+	memcpy(hmram->Regs[1], vol, 9);
+	hmram->RegsValid = 1;
+
+	/* A calibration of this interface mode sets the bus timings */
+	if ((hmram->Calibration.Valid != 0) && (hmram->Calibration.InterfaceMode == InterfaceMode)) {
+		return EMXXLX_Apply_Calibration(hmram, &hmram->Calibration);
+	}
+
+	hmram->hospi->Init.ClockPrescaler = 1;
+	hmram->hospi->Init.DelayHoldQuarterCycle = (hmram->Dtr != 0) ? HAL_OSPI_DHQC_ENABLE
+			: HAL_OSPI_DHQC_DISABLE;
+
+	HAL_OSPI_Init(hmram->hospi);
+	return HAL_OK;
+}
+
+/**
+ *  @brief Switch an initialized device to another interface mode and dummy
+ * 		   cycle setting, through the volatile registers only. The
+ * 		   nonvolatile registers are left as EMXXLX_Init wrote them and the
+ * 		   device is back in that configuration after a reset.
+ *  @note  The dual-quad mode cannot be entered or left this way, use
+ * 		   EMXXLX_Init. The clock prescaler is kept unless a calibration of
+ * 		   the target interface mode is stored in the handle.
+ * 	@param hmram			MRAM device handle, initialized.
+ *  @param Config			Configuration given to EMXXLX_Init, only SpiInterfaceMode
+ * 							and DummyCycles may differ.
+ *  @param InterfaceMode	Target InterfaceMode, as for EMXXLX_Init.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Set_Mode(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+		uint8_t InterfaceMode)
+{
+	uint8_t vol[2], temp[2];
+
+	if ((InterfaceMode == EMXXLX_DUALQUAD_MODE) || (EMXXLX_Dies(hmram) != 1U)
+			|| (hmram->XferState != EMXXLX_XFER_IDLE))
+	{
+		return HAL_ERROR;
+	}
+
+	/* The DTR modes need the matching device interface mode */
+	if ((InterfaceMode == EMXXLX_OCTAL_DTR_MODE
+			&& (Config.SpiInterfaceMode | MRAM_INTERFACE_DS) != MRAM_ODTR_W_DS)
+			|| (InterfaceMode == EMXXLX_QUAD_DTR_MODE
+			&& (Config.SpiInterfaceMode | MRAM_INTERFACE_DS) != MRAM_QDTR_W_DS))
+	{
+		return HAL_ERROR;
+	}
+
+	/* Volatile registers 0 and 1, the interface switches at the end of the command */
+	vol[0] = Config.SpiInterfaceMode;
+	vol[1] = Config.DummyCycles;
+	if (EMXXLX_Write_Enable(hmram) != HAL_OK || EMXXLX_Write_Vol(hmram, 0, vol, 2) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	if (EMXXLX_Set_Interface(hmram, Config, InterfaceMode) != HAL_OK
+			|| EMXXLX_Read_Vol(hmram, 0, temp, 2) != HAL_OK
+			|| temp[0] != vol[0] || temp[1] != vol[1])
+	{
+		return HAL_ERROR;
+	}
+
+	/* A calibration of this interface mode sets the bus timings */
+	if ((hmram->Calibration.Valid != 0) && (hmram->Calibration.InterfaceMode == InterfaceMode))
+	{
+		return EMXXLX_Apply_Calibration(hmram, &hmram->Calibration);
+	}
 
-	EMXXLX_Write_Nonvol(Ctx, 0, nvol, 9);
+	hmram->hospi->Init.DelayHoldQuarterCycle = (hmram->Dtr != 0) ? HAL_OSPI_DHQC_ENABLE
+			: HAL_OSPI_DHQC_DISABLE;
 
-	EMXXLX_Write_Vol(Ctx, 0, vol, 9);
+	return HAL_OSPI_Init(hmram->hospi);
+}
 
-	DC = Config.DummyCycles;
+/**
+ *  @brief Set the commands and phase modes of the handle for an interface
+ * 		   mode, the device must already run it.
+ * 	@param hmram			MRAM device handle.
+ *  @param Config			Device configuration.
+ *  @param InterfaceMode	InterfaceMode given to EMXXLX_Init.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Set_Interface(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+									uint8_t InterfaceMode)
+{
+	hmram->Dtr = 0;
+	hmram->DQSMode = HAL_OSPI_DQS_DISABLE;
+	hmram->DC = Config.DummyCycles;
+	hmram->CfgDc = 0;
 	switch (InterfaceMode) {
 	case 1:
-		InstMode = HAL_OSPI_INSTRUCTION_1_LINE;
-		Read = MRAM_READ_FAST_CMD;
-		Write = MRAM_WRITE_CMD;
-		AddMode = HAL_OSPI_ADDRESS_1_LINE;
-		DatMode = HAL_OSPI_DATA_1_LINE;
+		hmram->InstMode = HAL_OSPI_INSTRUCTION_1_LINE;
+		hmram->Read = MRAM_READ_FAST_CMD;
+		hmram->Write = MRAM_WRITE_CMD;
+		hmram->AddMode = HAL_OSPI_ADDRESS_1_LINE;
+		hmram->DatMode = HAL_OSPI_DATA_1_LINE;
 		break;
 
 	case 2:
-		InstMode = HAL_OSPI_INSTRUCTION_2_LINES;
-		Read = MRAM_READ_DUAL_O_CMD;
-		Write = MRAM_WRITE_DUAL_CMD;
-		AddMode = HAL_OSPI_ADDRESS_2_LINES;
-		DatMode = HAL_OSPI_DATA_2_LINES;
+		hmram->InstMode = HAL_OSPI_INSTRUCTION_2_LINES;
+		hmram->Read = MRAM_READ_DUAL_O_CMD;
+		hmram->Write = MRAM_WRITE_DUAL_CMD;
+		hmram->AddMode = HAL_OSPI_ADDRESS_2_LINES;
+		hmram->DatMode = HAL_OSPI_DATA_2_LINES;
 		break;
 
 	case 4:
-		InstMode = HAL_OSPI_INSTRUCTION_4_LINES;
-		Read = MRAM_READ_QUAD_O_CMD;
-		Write = MRAM_WRITE_QUAD_CMD;
-		AddMode = HAL_OSPI_ADDRESS_4_LINES;
-		DatMode = HAL_OSPI_DATA_4_LINES;
+	case EMXXLX_DUALQUAD_MODE:
+		hmram->InstMode = HAL_OSPI_INSTRUCTION_4_LINES;
+		hmram->Read = MRAM_READ_QUAD_O_CMD;
+		hmram->Write = MRAM_WRITE_QUAD_CMD;
+		hmram->AddMode = HAL_OSPI_ADDRESS_4_LINES;
+		hmram->DatMode = HAL_OSPI_DATA_4_LINES;
 		break;
 
 	case 8:
-		InstMode = HAL_OSPI_INSTRUCTION_8_LINES;
-		Read = MRAM_READ_OCTO_O_CMD;
-		Write = MRAM_WRITE_OCTO_E_CMD;
-		AddMode = HAL_OSPI_ADDRESS_8_LINES;
-		DatMode = HAL_OSPI_DATA_8_LINES;
-		CfgDc = MRAM_8_DC;
+		hmram->InstMode = HAL_OSPI_INSTRUCTION_8_LINES;
+		hmram->Read = MRAM_READ_OCTO_O_CMD;
+		hmram->Write = MRAM_WRITE_OCTO_E_CMD;
+		hmram->AddMode = HAL_OSPI_ADDRESS_8_LINES;
+		hmram->DatMode = HAL_OSPI_DATA_8_LINES;
+		hmram->CfgDc = MRAM_8_DC;
+		break;
+
+	case EMXXLX_QUAD_DTR_MODE:
+		hmram->InstMode = HAL_OSPI_INSTRUCTION_4_LINES;
+		hmram->Read = MRAM_READ_DTR_QUAD_IO_CMD;
+		hmram->Write = MRAM_WRITE_QUAD_E_CMD;
+		hmram->AddMode = HAL_OSPI_ADDRESS_4_LINES;
+		hmram->DatMode = HAL_OSPI_DATA_4_LINES;
+		hmram->Dtr = 1;
+		break;
+
+	case EMXXLX_OCTAL_DTR_MODE:
+		hmram->InstMode = HAL_OSPI_INSTRUCTION_8_LINES;
+		hmram->Read = MRAM_READ_DTR_OCTO_IO_CMD;
+		hmram->Write = MRAM_WRITE_OCTO_E_CMD;
+		hmram->AddMode = HAL_OSPI_ADDRESS_8_LINES;
+		hmram->DatMode = HAL_OSPI_DATA_8_LINES;
+		hmram->CfgDc = MRAM_8_DC;
+		hmram->Dtr = 1;
 		break;
 
 	default:
@@ -125,54 +435,354 @@ uint8_t EMXXLX_Init(OSPI_HandleTypeDef *Ctx, EMXXLX_ConfigurationTypeDef Config,
 	}
 
 	if (Config.AddressMode != 0xFF) {
-		AddSize = HAL_OSPI_ADDRESS_32_BITS;
+		hmram->AddSize = HAL_OSPI_ADDRESS_32_BITS;
 	} else {
-		AddSize = HAL_OSPI_ADDRESS_24_BITS;
+		hmram->AddSize = HAL_OSPI_ADDRESS_24_BITS;
 	}
 
-	EMXXLX_Write_Enable(Ctx);
-	EMXXLX_Write_Status(Ctx, &null);
+	/* Reads are sampled on the DS strobe when the device drives it */
+	if ((hmram->Dtr != 0) && ((Config.SpiInterfaceMode & MRAM_INTERFACE_DS) != 0)) {
+		hmram->DQSMode = HAL_OSPI_DQS_ENABLE;
+	}
+	EMXXLX_Build_Commands(hmram);
 
-	EMXXLX_Read_Status(Ctx, &temp[8]);
-	if ((temp[8] & 0x2) == 0) {
+	return HAL_OK;
+}
+
+/**
+ *  @brief Write the configuration register bytes which differ from the
+ * 		   device contents, contiguous bytes in one command.
+ * 	@param hmram			MRAM device handle.
+ *  @param Volatile			0 for the nonvolatile registers, 1 for the volatile ones.
+ *  @param pData			Target contents of the 9 registers.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Write_Changed(EMXXLX_HandleTypeDef *hmram, uint8_t Volatile, uint8_t *pData)
+{
+	uint8_t current[9];
+	uint8_t first, last;
+
+	if (((Volatile != 0) ? EMXXLX_Read_Vol(hmram, 0, current, 9)
+			: EMXXLX_Read_Nonvol(hmram, 0, current, 9)) != HAL_OK) {
 		return HAL_ERROR;
 	}
 
-	EMXXLX_Read_Nonvol(Ctx, 0, temp, 9);
-	for (uint8_t i = 0; i < 9; i++) {
-		if (temp[i] != nvol[i]) {
+	for (first = 0; first < 9; first = last) {
+		if (current[first] == pData[first]) {
+			last = first + 1;
+			continue;
+		}
+
+		last = first + 1;
+		while ((last < 9) && (current[last] != pData[last])) {
+			last++;
+		}
+
+		if (EMXXLX_Write_Enable(hmram) != HAL_OK) {
 			return HAL_ERROR;
 		}
-	}
 
-	EMXXLX_Read_Vol(Ctx, 0, temp, 9);
-	for (uint8_t i = 0; i < 9; i++) {
-		if (temp[i] != vol[i]) {
+		if (Volatile != 0) {
+			if (EMXXLX_Write_Vol(hmram, first, &pData[first], last - first) != HAL_OK) {
+				return HAL_ERROR;
+			}
+		} else if (EMXXLX_Write_Nonvol(hmram, first, &pData[first], last - first) != HAL_OK
+				|| EMXXLX_Polling_MemReady(hmram, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) {
 			return HAL_ERROR;
 		}
 	}
 
-	Ctx->Init.ClockPrescaler = 1;
+	return HAL_OK;
+}
+
+/**
+ *  @brief Record the device handle so that the OSPI callbacks of its
+ * 		   peripheral can be routed to it.
+ * 	@param hmram			MRAM device handle, its hospi field must be set.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Register(EMXXLX_HandleTypeDef *hmram)
+{
+	uint8_t i;
+
+	if ((hmram == NULL) || (hmram->hospi == NULL))
+	{
+		return HAL_ERROR;
+	}
+
+	for (i = 0; i < EMXXLX_MAX_DEVICES; i++)
+	{
+		if (Devices[i] == hmram)
+		{
+			return HAL_OK;
+		}
+	}
+
+	for (i = 0; i < EMXXLX_MAX_DEVICES; i++)
+	{
+		if (Devices[i] == NULL)
+		{
+			Devices[i] = hmram;
+			return HAL_OK;
+		}
+	}
+
+	return HAL_ERROR;
+}
+
+/**
+ *  @brief Find the device handle driven by an OSPI peripheral.
+ * 	@param hospi			SPI peripheral handle.
+ *  @retval Device handle, NULL if the peripheral drives no initialized device.
+ */
+static EMXXLX_HandleTypeDef *EMXXLX_Get_Handle(OSPI_HandleTypeDef *hospi)
+{
+	for (uint8_t i = 0; i < EMXXLX_MAX_DEVICES; i++)
+	{
+		if ((Devices[i] != NULL) && (Devices[i]->hospi == hospi))
+		{
+			return Devices[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ *  @brief Switch the OCTOSPI between single device and dual-quad mode. In
+ * 		   dual-quad mode the memory size covers both devices.
+ * 	@param hmram			MRAM device handle.
+ *  @param DualQuad			HAL_OSPI_DUALQUAD_ENABLE or HAL_OSPI_DUALQUAD_DISABLE.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Set_DualQuad(EMXXLX_HandleTypeDef *hmram, uint32_t DualQuad)
+{
+	if (hmram->hospi->Init.DualQuad == DualQuad)
+	{
+		return HAL_OK;
+	}
+
+	hmram->hospi->Init.DualQuad = DualQuad;
+	hmram->hospi->Init.DeviceSize = (DualQuad == HAL_OSPI_DUALQUAD_ENABLE) ?
+			OSPI_FLASH_SIZE + 1 : OSPI_FLASH_SIZE;
+
+	if (HAL_OSPI_Init(hmram->hospi) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Set the wrap boundary of the device reads and the matching OCTOSPI
+ * 		   wrap size. In dual-quad mode a burst covers both devices.
+ * 	@param hmram			MRAM device handle, not in memory-mapped mode.
+ *  @param Wrap				A value of the Wrap Configuration Values.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Set_Wrap(EMXXLX_HandleTypeDef *hmram, uint8_t Wrap)
+{
+	uint32_t WrapSize;
+
+	switch (Wrap) {
+	case MRAM_16BYTE_WRAP:
+		WrapSize = (EMXXLX_Dies(hmram) > 1U) ? HAL_OSPI_WRAP_32_BYTES : HAL_OSPI_WRAP_16_BYTES;
+		break;
+
+	case MRAM_32BYTE_WRAP:
+		WrapSize = (EMXXLX_Dies(hmram) > 1U) ? HAL_OSPI_WRAP_64_BYTES : HAL_OSPI_WRAP_32_BYTES;
+		break;
+
+	case MRAM_64BYTE_WRAP:
+		WrapSize = (EMXXLX_Dies(hmram) > 1U) ? HAL_OSPI_WRAP_128_BYTES : HAL_OSPI_WRAP_64_BYTES;
+		break;
+
+	default:
+		Wrap = MRAM_CONTINUOUS_WRAP;
+		WrapSize = HAL_OSPI_WRAP_NOT_SUPPORTED;
+		break;
+	}
+
+	if (hmram->hospi->Init.WrapSize == WrapSize)
+	{
+		return HAL_OK;
+	}
+
+	/* Volatile register 7 holds the wrap configuration */
+	if ((EMXXLX_Write_Enable(hmram) != HAL_OK) || (EMXXLX_Write_Vol(hmram, 7, &Wrap, 1) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	hmram->hospi->Init.WrapSize = WrapSize;
+
+	if (HAL_OSPI_Init(hmram->hospi) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
 
-	HAL_OSPI_Init(Ctx);
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Refactor(OSPI_HandleTypeDef *Ctx)
+/**
+ *  @brief Number of devices answering each command of the handle.
+ * 	@param hmram			MRAM device handle.
+ *  @retval 2 in dual-quad mode, 1 otherwise.
+ */
+static uint32_t EMXXLX_Dies(EMXXLX_HandleTypeDef *hmram)
+{
+	return (hmram->hospi->Init.DualQuad == HAL_OSPI_DUALQUAD_ENABLE) ? 2U : 1U;
+}
+
+/**
+ *  @brief Smallest amount of bytes moved by a data phase, addresses and
+ * 		   sizes of memory transfers must be multiples of it.
+ * 	@param hmram			MRAM device handle.
+ *  @retval 2 in dual-quad and octal DTR modes, 1 otherwise.
+ */
+static uint32_t EMXXLX_Alignment(EMXXLX_HandleTypeDef *hmram)
+{
+	if ((hmram->Dtr != 0) && (hmram->DatMode == HAL_OSPI_DATA_8_LINES))
+	{
+		return 2U;
+	}
+
+	return EMXXLX_Dies(hmram);
+}
+
+/**
+ *  @brief Amount of bytes on the bus for a register access of size bytes
+ * 		   per device.
+ * 	@param hmram			MRAM device handle.
+ *  @param size				Register bytes per device.
+ *  @retval Data phase length
+ */
+static uint32_t EMXXLX_Reg_Count(EMXXLX_HandleTypeDef *hmram, uint32_t size)
+{
+	uint32_t count = size * EMXXLX_Dies(hmram);
+
+	return (count + EMXXLX_Alignment(hmram) - 1U) & ~(EMXXLX_Alignment(hmram) - 1U);
+}
+
+/**
+ *  @brief Switch the phases of a command to double transfer rate when the
+ * 		   device runs a DTR interface mode.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Command to be updated.
+ */
+static void EMXXLX_Apply_Dtr(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand)
+{
+	if (hmram->Dtr == 0)
+	{
+		return;
+	}
+
+	sCommand->InstructionDtrMode = HAL_OSPI_INSTRUCTION_DTR_ENABLE;
+
+	if (sCommand->AddressMode != HAL_OSPI_ADDRESS_NONE)
+	{
+		sCommand->AddressDtrMode = HAL_OSPI_ADDRESS_DTR_ENABLE;
+	}
+
+	if (sCommand->AlternateBytesMode != HAL_OSPI_ALTERNATE_BYTES_NONE)
+	{
+		sCommand->AlternateBytesDtrMode = HAL_OSPI_ALTERNATE_BYTES_DTR_ENABLE;
+	}
+
+	if (sCommand->DataMode != HAL_OSPI_DATA_NONE)
+	{
+		sCommand->DataDtrMode = HAL_OSPI_DATA_DTR_ENABLE;
+	}
+}
+
+/**
+ *  @brief Drive the XIP confirmation bit of a read during its first dummy
+ * 		   cycles. The alternate bytes take the place of these cycles so
+ * 		   that the device still sees hmram->DC cycles before the data.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Read command to be updated, Apply_Dtr must follow.
+ *  @param Confirm			EMXXLX_XIP_CONFIRM to stay in XIP mode, EMXXLX_XIP_EXIT to leave it.
+ */
+static void EMXXLX_Apply_Xip(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand, uint8_t Confirm)
+{
+	uint32_t cycles;
+
+	/* One byte per device, a whole clock cycle in octal DTR */
+	sCommand->AlternateBytesSize = (EMXXLX_Alignment(hmram) > 1U) ?
+			HAL_OSPI_ALTERNATE_BYTES_16_BITS : HAL_OSPI_ALTERNATE_BYTES_8_BITS;
+	sCommand->AlternateBytes = (Confirm == EMXXLX_XIP_CONFIRM) ? 0x0000U : 0xFFFFU;
+	sCommand->AlternateBytesMode = ((hmram->AddMode >> OCTOSPI_CCR_ADMODE_Pos) & 0x7U) << OCTOSPI_CCR_ABMODE_Pos;
+
+	cycles = EMXXLX_Phase_Cycles(8U * (((sCommand->AlternateBytesSize >> OCTOSPI_CCR_ABSIZE_Pos) & 0x3U) + 1U),
+								 hmram->AddMode >> OCTOSPI_CCR_ADMODE_Pos, hmram->Dtr, EMXXLX_Dies(hmram));
+	sCommand->DummyCycles = (hmram->DC > cycles) ? (hmram->DC - cycles) : 0U;
+}
+
+/**
+ *  @brief Build the command templates of the hot paths from the current
+ * 		   interface settings, so that each call only sets the address and
+ * 		   the length of the transfer.
+ */
+static void EMXXLX_Build_Commands(EMXXLX_HandleTypeDef *hmram)
+{
+	memset(&hmram->CmdSet, 0, sizeof(hmram->CmdSet));
+
+	hmram->CmdSet.Read.Instruction = hmram->Read;
+	hmram->CmdSet.Read.InstructionMode = hmram->InstMode;
+	hmram->CmdSet.Read.AddressMode = hmram->AddMode;
+	hmram->CmdSet.Read.AddressSize = hmram->AddSize;
+	hmram->CmdSet.Read.DataMode = hmram->DatMode;
+	hmram->CmdSet.Read.DummyCycles = hmram->DC;
+	hmram->CmdSet.Read.DQSMode = hmram->DQSMode;
+	EMXXLX_Apply_Dtr(hmram, &hmram->CmdSet.Read);
+	hmram->CmdSet.ReadCcr = hmram->CmdSet.Read.InstructionMode | hmram->CmdSet.Read.InstructionDtrMode
+			| hmram->CmdSet.Read.InstructionSize | hmram->CmdSet.Read.AddressMode
+			| hmram->CmdSet.Read.AddressDtrMode | hmram->CmdSet.Read.AddressSize
+			| hmram->CmdSet.Read.DataMode | hmram->CmdSet.Read.DataDtrMode
+			| hmram->CmdSet.Read.DQSMode | hmram->CmdSet.Read.SIOOMode;
+
+	hmram->CmdSet.Write.Instruction = hmram->Write;
+	hmram->CmdSet.Write.InstructionMode = hmram->InstMode;
+	hmram->CmdSet.Write.AddressMode = hmram->AddMode;
+	hmram->CmdSet.Write.AddressSize = hmram->AddSize;
+	hmram->CmdSet.Write.DataMode = hmram->DatMode;
+	EMXXLX_Apply_Dtr(hmram, &hmram->CmdSet.Write);
+
+	hmram->CmdSet.WriteEnable.Instruction = MRAM_WRITE_ENABLE_CMD;
+	hmram->CmdSet.WriteEnable.InstructionMode = hmram->InstMode;
+	EMXXLX_Apply_Dtr(hmram, &hmram->CmdSet.WriteEnable);
+
+	hmram->CmdSet.ReadFlags.Instruction = MRAM_READ_FLAGS_CMD;
+	hmram->CmdSet.ReadFlags.InstructionMode = hmram->InstMode;
+	hmram->CmdSet.ReadFlags.DataMode = hmram->DatMode;
+	hmram->CmdSet.ReadFlags.NbData = EMXXLX_Reg_Count(hmram, 1);
+	hmram->CmdSet.ReadFlags.DummyCycles = hmram->CfgDc;
+	hmram->CmdSet.ReadFlags.DQSMode = hmram->DQSMode;
+	EMXXLX_Apply_Dtr(hmram, &hmram->CmdSet.ReadFlags);
+}
+
+uint8_t EMXXLX_Refactor(EMXXLX_HandleTypeDef *hmram)
 {
 	//Necessary variables
 	uint8_t vol[9], temp[9], null[9], set[9];
 	memset(null, 0, 9);
 	memset(set, 0xFF, 9);
-	jesd_reset();
+	hmram->Dtr = 0;
+	hmram->DQSMode = HAL_OSPI_DQS_DISABLE;
+	hmram->Xip = MRAM_XIP_DISABLE;
+	hmram->Wrap = MRAM_CONTINUOUS_WRAP;
+	hmram->EraseValue = MRAM_ERASE_VALUE_1;
+	jesd_reset(hmram);
 
 	//Default device mode settings
-	InstMode = HAL_OSPI_INSTRUCTION_1_LINE;
-	Read = MRAM_READ_FAST_CMD;
-	Write = MRAM_WRITE_CMD;
-	AddMode = HAL_OSPI_ADDRESS_1_LINE;
-	DatMode = HAL_OSPI_DATA_1_LINE;
-	AddSize = HAL_OSPI_ADDRESS_24_BITS;
+	hmram->InstMode = HAL_OSPI_INSTRUCTION_1_LINE;
+	hmram->Read = MRAM_READ_FAST_CMD;
+	hmram->Write = MRAM_WRITE_CMD;
+	hmram->AddMode = HAL_OSPI_ADDRESS_1_LINE;
+	hmram->DatMode = HAL_OSPI_DATA_1_LINE;
+	hmram->AddSize = HAL_OSPI_ADDRESS_24_BITS;
+	EMXXLX_Build_Commands(hmram);
 
 	//Operational device mode settings
 	vol[0] = MRAM_OSPI_W_DS;
@@ -186,37 +796,38 @@ uint8_t EMXXLX_Refactor(OSPI_HandleTypeDef *Ctx)
 	vol[8] = (MRAM_ERASE_VALUE_1 & 0x01) << 7 | (MRAM_RESET_ENABLE & 0x01) << 1 | (MRAM_NONVOLATILE & 0x01) | (MRAM_OTPLOCK_ENABLE & 0x01) << 2;
 
 	//Start of operation
-	EMXXLX_Clear_flags(Ctx);
-	EMXXLX_Write_Enable(Ctx);
+	EMXXLX_Clear_flags(hmram);
+	EMXXLX_Write_Enable(hmram);
 
 	temp[0] = 0x6B;									
-	EMXXLX_Write_Vol(Ctx, 0x1E, &temp[0], 1);		//Writes ID to enter DFU
-	EMXXLX_Write_Vol(Ctx, 0, vol, 9);				//Configures device interface
+	EMXXLX_Write_Vol(hmram, 0x1E, &temp[0], 1);		//Writes ID to enter DFU
+	EMXXLX_Write_Vol(hmram, 0, vol, 9);				//Configures device interface
 
 	//Configuring IP interface
-	InstMode = HAL_OSPI_INSTRUCTION_8_LINES;
-	Read = MRAM_READ_DTR_OCTO_O_CMD;
-	Write = MRAM_WRITE_OCTO_E_CMD;
-	AddMode = HAL_OSPI_ADDRESS_8_LINES;
-	AddSize = HAL_OSPI_ADDRESS_32_BITS;
-	DatMode = HAL_OSPI_DATA_8_LINES;
-	CfgDc = MRAM_8_DC;
+	hmram->InstMode = HAL_OSPI_INSTRUCTION_8_LINES;
+	hmram->Read = MRAM_READ_DTR_OCTO_O_CMD;
+	hmram->Write = MRAM_WRITE_OCTO_E_CMD;
+	hmram->AddMode = HAL_OSPI_ADDRESS_8_LINES;
+	hmram->AddSize = HAL_OSPI_ADDRESS_32_BITS;
+	hmram->DatMode = HAL_OSPI_DATA_8_LINES;
+	hmram->CfgDc = MRAM_8_DC;
+	EMXXLX_Build_Commands(hmram);
 
 	//Initialize Nonvol registers
-	EMXXLX_Write_Nonvol(Ctx, 0, null, 9);
-	EMXXLX_Write_Nonvol(Ctx, 0, set, 9);
+	EMXXLX_Write_Nonvol(hmram, 0, null, 9);
+	EMXXLX_Write_Nonvol(hmram, 0, set, 9);
 
 	//Initialize clear block protect bits
 	temp[0] = 0x7C;
-	EMXXLX_Write_Status(Ctx, &temp[0]);
-	EMXXLX_Read_Status(Ctx, &temp[0]);
+	EMXXLX_Write_Status(hmram, &temp[0]);
+	EMXXLX_Read_Status(hmram, &temp[0]);
 	if ((temp[0] & 0x7C) != 0x7C)
 	{
 		return HAL_ERROR;
 	}
 
-	EMXXLX_Write_Status(Ctx, &null[0]);
-	EMXXLX_Read_Status(Ctx, &temp[0]);
+	EMXXLX_Write_Status(hmram, &null[0]);
+	EMXXLX_Read_Status(hmram, &temp[0]);
 	if ((temp[0] & 0x7C) != 0)
 	{
 		return HAL_ERROR;
@@ -235,28 +846,28 @@ uint8_t EMXXLX_Refactor(OSPI_HandleTypeDef *Ctx)
 //	//Write all zeros
 //	for (uint32_t i = 0; i <= page_num; i++)
 //	{
-//		EMXXLX_Write(Ctx, 256 * i, init_0, 256);
-//		EMXXLX_Polling_MemReady(Ctx, HAL_MAX_DELAY);
+//		EMXXLX_Write(hmram, 256 * i, init_0, 256);
+//		EMXXLX_Polling_MemReady(hmram, HAL_MAX_DELAY);
 //	}
 //
 //	//Write all ones
 //	for (uint32_t i = 0; i <= page_num; i++)
 //	{
-//		EMXXLX_Write(Ctx, 256 * i, init_ff, 256);
-//		EMXXLX_Polling_MemReady(Ctx, HAL_MAX_DELAY);
+//		EMXXLX_Write(hmram, 256 * i, init_ff, 256);
+//		EMXXLX_Polling_MemReady(hmram, HAL_MAX_DELAY);
 //	}
 //
 //	//Write all zeros
 //	for (uint32_t i = 0; i <= page_num; i++)
 //		{
-//			EMXXLX_Write(Ctx, 256 * i, init_0, 256);
-//			EMXXLX_Polling_MemReady(Ctx, HAL_MAX_DELAY);
+//			EMXXLX_Write(hmram, 256 * i, init_0, 256);
+//			EMXXLX_Polling_MemReady(hmram, HAL_MAX_DELAY);
 //		}
 //
 //	//Verify the write process was sucessful
 //	for (uint32_t i = 0; i <= page_num; i++)
 //	{
-//		EMXXLX_Read(Ctx, 256, init_temp, 256);
+//		EMXXLX_Read(hmram, 256, init_temp, 256);
 //		if (memcmp(init_0, init_temp, 256) == 0)
 //		{
 //			return HAL_ERROR;
@@ -266,14 +877,14 @@ uint8_t EMXXLX_Refactor(OSPI_HandleTypeDef *Ctx)
 //	//Write all ones
 //	for (uint32_t i = 0; i <= page_num; i++)
 //	{
-//		EMXXLX_Write(Ctx, 256 * i, init_ff, 256);
-//		EMXXLX_Polling_MemReady(Ctx, HAL_MAX_DELAY);
+//		EMXXLX_Write(hmram, 256 * i, init_ff, 256);
+//		EMXXLX_Polling_MemReady(hmram, HAL_MAX_DELAY);
 //	}
 //
 //	//Verify the write process was sucessful
 //	for (uint32_t i = 0; i <= page_num; i++)
 //	{
-//		EMXXLX_Read(Ctx, 256 * i, init_temp, 256);
+//		EMXXLX_Read(hmram, 256 * i, init_temp, 256);
 //		if (memcmp(init_ff, init_temp, 256) == 0)
 //		{
 //			return HAL_ERROR;
@@ -281,22 +892,16 @@ uint8_t EMXXLX_Refactor(OSPI_HandleTypeDef *Ctx)
 //	}
 
 	//Exit DFIM mode
-	EMXXLX_Write_Vol(Ctx, 0x1E, &null[0], 1);
-	EMXXLX_Write_Disable(Ctx);
+	EMXXLX_Write_Vol(hmram, 0x1E, &null[0], 1);
+	EMXXLX_Write_Disable(hmram);
 
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Write_Enable(OSPI_HandleTypeDef *Ctx)
+uint8_t EMXXLX_Write_Enable(EMXXLX_HandleTypeDef *hmram)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
-
-	/* Initialize the write register command */
-	sCommand.Instruction = MRAM_WRITE_ENABLE_CMD;
-	sCommand.InstructionMode = InstMode;
-
 	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (EMXXLX_Command(hmram, &hmram->CmdSet.WriteEnable, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
 	{
 
 		return HAL_ERROR;
@@ -305,44 +910,115 @@ uint8_t EMXXLX_Write_Enable(OSPI_HandleTypeDef *Ctx)
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Polling_MemReady(OSPI_HandleTypeDef *Ctx, uint32_t Timeout)
+/**
+ *  @brief Wait for the end of the ongoing write or erase operation. The flag
+ * 		   status register is polled by the OCTOSPI automatic polling mode,
+ * 		   the CPU only waits for the status match.
+ * 	@param hmram			MRAM device handle.
+ *  @param Timeout			Timeout duration in ms.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Polling_MemReady(EMXXLX_HandleTypeDef *hmram, uint32_t Timeout)
 {
-	uint8_t temp[1];
-	uint32_t Tickstart = HAL_GetTick();
+	OSPI_AutoPollingTypeDef sConfig = {0};
+	uint8_t status = HAL_OK;
+	EMXXLX_STATS_BEGIN();
 
-	EMXXLX_Read_Flags(Ctx, &temp[1]);
-
-	while ((temp[1] & 0x80) == 0)
+	if (EMXXLX_AutoPolling_Command(hmram, &sConfig) != HAL_OK
+		|| HAL_OSPI_AutoPolling(hmram->hospi, &sConfig, Timeout) != HAL_OK)
 	{
-		EMXXLX_Read_Flags(Ctx, &temp[1]);
-
-		if (Timeout != HAL_MAX_DELAY)
-		{
-			if (((HAL_GetTick() - Tickstart) > Timeout) || (Timeout == 0U))
-			{
-				return HAL_ERROR;
-			}
-		}
+		status = HAL_ERROR;
 	}
 
-	return HAL_OK;
+	EMXXLX_STATS_END(hmram, EMXXLX_STAT_MEMREADY, 0, status);
+	return status;
 }
 
-uint8_t EMXXLX_SRWP_Disable(OSPI_HandleTypeDef *Ctx, uint8_t Port, uint8_t Pin)
+/**
+ *  @brief Start waiting for the end of the ongoing write or erase operation
+ * 		   in the background. Callback is called from the OSPI status match
+ * 		   interrupt once the device is ready.
+ * 	@param hmram			MRAM device handle.
+ *  @param Callback			Completion callback, can be NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Polling_MemReady_IT(EMXXLX_HandleTypeDef *hmram, EMXXLX_CallbackTypeDef Callback,
+								   void *Context)
 {
-	HAL_GPIO_DeInit((void *)&Port, Pin);
+	OSPI_AutoPollingTypeDef sConfig = {0};
 
-	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	if (hmram->XferState != EMXXLX_XFER_IDLE)
+	{
+		return HAL_BUSY;
+	}
 
-	GPIO_InitStruct.Pin = Pin;
-	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-	GPIO_InitStruct.Pull = GPIO_NOPULL;
-	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
-	HAL_GPIO_Init((void *)&Port, &GPIO_InitStruct);
+	hmram->XferState = EMXXLX_XFER_POLL_IT;
+	hmram->XferCallback = Callback;
+	hmram->XferContext = Context;
+
+	if (EMXXLX_AutoPolling_Command(hmram, &sConfig) != HAL_OK
+		|| HAL_OSPI_AutoPolling_IT(hmram->hospi, &sConfig) != HAL_OK)
+	{
+		hmram->XferCallback = NULL;
+		hmram->XferState = EMXXLX_XFER_IDLE;
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Configure the read flags command and the automatic polling
+ * 		   parameters matching the ready bit of the flag status register.
+ * 	@param hmram			MRAM device handle.
+ *  @param Config			Automatic polling parameters to be filled.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_AutoPolling_Command(EMXXLX_HandleTypeDef *hmram, OSPI_AutoPollingTypeDef *Config)
+{
+	/* Configure the read flags command */
+	if (EMXXLX_Command(hmram, &hmram->CmdSet.ReadFlags, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_AutoPolling_Config(hmram, Config);
+	return HAL_OK;
+}
+
+/**
+ *  @brief Fill the automatic polling parameters matching the ready bit of
+ * 		   the flag status register.
+ * 	@param hmram			MRAM device handle.
+ *  @param Config			Automatic polling parameters to be filled.
+ */
+static void EMXXLX_AutoPolling_Config(EMXXLX_HandleTypeDef *hmram, OSPI_AutoPollingTypeDef *Config)
+{
+	/* In dual-quad mode both devices must be ready */
+	Config->Match = (EMXXLX_Dies(hmram) == 2U) ? (MRAM_FLAG_READY << 8) | MRAM_FLAG_READY
+			: MRAM_FLAG_READY;
+	Config->Mask = Config->Match;
+	Config->MatchMode = HAL_OSPI_MATCH_MODE_AND;
+	Config->AutomaticStop = HAL_OSPI_AUTOMATIC_STOP_ENABLE;
+	Config->Interval = MRAM_AUTOPOLLING_INTERVAL;
+}
+
+uint8_t EMXXLX_SRWP_Disable(EMXXLX_HandleTypeDef *hmram, uint8_t Port, uint8_t Pin)
+{
+	HAL_GPIO_DeInit((void *)&Port, Pin);
+
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	GPIO_InitStruct.Pin = Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+	HAL_GPIO_Init((void *)&Port, &GPIO_InitStruct);
 
 	HAL_GPIO_WritePin((void *)&Port, Pin, GPIO_PIN_SET);
 
-	EMXXLX_Write_Status(Ctx, 0);
+	EMXXLX_Write_Status(hmram, 0);
 
 	HAL_GPIO_DeInit((void *)&Port, Pin);
 
@@ -355,43 +1031,141 @@ uint8_t EMXXLX_SRWP_Disable(OSPI_HandleTypeDef *Ctx, uint8_t Port, uint8_t Pin)
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_MemoryMapped_Config(OSPI_HandleTypeDef *Ctx)
+uint8_t EMXXLX_MemoryMapped_Config(EMXXLX_HandleTypeDef *hmram)
+{
+	OSPI_MemoryMappedTypeDef sMemMappedCfg = {0};
+
+	sMemMappedCfg.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_ENABLE;
+	sMemMappedCfg.TimeOutPeriod = 0xFFFF;
+	return EMXXLX_MemoryMapped_Start(hmram, &sMemMappedCfg);
+}
+
+/**
+ *  @brief Enter the memory-mapped mode with the timeout counter disabled. nCS
+ * 		   stays low between two AHB accesses so that a sequential access
+ * 		   continues the ongoing read without a new instruction and address.
+ *  @note  The OCTOSPI holds the bus until a non sequential access, use
+ * 		   EMXXLX_MemoryMapped_Config when another device shares it.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_MemoryMapped_Continuous(EMXXLX_HandleTypeDef *hmram)
+{
+	OSPI_MemoryMappedTypeDef sMemMappedCfg = {0};
+
+	sMemMappedCfg.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_DISABLE;
+	return EMXXLX_MemoryMapped_Start(hmram, &sMemMappedCfg);
+}
+
+/**
+ *  @brief Leave the memory-mapped mode. In XIP mode a read without opcode
+ * 		   clears the confirmation bit so that the device decodes the
+ * 		   next instruction again. The reads stop wrapping.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_MemoryMapped_Exit(EMXXLX_HandleTypeDef *hmram)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+	uint8_t data[2];
+
+	if (HAL_OSPI_Abort(hmram->hospi) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	if (hmram->Xip == MRAM_XIP_DISABLE)
+	{
+		return EMXXLX_Set_Wrap(hmram, MRAM_CONTINUOUS_WRAP);
+	}
+
+	sCommand.OperationType = HAL_OSPI_OPTYPE_COMMON_CFG;
+	sCommand.InstructionMode = HAL_OSPI_INSTRUCTION_NONE;
+	sCommand.Address = 0;
+	sCommand.AddressMode = hmram->AddMode;
+	sCommand.AddressSize = HAL_OSPI_ADDRESS_32_BITS;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = EMXXLX_Alignment(hmram);
+	sCommand.DQSMode = hmram->DQSMode;
+	EMXXLX_Apply_Xip(hmram, &sCommand, EMXXLX_XIP_EXIT);
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
+
+	if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK
+			|| HAL_OSPI_Receive(hmram->hospi, data, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Configure the memory-mapped write and read commands then enter the
+ * 		   memory-mapped mode.
+ * 	@param hmram			MRAM device handle.
+ *  @param sMemMappedCfg	Timeout counter settings.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_MemoryMapped_Start(EMXXLX_HandleTypeDef *hmram, OSPI_MemoryMappedTypeDef *sMemMappedCfg)
 {
 	OSPI_RegularCmdTypeDef sCommand = {0};
 
-	EMXXLX_Write_Enable(Ctx);
+	/* The wrap command always sends its opcode, XIP reads do not wrap */
+	if (EMXXLX_Set_Wrap(hmram, (hmram->Xip == MRAM_XIP_DISABLE) ? hmram->Wrap : MRAM_CONTINUOUS_WRAP) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_Write_Enable(hmram);
 
 	sCommand.OperationType = HAL_OSPI_OPTYPE_WRITE_CFG;
-	sCommand.Instruction = Write;
-	sCommand.InstructionMode = InstMode;
-	sCommand.AddressMode = AddMode;
+	sCommand.Instruction = hmram->Write;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.AddressMode = hmram->AddMode;
 	sCommand.AddressSize = HAL_OSPI_ADDRESS_32_BITS;
-	sCommand.DataMode = DatMode;
+	sCommand.DataMode = hmram->DatMode;
 	sCommand.DQSMode = HAL_OSPI_DQS_ENABLE;
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
 
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
 	{
 		Error_Handler();
 	}
 
 	sCommand.OperationType = HAL_OSPI_OPTYPE_READ_CFG;
-	sCommand.Instruction = Read;
-	sCommand.AddressMode = AddMode;
+	sCommand.Instruction = hmram->Read;
+	sCommand.AddressMode = hmram->AddMode;
 	sCommand.AddressSize = HAL_OSPI_ADDRESS_32_BITS;
-	sCommand.DataMode = DatMode;
-	sCommand.DummyCycles = DC;
-	sCommand.DQSMode = HAL_OSPI_DQS_DISABLE;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.DummyCycles = hmram->DC;
+	sCommand.DQSMode = hmram->DQSMode;
+	if (hmram->Xip != MRAM_XIP_DISABLE)
+	{
+		/* The device keeps the read opcode after the first confirmed access,
+		   memory-mapped writes would be decoded as an address */
+		sCommand.SIOOMode = HAL_OSPI_SIOO_INST_ONLY_FIRST_CMD;
+		EMXXLX_Apply_Xip(hmram, &sCommand, EMXXLX_XIP_CONFIRM);
+	}
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
 
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (hmram->hospi->Init.WrapSize != HAL_OSPI_WRAP_NOT_SUPPORTED)
 	{
-		Error_Handler();
+		/* Cache line refills are wrapped bursts, the device returns the critical word first */
+		sCommand.OperationType = HAL_OSPI_OPTYPE_WRAP_CFG;
+
+		if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		sCommand.OperationType = HAL_OSPI_OPTYPE_READ_CFG;
 	}
 
-	OSPI_MemoryMappedTypeDef sMemMappedCfg = {0};
+	if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		Error_Handler();
+	}
 
-	sMemMappedCfg.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_ENABLE;
-	sMemMappedCfg.TimeOutPeriod = 0xFFFF;
-	if (HAL_OSPI_MemoryMapped(Ctx, &sMemMappedCfg) != HAL_OK)
+	if (HAL_OSPI_MemoryMapped(hmram->hospi, sMemMappedCfg) != HAL_OK)
 	{
 		Error_Handler();
 	}
@@ -399,11 +1173,11 @@ uint8_t EMXXLX_MemoryMapped_Config(OSPI_HandleTypeDef *Ctx)
 	return HAL_OK;
 }
 
-void jesd_reset()
+void jesd_reset(EMXXLX_HandleTypeDef *hmram)
 {
 
 	// Reconfigure OCTOSPI pins to manual mode
-	HAL_OSPI_MspDeInit(&hospi1);
+	HAL_OSPI_MspDeInit(hmram->hospi);
 
 	GPIO_InitTypeDef GPIO_InitStruct = {0};
 
@@ -445,19 +1219,23 @@ void jesd_reset()
 	HAL_GPIO_DeInit(CLK_GPIO_Port, CLK_Pin | IO0_Pin | IO1_Pin);
 	HAL_GPIO_DeInit(NCS_GPIO_Port, NCS_Pin);
 
-	HAL_OSPI_MspInit(&hospi1);
+	HAL_OSPI_MspInit(hmram->hospi);
+
+	// Volatile registers reloaded from the nonvolatile ones
+	memcpy(hmram->Regs[1], hmram->Regs[0], sizeof(hmram->Regs[1]));
 }
 
-uint8_t EMXXLX_Write_Disable(OSPI_HandleTypeDef *Ctx)
+uint8_t EMXXLX_Write_Disable(EMXXLX_HandleTypeDef *hmram)
 {
 	OSPI_RegularCmdTypeDef sCommand = {0};
 
 	/* Initialize the write register command */
 	sCommand.Instruction = MRAM_WRITE_DISABLE_CMD;
-	sCommand.InstructionMode = InstMode;
+	sCommand.InstructionMode = hmram->InstMode;
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
 
 	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
 	{
 
 		return HAL_ERROR;
@@ -466,343 +1244,2322 @@ uint8_t EMXXLX_Write_Disable(OSPI_HandleTypeDef *Ctx)
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Reset(OSPI_HandleTypeDef *Ctx)
+uint8_t EMXXLX_Reset(EMXXLX_HandleTypeDef *hmram)
 {
 	OSPI_RegularCmdTypeDef sCommand = {0};
 
 	/* Initialize the write register command */
 	sCommand.Instruction = MRAM_RESET_CMD;
-	sCommand.InstructionMode = InstMode;
+	sCommand.InstructionMode = hmram->InstMode;
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
 
 	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
 	{
 
 		return HAL_ERROR;
 	}
 
+	/* The volatile registers are reloaded from the nonvolatile ones */
+	memcpy(hmram->Regs[1], hmram->Regs[0], sizeof(hmram->Regs[1]));
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Read_ID(OSPI_HandleTypeDef *Ctx, uint8_t *Value)
+uint8_t EMXXLX_Read_ID(EMXXLX_HandleTypeDef *hmram, uint8_t *Value)
 {
 	OSPI_RegularCmdTypeDef sCommand = {0};
 
 	/* Initialize the read register command */
 	sCommand.Instruction = MRAM_READ_ID_MULTIPLE_IO_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.DataMode = DatMode;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.DataMode = hmram->DatMode;
 	sCommand.NbData = 3;
-	sCommand.DummyCycles = CfgDc;
-
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
-	{
-		return HAL_ERROR;
-	}
-
-	/* Reception of the data */
-	if (HAL_OSPI_Receive(Ctx, Value, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
-	{
-		return HAL_ERROR;
-	}
+	sCommand.DummyCycles = hmram->CfgDc;
 
-	return HAL_OK;
+	return EMXXLX_Reg_Read(hmram, &sCommand, Value);
 }
 
-uint8_t EMXXLX_Read(OSPI_HandleTypeDef *Ctx, uint32_t address, uint8_t *pData,
+uint8_t EMXXLX_Read(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
 					uint32_t size)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
+	uint8_t status = HAL_OK;
 
-	/* Initialize the read register command */
-	sCommand.Instruction = Read;
-	sCommand.InstructionMode = InstMode;
-	sCommand.Address = address;
-	sCommand.AddressMode = AddMode;
-	sCommand.AddressSize = AddSize;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = size;
-	sCommand.DummyCycles = DC;
+	EMXXLX_STATS_BEGIN();
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+#if defined(EMXXLX_USE_LL_READ)
+	status = EMXXLX_Read_LL(hmram, address, pData, size);
+#else
+	/* Only the address and length change from the template */
+	hmram->CmdSet.Read.Address = address;
+	hmram->CmdSet.Read.NbData = size;
+
+	/* Configure the command and receive the data */
+	if (EMXXLX_Command(hmram, &hmram->CmdSet.Read, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK
+		|| HAL_OSPI_Receive(hmram->hospi, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
 	{
-		return HAL_ERROR;
+		status = HAL_ERROR;
 	}
+#endif /* EMXXLX_USE_LL_READ */
+
+	EMXXLX_STATS_END(hmram, EMXXLX_STAT_READ, size, status);
+	return status;
+}
 
-	/* Reception of the data */
-	if (HAL_OSPI_Receive(Ctx, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+#if defined(EMXXLX_USE_LL_READ)
+/**
+ *  @brief Wait until the OCTOSPI FIFO holds at least Level bytes.
+ *  @retval HAL status
+ */
+static inline uint8_t EMXXLX_LL_WaitFifo(OCTOSPI_TypeDef *Instance, uint32_t Level,
+										 uint32_t Tickstart)
+{
+	while (((Instance->SR & OCTOSPI_SR_FLEVEL) >> OCTOSPI_SR_FLEVEL_Pos) < Level)
 	{
-		return HAL_ERROR;
+		if ((HAL_GetTick() - Tickstart) > HAL_OSPI_TIMEOUT_DEFAULT_VALUE)
+		{
+			SET_BIT(Instance->CR, OCTOSPI_CR_ABORT);
+			return HAL_ERROR;
+		}
 	}
 
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Erase_Chip(OSPI_HandleTypeDef *Ctx)
+/**
+ *  @brief Read an amount of data by programming the OCTOSPI registers with
+ * 		   the cached read command, bypassing the HAL state machine. The FIFO
+ * 		   is drained by words, the remaining bytes one at a time.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param pData			Destination buffer, no alignment required.
+ *  @param size				Amount of bytes to be read.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Read_LL(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
+							  uint32_t size)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
-	uint8_t temp[1];
-
-	/* Initialize the read register command */
-	sCommand.Instruction = MRAM_ERASE_CHIP_CMD;
-	sCommand.InstructionMode = InstMode;
+	OCTOSPI_TypeDef *Instance = hmram->hospi->Instance;
+	uint32_t Tickstart = HAL_GetTick();
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if ((pData == NULL) || (size == 0))
 	{
 		return HAL_ERROR;
 	}
 
-	EMXXLX_Read_Flags(Ctx, &temp[1]);
+	/* The command does not go through EMXXLX_Command */
+	if (EMXXLX_POWER_WAKE(hmram) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
 
-	while ((temp[1] & 0x80) == 0)
+	/* The registers are shared with the HAL, which must be idle */
+	if (hmram->hospi->State != HAL_OSPI_STATE_READY)
 	{
-		EMXXLX_Read_Flags(Ctx, &temp[1]);
+		return HAL_BUSY;
 	}
 
-	return HAL_OK;
-}
+	while ((Instance->SR & OCTOSPI_SR_BUSY) != 0U)
+	{
+		if ((HAL_GetTick() - Tickstart) > HAL_OSPI_TIMEOUT_DEFAULT_VALUE)
+		{
+			return HAL_ERROR;
+		}
+	}
 
-uint8_t EMXXLX_Write(OSPI_HandleTypeDef *Ctx, uint32_t address, uint8_t *Value,
-					 uint32_t size)
-{
-	OSPI_RegularCmdTypeDef sCommand = {0};
+#if defined(EMXXLX_USE_TRACE)
+	hmram->CmdSet.Read.Address = address;
+	hmram->CmdSet.Read.NbData = size;
+	EMXXLX_TRACE(hmram, &hmram->CmdSet.Read);
+#endif
+
+	/* Program the command, writing the address starts the transfer */
+	MODIFY_REG(Instance->CR, OCTOSPI_CR_FMODE, OCTOSPI_CR_FMODE_0);
+	Instance->CCR = hmram->CmdSet.ReadCcr;
+	MODIFY_REG(Instance->TCR, OCTOSPI_TCR_DCYC, hmram->CmdSet.Read.DummyCycles);
+	Instance->DLR = size - 1U;
+	Instance->IR = hmram->CmdSet.Read.Instruction;
+	Instance->AR = address;
+
+	while (size >= 4U)
+	{
+		if (EMXXLX_LL_WaitFifo(Instance, 4U, Tickstart) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
 
-	/* Initialize the read register command */
-	sCommand.Instruction = Write;
-	sCommand.InstructionMode = InstMode;
-	sCommand.Address = address;
-	sCommand.AddressMode = AddMode;
-	sCommand.AddressSize = AddSize;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = size;
+		__UNALIGNED_UINT32_WRITE(pData, Instance->DR);
+		pData += 4U;
+		size -= 4U;
+	}
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	while (size > 0U)
 	{
-		return HAL_ERROR;
+		if (EMXXLX_LL_WaitFifo(Instance, 1U, Tickstart) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		*pData++ = *((__IO uint8_t *)&Instance->DR);
+		size--;
 	}
 
-	/* Reception of the data */
-	if (HAL_OSPI_Transmit(Ctx, Value, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	while ((Instance->SR & OCTOSPI_SR_TCF) == 0U)
 	{
-		return HAL_ERROR;
+		if ((HAL_GetTick() - Tickstart) > HAL_OSPI_TIMEOUT_DEFAULT_VALUE)
+		{
+			return HAL_ERROR;
+		}
 	}
 
+	Instance->FCR = OCTOSPI_FCR_CTCF;
+
 	return HAL_OK;
 }
+#endif /* EMXXLX_USE_LL_READ */
 
-uint8_t EMXXLX_Read_Nonvol(OSPI_HandleTypeDef *Ctx, uint32_t address,
-						   uint8_t *Value, uint8_t size)
+uint8_t EMXXLX_Erase_Chip(EMXXLX_HandleTypeDef *hmram)
 {
 	OSPI_RegularCmdTypeDef sCommand = {0};
 
 	/* Initialize the read register command */
-	sCommand.Instruction = MRAM_READ_NONVOL_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.Address = address;
-	sCommand.AddressMode = AddMode;
-	sCommand.AddressSize = AddSize;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = size;
-	sCommand.DummyCycles = CfgDc;
+	sCommand.Instruction = MRAM_ERASE_CHIP_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
 
 	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
-	{
-		return HAL_ERROR;
-	}
-
-	/* Reception of the data */
-	if (HAL_OSPI_Receive(Ctx, (uint8_t *)Value, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
 	{
 		return HAL_ERROR;
 	}
 
-	return HAL_OK;
+	return EMXXLX_Polling_MemReady(hmram, HAL_MAX_DELAY);
 }
 
-uint8_t EMXXLX_Write_Nonvol(OSPI_HandleTypeDef *Ctx, uint32_t address,
-							uint8_t *pData, uint8_t size)
+/**
+ *  @brief Erase an arbitrary span with the fewest commands. Aligned parts
+ * 		   use the largest of the 64kB, 32kB and 4kB erases which fits, the
+ * 		   unaligned edges are written with the erase value.
+ *  @note  In dual-quad mode each erase covers both devices, the block sizes
+ * 		   double.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param size				Amount of bytes to be erased.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Erase_Range(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint32_t size)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
-
-	/* Initialize the write register command */
-	sCommand.Instruction = MRAM_WRITE_NONVOL_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.Address = address;
-	sCommand.AddressMode = AddMode;
-	sCommand.AddressSize = AddSize;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = size;
-
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	OSPI_RegularCmdTypeDef sCommand;
+	uint8_t fill[OSPI_PAGE_SIZE];
+	uint32_t dies = EMXXLX_Dies(hmram);
+	uint32_t end = OSPI_END_ADDR * dies;
+	uint32_t chunk, block;
+
+	if ((address >= end) || (size > end - address)
+		|| (((address | size) & (EMXXLX_Alignment(hmram) - 1U)) != 0U))
 	{
-
 		return HAL_ERROR;
 	}
 
-	if (HAL_OSPI_Transmit(Ctx, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	memset(fill, (hmram->EraseValue == MRAM_ERASE_VALUE_1) ? 0xFF : 0x00, sizeof(fill));
+
+	while (size > 0)
 	{
-		return HAL_ERROR;
+		block = EMXXLX_Erase_Plan(hmram, address, size);
+		if (block != 0U)
+		{
+			chunk = block * dies;
+			if (EMXXLX_Erase_Build(hmram, &sCommand, address, block) != HAL_OK
+				|| EMXXLX_Write_Enable(hmram) != HAL_OK
+				|| EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK
+				|| EMXXLX_Polling_MemReady(hmram, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+			{
+				return HAL_ERROR;
+			}
+		}
+		else
+		{
+			/* Unaligned edge, up to the next 4kB boundary */
+			chunk = EMXXLX_ERASE_4KB * dies - (address % (EMXXLX_ERASE_4KB * dies));
+			if (chunk > size)
+			{
+				chunk = size;
+			}
+			if (chunk > sizeof(fill))
+			{
+				chunk = sizeof(fill);
+			}
+
+			if (EMXXLX_WriteBuffer(hmram, address, fill, chunk) != HAL_OK)
+			{
+				return HAL_ERROR;
+			}
+		}
+
+		address += chunk;
+		size -= chunk;
 	}
 
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Read_Vol(OSPI_HandleTypeDef *Ctx, uint32_t address,
-						uint8_t *Value, uint8_t size)
+/**
+ *  @brief Start erasing an aligned span in the background, one block after
+ * 		   the other. Each block is chained from the OSPI status match
+ * 		   interrupt, Callback is called once the span is erased.
+ *  @note  Callback gets HAL_TIMEOUT when Timeout elapses between two blocks
+ * 		   or in EMXXLX_Erase_Progress, and HAL_ERROR after EMXXLX_Abort.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte, aligned on EMXXLX_ERASE_4KB.
+ *  @param size				Amount of bytes to be erased, a multiple of EMXXLX_ERASE_4KB.
+ *  @param Timeout			Timeout duration of the whole erase in ms, HAL_MAX_DELAY for none.
+ *  @param Callback			Completion callback, can be NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_EraseAsync(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint32_t size,
+						  uint32_t Timeout, EMXXLX_CallbackTypeDef Callback, void *Context)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
-
-	/* Initialize the read register command */
-	sCommand.Instruction = MRAM_READ_VOL_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.Address = address;
-	sCommand.AddressMode = AddMode;
-	sCommand.AddressSize = AddSize;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = size;
-	sCommand.DummyCycles = CfgDc;
+	uint32_t unit = EMXXLX_ERASE_4KB * EMXXLX_Dies(hmram);
+	uint32_t end = OSPI_END_ADDR * EMXXLX_Dies(hmram);
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if ((size == 0) || (address >= end) || (size > end - address)
+		|| ((address % unit) != 0U) || ((size % unit) != 0U))
 	{
 		return HAL_ERROR;
 	}
 
-	/* Reception of the data */
-	if (HAL_OSPI_Receive(Ctx, (uint8_t *)Value, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (hmram->XferState != EMXXLX_XFER_IDLE)
+	{
+		return HAL_BUSY;
+	}
+
+	hmram->XferState = EMXXLX_XFER_ERASE_IT;
+	hmram->XferCallback = Callback;
+	hmram->XferContext = Context;
+	hmram->XferAddress = address;
+	hmram->XferRemaining = size;
+	hmram->XferSize = size;
+	hmram->XferTickstart = HAL_GetTick();
+	hmram->XferTimeout = Timeout;
+
+	if (EMXXLX_Xfer_Chunk(hmram) != HAL_OK)
 	{
+		hmram->XferCallback = NULL;
+		hmram->XferState = EMXXLX_XFER_IDLE;
 		return HAL_ERROR;
 	}
 
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Write_Vol(OSPI_HandleTypeDef *Ctx, uint32_t address,
-						 uint8_t *pData, uint8_t size)
+/**
+ *  @brief Start erasing the whole memory in the background, see
+ * 		   EMXXLX_EraseAsync.
+ * 	@param hmram			MRAM device handle.
+ *  @param Timeout			Timeout duration of the whole erase in ms, HAL_MAX_DELAY for none.
+ *  @param Callback			Completion callback, can be NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Erase_ChipAsync(EMXXLX_HandleTypeDef *hmram, uint32_t Timeout,
+							   EMXXLX_CallbackTypeDef Callback, void *Context)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
-
-	/* Initialize the write register command */
-	sCommand.Instruction = MRAM_WRITE_VOL_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.Address = address;
-	sCommand.AddressMode = AddMode;
-	sCommand.AddressSize = AddSize;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = size;
+	return EMXXLX_EraseAsync(hmram, 0, OSPI_END_ADDR * EMXXLX_Dies(hmram), Timeout, Callback, Context);
+}
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+/**
+ *  @brief Progress of the background erase. The timeout is also checked,
+ * 		   so that a device which never reports ready ends the erase.
+ * 	@param hmram			MRAM device handle.
+ *  @retval Bytes erased by the ongoing or last background erase
+ */
+uint32_t EMXXLX_Erase_Progress(EMXXLX_HandleTypeDef *hmram)
+{
+	uint32_t primask = __get_PRIMASK();
+	EMXXLX_CallbackTypeDef callback;
+	void *context;
+	uint32_t erased;
+	uint8_t state = EMXXLX_XFER_IDLE;
+
+	__disable_irq();
+	erased = hmram->XferSize - hmram->XferRemaining;
+	__set_PRIMASK(primask);
+
+	if ((hmram->XferState == EMXXLX_XFER_ERASE_IT) && (hmram->XferTimeout != HAL_MAX_DELAY)
+		&& ((HAL_GetTick() - hmram->XferTickstart) > hmram->XferTimeout))
 	{
-
-		return HAL_ERROR;
+		state = EMXXLX_Xfer_Release(hmram, EMXXLX_XFER_ERASE_IT, &callback, &context);
 	}
 
-	if (HAL_OSPI_Transmit(Ctx, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	/* The interrupts ignore a released erase, it is stopped with them enabled */
+	if (state != EMXXLX_XFER_IDLE)
 	{
-		return HAL_ERROR;
+		HAL_OSPI_Abort(hmram->hospi);
+		EMXXLX_Xfer_Notify(hmram, state, callback, context, HAL_TIMEOUT);
 	}
 
-	return HAL_OK;
+	return erased;
 }
 
-uint8_t EMXXLX_Write_Status(OSPI_HandleTypeDef *Ctx, uint8_t *pData)
+/**
+ *  @brief Abort the ongoing background transfer or erase, its callback is
+ * 		   called with HAL_ERROR.
+ *  @note  A block erase already issued still completes in the device, wait
+ * 		   with EMXXLX_Polling_MemReady before the next command.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Abort(EMXXLX_HandleTypeDef *hmram)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
-
-	/* Initialize the write register command */
-	sCommand.Instruction = MRAM_WRITE_STATUS_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = 1;
+	EMXXLX_CallbackTypeDef callback;
+	void *context;
+	uint8_t state = EMXXLX_Xfer_Release(hmram, EMXXLX_XFER_IDLE, &callback, &context);
+	uint8_t status = HAL_OK;
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	/* The interrupts ignore a released transfer, it is stopped with them enabled */
+	if (HAL_OSPI_Abort(hmram->hospi) != HAL_OK)
 	{
-
-		return HAL_ERROR;
+		status = HAL_ERROR;
 	}
 
-	if (HAL_OSPI_Transmit(Ctx, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (state != EMXXLX_XFER_IDLE)
 	{
-		return HAL_ERROR;
+		EMXXLX_Xfer_Notify(hmram, state, callback, context, HAL_ERROR);
 	}
 
-	return HAL_OK;
+	return status;
 }
 
-uint8_t EMXXLX_Read_Flags(OSPI_HandleTypeDef *Ctx, uint8_t *Value)
+/**
+ *  @brief Largest erase block starting on address and inside the span.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the span.
+ *  @param size				Amount of bytes of the span.
+ *  @retval EMXXLX_ERASE_64KB, EMXXLX_ERASE_32KB, EMXXLX_ERASE_4KB or 0 when
+ * 			none fits
+ */
+static uint32_t EMXXLX_Erase_Plan(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint32_t size)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
-
-	/* Initialize the read register command */
-	sCommand.Instruction = MRAM_READ_FLAGS_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = 1;
-	sCommand.DummyCycles = CfgDc;
+	static const uint32_t blocks[] = { EMXXLX_ERASE_64KB, EMXXLX_ERASE_32KB, EMXXLX_ERASE_4KB };
+	uint32_t dies = EMXXLX_Dies(hmram);
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	for (uint32_t i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++)
 	{
-		return HAL_ERROR;
-	}
+		if (((address % (blocks[i] * dies)) == 0U) && (size >= blocks[i] * dies))
+		{
+			return blocks[i];
+		}
+	}
+
+	return 0U;
+}
+
+/**
+ *  @brief Fill the erase command of one 64kB, 32kB or 4kB block with the
+ * 		   opcode matching the address size. The device is busy until the
+ * 		   erase ends.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Command to be filled.
+ *  @param address			Memory address of the block, aligned on its size.
+ *  @param size				EMXXLX_ERASE_64KB, EMXXLX_ERASE_32KB or EMXXLX_ERASE_4KB.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Erase_Build(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+								  uint32_t address, uint32_t size)
+{
+	uint8_t wide = (hmram->AddSize == HAL_OSPI_ADDRESS_32_BITS);
+
+	memset(sCommand, 0, sizeof(*sCommand));
+	switch (size) {
+	case EMXXLX_ERASE_64KB:
+		sCommand->Instruction = wide ? MRAM_4BADD_ERASE_SECTOR_CMD : MRAM_ERASE_SECTOR_CMD;
+		break;
+
+	case EMXXLX_ERASE_32KB:
+		sCommand->Instruction = wide ? MRAM_4BADD_ERASE_SECTOR_32kB_CMD : MRAM_ERASE_32kB_SECTOR_CMD;
+		break;
+
+	case EMXXLX_ERASE_4KB:
+		sCommand->Instruction = wide ? MRAM_4BADD_ERASE_SECTOR_4kB_CMD : MRAM_ERASE_4kB_SECTOR_CMD;
+		break;
+
+	default:
+		return HAL_ERROR;
+	}
+
+	sCommand->InstructionMode = hmram->InstMode;
+	sCommand->Address = address;
+	sCommand->AddressMode = hmram->AddMode;
+	sCommand->AddressSize = hmram->AddSize;
+	EMXXLX_Apply_Dtr(hmram, sCommand);
+
+	return HAL_OK;
+}
+
+uint8_t EMXXLX_Write(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value,
+					 uint32_t size)
+{
+	uint8_t status = HAL_OK;
+
+	EMXXLX_STATS_BEGIN();
+
+	/* Only the address and length change from the template */
+	hmram->CmdSet.Write.Address = address;
+	hmram->CmdSet.Write.NbData = size;
+
+	/* Configure the command and send the data */
+	if (EMXXLX_Command(hmram, &hmram->CmdSet.Write, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK
+		|| HAL_OSPI_Transmit(hmram->hospi, Value, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		status = HAL_ERROR;
+	}
 
-	/* Reception of the data */
-	if (HAL_OSPI_Receive(Ctx, (uint8_t *)Value, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	EMXXLX_STATS_END(hmram, EMXXLX_STAT_WRITE, size, status);
+	return status;
+}
+
+/**
+ *  @brief Write an arbitrary span of data. The MRAM has no page program
+ * 		   limit, writes run across page boundaries: the span is only
+ * 		   split every EMXXLX_DMA_MAX_XFER bytes, as the DMA path does, each
+ * 		   command with its own write enable and ready wait. The call
+ * 		   returns once the whole span is written.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param pData			Source buffer.
+ *  @param size				Amount of bytes to be written.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_WriteBuffer(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
+						   uint32_t size)
+{
+	uint32_t chunk;
+	uint32_t end = OSPI_END_ADDR * EMXXLX_Dies(hmram);
+
+	if ((pData == NULL) || (address >= end) || (size > end - address))
+	{
+		return HAL_ERROR;
+	}
+
+	/* Dual-quad and octal DTR transfers move bytes by pairs */
+	if (((address | size) & (EMXXLX_Alignment(hmram) - 1U)) != 0U)
 	{
 		return HAL_ERROR;
 	}
 
+	while (size > 0)
+	{
+		/* Same command size as the DMA path */
+		chunk = size;
+		if (chunk > EMXXLX_DMA_MAX_XFER)
+		{
+			chunk = EMXXLX_DMA_MAX_XFER;
+		}
+
+		if (EMXXLX_Write_Enable(hmram) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		if (EMXXLX_Write(hmram, address, pData, chunk) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		if (EMXXLX_Polling_MemReady(hmram, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		address += chunk;
+		pData += chunk;
+		size -= chunk;
+	}
+
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Clear_flags(OSPI_HandleTypeDef *Ctx)
+/**
+ *  @brief Read an amount of data using DMA. The call returns as soon as the
+ * 		   transfer is started, EMXXLX_RxCpltCallback is called on completion.
+ *  @note  Transfers bigger than EMXXLX_DMA_MAX_XFER are split in several
+ * 		   commands, chained from the OSPI completion callback.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param pData			Destination buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be read.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Read_DMA(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
+						uint32_t size)
+{
+	return EMXXLX_Xfer_Start(hmram, EMXXLX_XFER_RX_DMA, address, pData, size, NULL, NULL);
+}
+
+/**
+ *  @brief Write an amount of data using DMA. The call returns as soon as the
+ * 		   transfer is started, EMXXLX_TxCpltCallback is called once the
+ * 		   device reports ready after the last command.
+ *  @note  Each command of EMXXLX_DMA_MAX_XFER bytes is chained from the OSPI
+ * 		   interrupts: write enable, data phase, then automatic polling of
+ * 		   the ready flag, without any blocking wait in interrupt context.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param Value			Source buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be written.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Write_DMA(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value,
+						 uint32_t size)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
+	return EMXXLX_Xfer_Start(hmram, EMXXLX_XFER_TX_DMA, address, Value, size, NULL, NULL);
+}
 
-	/* Initialize the write register command */
-	sCommand.Instruction = MRAM_CLR_FLAGS_CMD;
-	sCommand.InstructionMode = InstMode;
+/**
+ *  @brief Write an amount of data using DMA, Callback is called from the
+ * 		   OSPI interrupt on completion or error instead of the weak
+ * 		   callbacks.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param Value			Source buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be written.
+ *  @param Callback			Completion callback.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_WriteAsync_DMA(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value,
+							  uint32_t size, EMXXLX_CallbackTypeDef Callback, void *Context)
+{
+	return EMXXLX_Xfer_Start(hmram, EMXXLX_XFER_TX_DMA, address, Value, size, Callback, Context);
+}
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+/**
+ *  @brief Read an amount of data from a striped volume. Both devices are
+ * 		   read at the same time using DMA, Callback is called from
+ * 		   interrupt context once every stripe is transferred.
+ *  @note  Stripe n of the volume is stored on Dev[n % EMXXLX_STRIPE_DEVICES].
+ * 	@param hstripe			Striped volume, devices and stripe size set.
+ *  @param address			Volume address of the first byte.
+ *  @param pData			Destination buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be read.
+ *  @param Callback			Completion callback, can be NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Stripe_Read(EMXXLX_StripeTypeDef *hstripe, uint32_t address, uint8_t *pData,
+						   uint32_t size, EMXXLX_StripeCallbackTypeDef Callback, void *Context)
+{
+	return EMXXLX_Stripe_Start(hstripe, EMXXLX_XFER_RX_DMA, address, pData, size, Callback,
+							   Context);
+}
+
+/**
+ *  @brief Write an amount of data to a striped volume. Both devices are
+ * 		   written at the same time using DMA, Callback is called from
+ * 		   interrupt context once every stripe is transferred.
+ * 	@param hstripe			Striped volume, devices and stripe size set.
+ *  @param address			Volume address of the first byte.
+ *  @param Value			Source buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be written.
+ *  @param Callback			Completion callback, can be NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Stripe_Write(EMXXLX_StripeTypeDef *hstripe, uint32_t address, uint8_t *Value,
+							uint32_t size, EMXXLX_StripeCallbackTypeDef Callback, void *Context)
+{
+	return EMXXLX_Stripe_Start(hstripe, EMXXLX_XFER_TX_DMA, address, Value, size, Callback,
+							   Context);
+}
+
+/**
+ *  @brief Split a volume transfer between the devices and start the first
+ * 		   stripe of each of them.
+ *  @retval HAL status, HAL_OK if at least one device started. Later errors
+ * 			are reported through the completion callback.
+ */
+static uint8_t EMXXLX_Stripe_Start(EMXXLX_StripeTypeDef *hstripe, uint8_t State, uint32_t address,
+								   uint8_t *pData, uint32_t size, EMXXLX_StripeCallbackTypeDef Callback,
+								   void *Context)
+{
+	uint32_t first, distance;
+	uint8_t i, started = 0;
+
+	if ((hstripe == NULL) || (hstripe->StripeSize == 0) || (pData == NULL) || (size == 0)
+		|| (address >= EMXXLX_STRIPE_DEVICES * OSPI_END_ADDR)
+		|| (size > EMXXLX_STRIPE_DEVICES * OSPI_END_ADDR - address))
+	{
+		return HAL_ERROR;
+	}
+
+	for (i = 0; i < EMXXLX_STRIPE_DEVICES; i++)
+	{
+		if (hstripe->Dev[i] == NULL)
+		{
+			return HAL_ERROR;
+		}
+	}
+
+	if (hstripe->Pending != 0)
+	{
+		return HAL_BUSY;
+	}
+
+	hstripe->State = State;
+	hstripe->Buffer = pData;
+	hstripe->Address = address;
+	hstripe->Size = size;
+	hstripe->Status = HAL_OK;
+	hstripe->Callback = Callback;
+	hstripe->Context = Context;
+
+	/* Offset of the first stripe owned by each device */
+	first = hstripe->StripeSize - (address % hstripe->StripeSize);
+	for (i = 0; i < EMXXLX_STRIPE_DEVICES; i++)
+	{
+		distance = (i + EMXXLX_STRIPE_DEVICES - (address / hstripe->StripeSize) % EMXXLX_STRIPE_DEVICES)
+				% EMXXLX_STRIPE_DEVICES;
+		hstripe->Offset[i] = (distance == 0) ? 0 : first + (distance - 1) * hstripe->StripeSize;
+		if (hstripe->Offset[i] < size)
+		{
+			hstripe->Pending |= 1U << i;
+		}
+	}
+
+	for (i = 0; i < EMXXLX_STRIPE_DEVICES; i++)
+	{
+		if (hstripe->Offset[i] >= size)
+		{
+			continue;
+		}
+
+		if (EMXXLX_Stripe_Next(hstripe, i) == HAL_OK)
+		{
+			started = 1;
+		}
+		else if (started == 0)
+		{
+			hstripe->Pending = 0;
+			return HAL_ERROR;
+		}
+		else
+		{
+			EMXXLX_Stripe_Release(hstripe, i, HAL_ERROR);
+		}
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Start the next stripe owned by a device.
+ * 	@param hstripe			Striped volume.
+ *  @param Device			Index of the device in hstripe->Dev.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Stripe_Next(EMXXLX_StripeTypeDef *hstripe, uint8_t Device)
+{
+	uint32_t offset = hstripe->Offset[Device];
+	uint32_t stripe = (hstripe->Address + offset) / hstripe->StripeSize;
+	uint32_t within = (hstripe->Address + offset) % hstripe->StripeSize;
+	uint32_t size = hstripe->StripeSize - within;
+
+	if (size > hstripe->Size - offset)
+	{
+		size = hstripe->Size - offset;
+	}
+
+	/* The stripes of the other devices come in between */
+	hstripe->Offset[Device] = offset + size + (EMXXLX_STRIPE_DEVICES - 1) * hstripe->StripeSize;
+
+	return EMXXLX_Xfer_Start(hstripe->Dev[Device], hstripe->State,
+							(stripe / EMXXLX_STRIPE_DEVICES) * hstripe->StripeSize + within,
+							hstripe->Buffer + offset, size, EMXXLX_Stripe_Callback, hstripe);
+}
+
+/**
+ *  @brief Completion of one stripe, chains the next stripe of the device.
+ * 	@param hmram			MRAM device handle.
+ *  @param Status			HAL status of the stripe transfer.
+ *  @param Context			Striped volume.
+ */
+static void EMXXLX_Stripe_Callback(EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context)
+{
+	EMXXLX_StripeTypeDef *hstripe = (EMXXLX_StripeTypeDef *)Context;
+	uint8_t i = 0;
+
+	while ((i < EMXXLX_STRIPE_DEVICES - 1) && (hstripe->Dev[i] != hmram))
+	{
+		i++;
+	}
+
+	if ((Status == HAL_OK) && (hstripe->Offset[i] < hstripe->Size))
+	{
+		Status = EMXXLX_Stripe_Next(hstripe, i);
+		if (Status == HAL_OK)
+		{
+			return;
+		}
+	}
+
+	EMXXLX_Stripe_Release(hstripe, i, Status);
+}
+
+/**
+ *  @brief Mark a device as done with the volume transfer, the completion
+ * 		   callback is called once every device is done.
+ * 	@param hstripe			Striped volume.
+ *  @param Device			Index of the device in hstripe->Dev.
+ *  @param Status			HAL status of the device transfer.
+ */
+static void EMXXLX_Stripe_Release(EMXXLX_StripeTypeDef *hstripe, uint8_t Device, uint8_t Status)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint8_t done;
+
+	/* The devices complete from different interrupts */
+	__disable_irq();
+	if (Status != HAL_OK)
+	{
+		hstripe->Status = Status;
+	}
+	hstripe->Pending &= ~(1U << Device);
+	done = (hstripe->Pending == 0);
+	__set_PRIMASK(primask);
+
+	if (done && (hstripe->Callback != NULL))
+	{
+		hstripe->Callback(hstripe, hstripe->Status, hstripe->Context);
+	}
+}
+
+/**
+ *  @brief Start an interrupt driven read. The call returns as soon as the
+ * 		   transfer is started, Callback is called from the OSPI interrupt
+ * 		   on completion or error.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param pData			Destination buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be read.
+ *  @param Callback			Completion callback, can be NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_ReadAsync(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
+						 uint32_t size, EMXXLX_CallbackTypeDef Callback, void *Context)
+{
+	return EMXXLX_Xfer_Start(hmram, EMXXLX_XFER_RX_IT, address, pData, size, Callback, Context);
+}
+
+/**
+ *  @brief Start an interrupt driven write. The write enable latch is set
+ * 		   with an interrupt driven command, the data phase is then started
+ * 		   from the command complete interrupt. Callback is called from the
+ * 		   OSPI interrupt once the device reports ready, or on error.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Memory address of the first byte.
+ *  @param Value			Source buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be written.
+ *  @param Callback			Completion callback, can be NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_WriteAsync(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value,
+						  uint32_t size, EMXXLX_CallbackTypeDef Callback, void *Context)
+{
+	return EMXXLX_Xfer_Start(hmram, EMXXLX_XFER_TX_IT, address, Value, size, Callback, Context);
+}
+
+/**
+ *  @brief Get the state of the background transfer.
+ * 	@param hmram			MRAM device handle.
+ *  @retval A value of @ref EMXXLX_Transfer_State
+ */
+uint8_t EMXXLX_Get_XferState(EMXXLX_HandleTypeDef *hmram)
+{
+	return hmram->XferState;
+}
+
+/**
+ *  @brief Estimate the bus time of a memory transfer with the current
+ * 		   interface settings, in OCTOSPI clock cycles. Instruction, address,
+ * 		   dummy and data phases are counted with their number of lines and
+ * 		   transfer rate, plus the chip select high time between commands.
+ *  @note  The write estimate includes the write enable command but not the
+ * 		   internal write time of the device.
+ * 	@param hmram			MRAM device handle.
+ *  @param Write			0 for a read, non zero for a write.
+ *  @param size				Amount of bytes of the data phase.
+ *  @retval Estimated clock cycles
+ */
+uint32_t EMXXLX_Xfer_Cycles(EMXXLX_HandleTypeDef *hmram, uint8_t Write, uint32_t size)
+{
+	uint32_t cycles;
+
+	if (Write == 0)
+	{
+		return EMXXLX_Cmd_Cycles(hmram, &hmram->CmdSet.Read, size);
+	}
+
+	cycles = EMXXLX_Cmd_Cycles(hmram, &hmram->CmdSet.WriteEnable, 0);
+	cycles += EMXXLX_Cmd_Cycles(hmram, &hmram->CmdSet.Write, size);
+
+	return cycles;
+}
+
+/**
+ *  @brief Estimate the bus time of a memory transfer with the current
+ * 		   interface settings and OCTOSPI clock.
+ * 	@param hmram			MRAM device handle.
+ *  @param Write			0 for a read, non zero for a write.
+ *  @param size				Amount of bytes of the data phase.
+ *  @retval Estimated time in ns, 0 if the OCTOSPI clock is not running
+ */
+uint32_t EMXXLX_Xfer_Time_ns(EMXXLX_HandleTypeDef *hmram, uint8_t Write, uint32_t size)
+{
+	uint32_t freq = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_OSPI);
+
+	if (freq == 0)
+	{
+		return 0;
+	}
+
+	return (uint32_t)(((uint64_t)EMXXLX_Xfer_Cycles(hmram, Write, size)
+			* hmram->hospi->Init.ClockPrescaler * 1000000000ULL) / freq);
+}
+
+/**
+ *  @brief Find the fastest clock prescaler with a stable read sampling
+ * 		   window. For each prescaler the sample shifting (the data hold
+ * 		   in DTR), the added DS delay when the reads use DQS and the delay
+ * 		   block phase are swept against a reference pattern. The widest
+ * 		   run of passing phases wins and its center is kept.
+ *  @note  EMXXLX_CAL_PATTERN_SIZE bytes at address are overwritten. The
+ * 		   result is kept in hmram->Calibration, which EMXXLX_Init applies
+ * 		   in the same interface mode: save it and restore it before
+ * 		   EMXXLX_Init to skip the calibration on the next boot. The DS
+ * 		   delay is also written to the nonvolatile register.
+ * 	@param hmram			MRAM device handle, initialized.
+ *  @param InterfaceMode	InterfaceMode given to EMXXLX_Init.
+ *  @param address			Scratch memory address, aligned on 2 bytes.
+ *  @retval HAL status, HAL_ERROR when no prescaler has a stable window
+ */
+uint8_t EMXXLX_Calibrate(EMXXLX_HandleTypeDef *hmram, uint8_t InterfaceMode, uint32_t address)
+{
+	EMXXLX_CalibrationTypeDef safe = {0}, cal, best = {0};
+	uint8_t dsSteps = (hmram->DQSMode == HAL_OSPI_DQS_ENABLE) ? MRAM_0_ADDED_DELAY : 0U;
+
+	hmram->Calibration.Valid = 0;
+
+	/* The pattern is written at the slowest clock, without delay block */
+	safe.ClockPrescaler = EMXXLX_CAL_MAX_PRESCALER;
+	safe.SampleShifting = HAL_OSPI_SAMPLE_SHIFTING_NONE;
+	safe.DelayHoldQuarterCycle = (hmram->Dtr != 0) ? HAL_OSPI_DHQC_ENABLE : HAL_OSPI_DHQC_DISABLE;
+	safe.DelayBlockBypass = HAL_OSPI_DELAY_BLOCK_BYPASSED;
+	safe.DsDelay = MRAM_0_ADDED_DELAY;
+
+	if (EMXXLX_Apply_Calibration(hmram, &safe) != HAL_OK
+			|| EMXXLX_WriteBuffer(hmram, address, (uint8_t *)CalPattern, EMXXLX_CAL_PATTERN_SIZE) != HAL_OK)
 	{
+		return HAL_ERROR;
+	}
+
+	for (uint32_t prescaler = 1; (prescaler <= EMXXLX_CAL_MAX_PRESCALER)
+			&& (best.Window < EMXXLX_CAL_MIN_WINDOW); prescaler++)
+	{
+		best.Window = 0;
+
+		for (uint8_t shift = 0; shift < 2; shift++)
+		{
+			for (uint8_t ds = 0; ds <= dsSteps; ds++)
+			{
+				cal = safe;
+				cal.ClockPrescaler = prescaler;
+				cal.DsDelay = MRAM_0_ADDED_DELAY - ds;
+
+				/* Sample shifting is not allowed in DTR, the data hold moves instead */
+				if (hmram->Dtr != 0)
+				{
+					cal.DelayHoldQuarterCycle = (shift != 0) ? HAL_OSPI_DHQC_DISABLE : HAL_OSPI_DHQC_ENABLE;
+				}
+				else
+				{
+					cal.SampleShifting = (shift != 0) ? HAL_OSPI_SAMPLE_SHIFTING_HALFCYCLE
+							: HAL_OSPI_SAMPLE_SHIFTING_NONE;
+				}
+
+				EMXXLX_Calibration_Window(hmram, &cal, address);
+				if (cal.Window > best.Window)
+				{
+					best = cal;
+				}
+			}
+		}
+	}
+
+	if (best.Window < EMXXLX_CAL_MIN_WINDOW)
+	{
+		EMXXLX_Apply_Calibration(hmram, &safe);
+		return HAL_ERROR;
+	}
 
+	best.Valid = 1;
+	best.InterfaceMode = InterfaceMode;
+	hmram->Calibration = best;
+
+	/* Nonvolatile register 4 keeps the DS delay across power cycles */
+	if (EMXXLX_Apply_Calibration(hmram, &best) != HAL_OK || EMXXLX_Write_Enable(hmram) != HAL_OK
+			|| EMXXLX_Write_Nonvol(hmram, 4, &best.DsDelay, 1) != HAL_OK
+			|| EMXXLX_Polling_MemReady(hmram, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
 		return HAL_ERROR;
 	}
 
 	return HAL_OK;
 }
 
-uint8_t EMXXLX_Read_Status(OSPI_HandleTypeDef *Ctx, uint8_t *Value)
+/**
+ *  @brief Find the smallest dummy cycle setting which reads a reference
+ * 		   pattern back EMXXLX_TUNE_PASSES times in a row at the current
+ * 		   kernel clock and the given prescaler. The setting is written to
+ * 		   the volatile configuration register and the read templates.
+ *  @note  EMXXLX_CAL_PATTERN_SIZE bytes at address are overwritten. The next
+ * 		   EMXXLX_Init sets Config.DummyCycles again, keep the result
+ * 		   (hmram->DC) and give it to EMXXLX_Set_Dummy after EMXXLX_Init.
+ * 		   On failure the previous prescaler and dummy cycles are restored.
+ * 	@param hmram			MRAM device handle, initialized.
+ *  @param ClockPrescaler	OCTOSPI clock prescaler to tune for.
+ *  @param address			Scratch memory address, aligned on 2 bytes.
+ *  @retval HAL status, HAL_ERROR when even the current setting fails
+ */
+uint8_t EMXXLX_AutoTune(EMXXLX_HandleTypeDef *hmram, uint32_t ClockPrescaler, uint32_t address)
 {
-	OSPI_RegularCmdTypeDef sCommand = {0};
+	uint8_t current = (uint8_t)hmram->DC;
+	uint32_t prescaler = hmram->hospi->Init.ClockPrescaler;
 
-	/* Initialize the read register command */
-	sCommand.Instruction = MRAM_READ_STATUS_REG_CMD;
-	sCommand.InstructionMode = InstMode;
-	sCommand.DataMode = DatMode;
-	sCommand.NbData = 1;
-	sCommand.DummyCycles = CfgDc;
+	/* The pattern is written with the current, known good, settings */
+	if (EMXXLX_WriteBuffer(hmram, address, (uint8_t *)CalPattern, EMXXLX_CAL_PATTERN_SIZE) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
 
-	/* Configure the command */
-	if (HAL_OSPI_Command(Ctx, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	if (prescaler != ClockPrescaler)
+	{
+		hmram->hospi->Init.ClockPrescaler = ClockPrescaler;
+		if (HAL_OSPI_Init(hmram->hospi) != HAL_OK)
+		{
+			hmram->hospi->Init.ClockPrescaler = prescaler;
+			HAL_OSPI_Init(hmram->hospi);
+			return HAL_ERROR;
+		}
+	}
+
+	/* The required latency only grows with the setting, the first pass is the minimum */
+	for (uint8_t dc = MRAM_1_DC; dc <= current; dc++)
+	{
+		if ((EMXXLX_Set_Dummy(hmram, dc) == HAL_OK) && (EMXXLX_Check_Pattern(hmram, address) == HAL_OK))
+		{
+			return HAL_OK;
+		}
+	}
+
+	/* Back to the settings the device was working with */
+	EMXXLX_Set_Dummy(hmram, current);
+	if (prescaler != ClockPrescaler)
+	{
+		hmram->hospi->Init.ClockPrescaler = prescaler;
+		HAL_OSPI_Init(hmram->hospi);
+	}
+	return HAL_ERROR;
+}
+
+/**
+ *  @brief Program a dummy cycle setting in the device and the driver, in
+ * 		   the volatile configuration register only.
+ *  @note  Used to apply a setting found by EMXXLX_AutoTune, EMXXLX_Init
+ * 		   sets Config.DummyCycles again.
+ * 	@param hmram			MRAM device handle.
+ *  @param DummyCycles		A value of @ref EMXXLX_Dummy_Cycles.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Set_Dummy(EMXXLX_HandleTypeDef *hmram, uint8_t DummyCycles)
+{
+	if ((DummyCycles < MRAM_1_DC) || (DummyCycles > MRAM_31_DC))
 	{
 		return HAL_ERROR;
 	}
 
-	/* Reception of the data */
-	if (HAL_OSPI_Receive(Ctx, (uint8_t *)Value, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	/* Volatile register 1 holds the dummy cycles */
+	if (EMXXLX_Write_Enable(hmram) != HAL_OK || EMXXLX_Write_Vol(hmram, 1, &DummyCycles, 1) != HAL_OK)
 	{
 		return HAL_ERROR;
 	}
 
+	hmram->DC = DummyCycles;
+	EMXXLX_Build_Commands(hmram);
+
 	return HAL_OK;
 }
+
+/**
+ *  @brief Read the reference pattern back EMXXLX_TUNE_PASSES times.
+ * 	@param hmram			MRAM device handle.
+ *  @param address			Address of the reference pattern.
+ *  @retval HAL status, HAL_ERROR on the first mismatch
+ */
+static uint8_t EMXXLX_Check_Pattern(EMXXLX_HandleTypeDef *hmram, uint32_t address)
+{
+	uint8_t buffer[EMXXLX_CAL_PATTERN_SIZE];
+
+	for (uint32_t pass = 0; pass < EMXXLX_TUNE_PASSES; pass++)
+	{
+		if (EMXXLX_Read(hmram, address, buffer, EMXXLX_CAL_PATTERN_SIZE) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		for (uint32_t i = 0; i < EMXXLX_CAL_PATTERN_SIZE; i++)
+		{
+			if (buffer[i] != CalPattern[i])
+			{
+				return HAL_ERROR;
+			}
+		}
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Program the OCTOSPI timings, the delay block and the added DS delay
+ * 		   of a calibration.
+ * 	@param hmram			MRAM device handle.
+ *  @param Calibration		Settings to be applied.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Apply_Calibration(EMXXLX_HandleTypeDef *hmram, EMXXLX_CalibrationTypeDef *Calibration)
+{
+	HAL_OSPI_DLYB_CfgTypeDef dlyb = {0};
+
+	hmram->hospi->Init.ClockPrescaler = Calibration->ClockPrescaler;
+	hmram->hospi->Init.SampleShifting = Calibration->SampleShifting;
+	hmram->hospi->Init.DelayHoldQuarterCycle = Calibration->DelayHoldQuarterCycle;
+	hmram->hospi->Init.DelayBlockBypass = Calibration->DelayBlockBypass;
+
+	if (HAL_OSPI_Init(hmram->hospi) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	if (Calibration->DelayBlockBypass == HAL_OSPI_DELAY_BLOCK_USED)
+	{
+		dlyb.Units = Calibration->Units;
+		dlyb.PhaseSel = Calibration->PhaseSel;
+		if (HAL_OSPI_DLYB_SetConfig(hmram->hospi, &dlyb) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+	}
+
+	/* Volatile register 4 holds the added DS delay */
+	if (EMXXLX_Write_Enable(hmram) != HAL_OK || EMXXLX_Write_Vol(hmram, 4, &Calibration->DsDelay, 1) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Sweep the delay block phases over one clock period and keep the
+ * 		   widest run of phases reading the reference pattern back.
+ * 	@param hmram			MRAM device handle.
+ *  @param Calibration		Settings under test, Units, PhaseSel and Window are filled.
+ *  @param address			Address of the reference pattern.
+ *  @retval HAL status, HAL_ERROR when no phase passes
+ */
+static uint8_t EMXXLX_Calibration_Window(EMXXLX_HandleTypeDef *hmram, EMXXLX_CalibrationTypeDef *Calibration,
+										 uint32_t address)
+{
+	HAL_OSPI_DLYB_CfgTypeDef dlyb = {0};
+	uint32_t run = 0, first = 0;
+
+	Calibration->Window = 0;
+	Calibration->DelayBlockBypass = HAL_OSPI_DELAY_BLOCK_USED;
+	Calibration->Units = 0;
+	Calibration->PhaseSel = 0;
+
+	/* Unit delay of one clock period at this prescaler */
+	if (EMXXLX_Apply_Calibration(hmram, Calibration) != HAL_OK
+			|| HAL_OSPI_DLYB_GetClockPeriod(hmram->hospi, &dlyb) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	for (uint32_t phase = 0; phase <= DLYB_MAX_SELECT; phase++)
+	{
+		dlyb.PhaseSel = phase;
+		run = ((HAL_OSPI_DLYB_SetConfig(hmram->hospi, &dlyb) == HAL_OK)
+				&& (EMXXLX_Check_Pattern(hmram, address) == HAL_OK)) ? run + 1 : 0;
+		if (run > Calibration->Window)
+		{
+			Calibration->Window = run;
+			first = phase + 1 - run;
+		}
+	}
+
+	Calibration->Units = dlyb.Units;
+	Calibration->PhaseSel = first + Calibration->Window / 2;
+
+	return (Calibration->Window != 0) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+ *  @brief Clock cycles of one command, chip select high time included.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Command template.
+ *  @param size				Amount of bytes of the data phase.
+ *  @retval Clock cycles
+ */
+static uint32_t EMXXLX_Cmd_Cycles(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+								  uint32_t size)
+{
+	uint32_t cycles = hmram->hospi->Init.ChipSelectHighTime + sCommand->DummyCycles;
+
+	cycles += EMXXLX_Phase_Cycles(8U * (((sCommand->InstructionSize >> OCTOSPI_CCR_ISIZE_Pos) & 0x3U) + 1U),
+								  sCommand->InstructionMode >> OCTOSPI_CCR_IMODE_Pos,
+								  sCommand->InstructionDtrMode != HAL_OSPI_INSTRUCTION_DTR_DISABLE, 1);
+
+	if (sCommand->AddressMode != HAL_OSPI_ADDRESS_NONE)
+	{
+		cycles += EMXXLX_Phase_Cycles(8U * (((sCommand->AddressSize >> OCTOSPI_CCR_ADSIZE_Pos) & 0x3U) + 1U),
+									  sCommand->AddressMode >> OCTOSPI_CCR_ADMODE_Pos,
+									  sCommand->AddressDtrMode != HAL_OSPI_ADDRESS_DTR_DISABLE, 1);
+	}
+
+	if (sCommand->DataMode != HAL_OSPI_DATA_NONE)
+	{
+		/* In dual-quad mode each device takes half of the data */
+		cycles += EMXXLX_Phase_Cycles(8U * size, sCommand->DataMode >> OCTOSPI_CCR_DMODE_Pos,
+									  sCommand->DataDtrMode != HAL_OSPI_DATA_DTR_DISABLE,
+									  EMXXLX_Dies(hmram));
+	}
+
+	return cycles;
+}
+
+/**
+ *  @brief Clock cycles of one command phase.
+ *  @param bits				Amount of bits of the phase.
+ *  @param Mode				Line mode field of the CCR register, 1 to 4 for 1 to 8 lines.
+ *  @param Dtr				Non zero for double transfer rate.
+ *  @param Dies				Devices sharing the phase.
+ *  @retval Clock cycles
+ */
+static uint32_t EMXXLX_Phase_Cycles(uint32_t bits, uint32_t Mode, uint8_t Dtr, uint32_t Dies)
+{
+	uint32_t width;
+
+	Mode &= 0x7U;
+	if (Mode == 0)
+	{
+		return 0;
+	}
+
+	/* Bits moved per clock cycle */
+	width = (1U << (Mode - 1U)) * Dies * ((Dtr != 0) ? 2U : 1U);
+
+	return (bits + width - 1U) / width;
+}
+
+/**
+ *  @brief Start a background transfer, split in commands of
+ * 		   EMXXLX_DMA_MAX_XFER when using DMA. The next commands are chained
+ * 		   from the OSPI interrupts.
+ * 	@param hmram			MRAM device handle.
+ *  @param State			EMXXLX_XFER_RX_DMA, EMXXLX_XFER_TX_DMA, EMXXLX_XFER_RX_IT or EMXXLX_XFER_TX_IT.
+ *  @param address			Memory address of the first byte.
+ *  @param pData			Data buffer, must stay valid until completion.
+ *  @param size				Amount of bytes to be transferred.
+ *  @param Callback			Completion callback, the weak callbacks are used when NULL.
+ *  @param Context			User pointer given back to Callback.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Xfer_Start(EMXXLX_HandleTypeDef *hmram, uint8_t State, uint32_t address,
+								 uint8_t *pData, uint32_t size, EMXXLX_CallbackTypeDef Callback,
+								 void *Context)
+{
+	if ((pData == NULL) || (size == 0))
+	{
+		return HAL_ERROR;
+	}
+
+	if (hmram->XferState != EMXXLX_XFER_IDLE)
+	{
+		return HAL_BUSY;
+	}
+
+	hmram->XferState = State;
+	hmram->XferCallback = Callback;
+	hmram->XferContext = Context;
+	hmram->XferBuffer = pData;
+	hmram->XferAddress = address;
+	hmram->XferRemaining = size;
+
+	if (EMXXLX_Xfer_Chunk(hmram) != HAL_OK)
+	{
+		hmram->XferCallback = NULL;
+		hmram->XferState = EMXXLX_XFER_IDLE;
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Start the next command of the ongoing transfer. A read starts its
+ * 		   data phase at once, a write starts with its write enable command.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Xfer_Chunk(EMXXLX_HandleTypeDef *hmram)
+{
+	uint8_t *pData = hmram->XferBuffer;
+	uint32_t size = hmram->XferRemaining;
+
+	if ((hmram->XferState != EMXXLX_XFER_RX_DMA) && (hmram->XferState != EMXXLX_XFER_RX_IT))
+	{
+		/* The data phase is started from the command complete interrupt */
+		hmram->XferStep = EMXXLX_STEP_WEL;
+		return EMXXLX_Command_IT(hmram, &hmram->CmdSet.WriteEnable);
+	}
+
+	if ((hmram->XferState == EMXXLX_XFER_RX_DMA) && (size > EMXXLX_DMA_MAX_XFER))
+	{
+		size = EMXXLX_DMA_MAX_XFER;
+	}
+
+	hmram->CmdSet.Read.Address = hmram->XferAddress;
+	hmram->CmdSet.Read.NbData = size;
+
+	if (EMXXLX_Command_IT(hmram, &hmram->CmdSet.Read) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	hmram->XferBuffer += size;
+	hmram->XferAddress += size;
+	hmram->XferRemaining -= size;
+
+	if (hmram->XferState == EMXXLX_XFER_RX_DMA)
+	{
+		return HAL_OSPI_Receive_DMA(hmram->hospi, pData);
+	}
+
+	return HAL_OSPI_Receive_IT(hmram->hospi, pData);
+}
+
+/**
+ *  @brief Start the data phase of the ongoing write, or the erase command
+ * 		   of the next block, the write enable latch is set.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Xfer_Data(EMXXLX_HandleTypeDef *hmram)
+{
+	OSPI_RegularCmdTypeDef sCommand;
+	uint8_t *pData = hmram->XferBuffer;
+	uint32_t size = hmram->XferRemaining;
+
+	if (hmram->XferState == EMXXLX_XFER_ERASE_IT)
+	{
+		/* Ends in the command complete interrupt */
+		hmram->XferStep = EMXXLX_STEP_DATA;
+		if (EMXXLX_Erase_Build(hmram, &sCommand, hmram->XferAddress,
+				EMXXLX_Erase_Plan(hmram, hmram->XferAddress, hmram->XferRemaining)) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		return EMXXLX_Command_IT(hmram, &sCommand);
+	}
+
+	if ((hmram->XferState == EMXXLX_XFER_TX_DMA) && (size > EMXXLX_DMA_MAX_XFER))
+	{
+		size = EMXXLX_DMA_MAX_XFER;
+	}
+
+	hmram->CmdSet.Write.Address = hmram->XferAddress;
+	hmram->CmdSet.Write.NbData = size;
+
+	hmram->XferStep = EMXXLX_STEP_DATA;
+	if (EMXXLX_Command_IT(hmram, &hmram->CmdSet.Write) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	hmram->XferBuffer += size;
+	hmram->XferAddress += size;
+	hmram->XferRemaining -= size;
+
+	if (hmram->XferState == EMXXLX_XFER_TX_DMA)
+	{
+		return HAL_OSPI_Transmit_DMA(hmram->hospi, pData);
+	}
+
+	return HAL_OSPI_Transmit_IT(hmram->hospi, pData);
+}
+
+/**
+ *  @brief Wait for the end of the command of the ongoing transfer with the
+ * 		   status match interrupt.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Xfer_Ready(EMXXLX_HandleTypeDef *hmram)
+{
+	OSPI_AutoPollingTypeDef sConfig = {0};
+
+	hmram->XferStep = EMXXLX_STEP_READY;
+	if (EMXXLX_Command_IT(hmram, &hmram->CmdSet.ReadFlags) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_AutoPolling_Config(hmram, &sConfig);
+	return HAL_OSPI_AutoPolling_IT(hmram->hospi, &sConfig);
+}
+
+/**
+ *  @brief Issue a command, every command of the driver goes through here.
+ * 		   The device is woken up from deep power-down first.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Command to be configured.
+ *  @param Timeout			Timeout duration in ms.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Command(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+							  uint32_t Timeout)
+{
+	if (EMXXLX_POWER_WAKE(hmram) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_TRACE(hmram, sCommand);
+	return HAL_OSPI_Command(hmram->hospi, sCommand, Timeout);
+}
+
+/**
+ *  @brief Issue a command without any tick based wait, so that it can be
+ * 		   chained from interrupt context. A command without data phase ends
+ * 		   in HAL_OSPI_CmdCpltCallback, the caller starts the data phase of
+ * 		   the others.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Command to be configured.
+ *  @retval HAL status, HAL_ERROR when the OCTOSPI stays busy
+ */
+static uint8_t EMXXLX_Command_IT(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand)
+{
+	uint32_t spins = EMXXLX_ISR_BUSY_SPINS;
+
+	if (EMXXLX_POWER_WAKE(hmram) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	/* The previous command releases the bus right after its last interrupt */
+	while ((hmram->hospi->Instance->SR & OCTOSPI_SR_BUSY) != 0U)
+	{
+		if (--spins == 0U)
+		{
+			return HAL_ERROR;
+		}
+	}
+
+	EMXXLX_TRACE(hmram, sCommand);
+	if (sCommand->DataMode == HAL_OSPI_DATA_NONE)
+	{
+		return HAL_OSPI_Command_IT(hmram->hospi, sCommand);
+	}
+
+	/* The BUSY flag is already reset, the command returns at once */
+	return HAL_OSPI_Command(hmram->hospi, sCommand, 0U);
+}
+
+/**
+ *  @brief Issue a register read command. In dual-quad mode both devices
+ * 		   answer, each byte is received once per device and both copies
+ * 		   must match. In octal DTR mode an odd read is padded to a word.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Register read command as seen by one device.
+ *  @param Value			Destination of sCommand->NbData bytes.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Reg_Read(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+							   uint8_t *Value)
+{
+	uint8_t buffer[2 * EMXXLX_REG_MAX_SIZE];
+	uint32_t size = sCommand->NbData;
+	uint32_t dies = EMXXLX_Dies(hmram);
+	uint8_t *pBuffer = Value;
+	uint8_t status = HAL_OK;
+
+	EMXXLX_Apply_Dtr(hmram, sCommand);
+	sCommand->DQSMode = hmram->DQSMode;
+
+	if (EMXXLX_Reg_Count(hmram, size) != size)
+	{
+		if (size > EMXXLX_REG_MAX_SIZE)
+		{
+			return HAL_ERROR;
+		}
+
+		/* The controller halves the address, the bytes alternate between the devices */
+		sCommand->Address *= dies;
+		sCommand->NbData = EMXXLX_Reg_Count(hmram, size);
+		pBuffer = buffer;
+	}
+
+	EMXXLX_STATS_BEGIN();
+
+	/* Configure the command and receive the data */
+	if (EMXXLX_Command(hmram, sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK
+		|| HAL_OSPI_Receive(hmram->hospi, pBuffer, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		status = HAL_ERROR;
+	}
+
+	EMXXLX_STATS_END(hmram, EMXXLX_STAT_REGISTER, sCommand->NbData, status);
+	if (status != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	if (pBuffer == buffer)
+	{
+		for (uint32_t i = 0; i < size; i++)
+		{
+			if ((dies == 2U) && (buffer[2 * i] != buffer[2 * i + 1]))
+			{
+				return HAL_ERROR;
+			}
+			Value[i] = buffer[dies * i];
+		}
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Issue a register write command. In dual-quad mode each byte is
+ * 		   sent once per device so that both devices get the same value. In
+ * 		   octal DTR mode an odd configuration register write is widened to
+ * 		   a word with the value of the neighbouring register, as last
+ * 		   written or read from the device before the initialization. An
+ * 		   odd status register write is padded with its last byte.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Register write command as seen by one device.
+ *  @param pData			Source of sCommand->NbData bytes.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Reg_Write(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand,
+								uint8_t *pData)
+{
+	OSPI_RegularCmdTypeDef sRead;
+	uint8_t buffer[2 * EMXXLX_REG_MAX_SIZE];
+	uint8_t *pSource = pData;
+	uint32_t address = sCommand->Address;
+	uint32_t size = sCommand->NbData;
+	uint32_t length = size;
+	uint32_t dies = EMXXLX_Dies(hmram);
+	uint32_t count = EMXXLX_Reg_Count(hmram, size);
+	uint32_t regs = (sCommand->Instruction == MRAM_WRITE_VOL_CMD) ? 1U : 0U;
+	uint32_t start;
+	uint8_t status = HAL_OK;
+
+	if ((count != size) && (size > EMXXLX_REG_MAX_SIZE))
+	{
+		return HAL_ERROR;
+	}
+
+	/* The padding byte would land in the neighbouring register: the access
+	   starts on an even address and the added byte keeps its value. The
+	   registers last written are used since the reads are not reliable
+	   while the bus timings are calibrated or tuned */
+	if ((count != size * dies) && (sCommand->AddressMode != HAL_OSPI_ADDRESS_NONE))
+	{
+		start = address & ~(EMXXLX_Alignment(hmram) - 1U);
+		count = EMXXLX_Reg_Count(hmram, address - start + size);
+
+		if ((hmram->RegsValid != 0) && (start + count <= sizeof(hmram->Regs[0])))
+		{
+			memcpy(buffer, &hmram->Regs[regs][start], count);
+		}
+		else
+		{
+			sRead = *sCommand;
+			sRead.Instruction = (regs != 0U) ? MRAM_READ_VOL_CMD : MRAM_READ_NONVOL_CMD;
+			sRead.Address = start;
+			sRead.NbData = count;
+			sRead.DummyCycles = hmram->CfgDc;
+			if (EMXXLX_Reg_Read(hmram, &sRead, buffer) != HAL_OK)
+			{
+				return HAL_ERROR;
+			}
+		}
+
+		memcpy(&buffer[address - start], pData, size);
+		sCommand->Address = start;
+		sCommand->NbData = count;
+		pData = buffer;
+		size = count;
+	}
+
+	EMXXLX_Apply_Dtr(hmram, sCommand);
+
+	if (count != size)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			buffer[i] = pData[(i / dies < size) ? i / dies : size - 1];
+		}
+
+		/* The controller halves the address, the bytes alternate between the devices */
+		sCommand->Address *= dies;
+		sCommand->NbData = count;
+		pData = buffer;
+	}
+
+	EMXXLX_STATS_BEGIN();
+
+	/* Configure the command and send the data */
+	if (EMXXLX_Command(hmram, sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK
+		|| HAL_OSPI_Transmit(hmram->hospi, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		status = HAL_ERROR;
+	}
+
+	EMXXLX_STATS_END(hmram, EMXXLX_STAT_REGISTER, sCommand->NbData, status);
+
+	/* The status register has no address */
+	if ((status == HAL_OK) && (sCommand->AddressMode != HAL_OSPI_ADDRESS_NONE)
+			&& (address + length <= sizeof(hmram->Regs[0])))
+	{
+		memcpy(&hmram->Regs[regs][address], pSource, length);
+	}
+
+	return status;
+}
+
+uint8_t EMXXLX_Read_Nonvol(EMXXLX_HandleTypeDef *hmram, uint32_t address,
+						   uint8_t *Value, uint8_t size)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the read register command */
+	sCommand.Instruction = MRAM_READ_NONVOL_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.Address = address;
+	sCommand.AddressMode = hmram->AddMode;
+	sCommand.AddressSize = hmram->AddSize;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = size;
+	sCommand.DummyCycles = hmram->CfgDc;
+
+	return EMXXLX_Reg_Read(hmram, &sCommand, Value);
+}
+
+uint8_t EMXXLX_Write_Nonvol(EMXXLX_HandleTypeDef *hmram, uint32_t address,
+							uint8_t *pData, uint8_t size)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the write register command */
+	sCommand.Instruction = MRAM_WRITE_NONVOL_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.Address = address;
+	sCommand.AddressMode = hmram->AddMode;
+	sCommand.AddressSize = hmram->AddSize;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = size;
+
+	return EMXXLX_Reg_Write(hmram, &sCommand, pData);
+}
+
+uint8_t EMXXLX_Read_Vol(EMXXLX_HandleTypeDef *hmram, uint32_t address,
+						uint8_t *Value, uint8_t size)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the read register command */
+	sCommand.Instruction = MRAM_READ_VOL_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.Address = address;
+	sCommand.AddressMode = hmram->AddMode;
+	sCommand.AddressSize = hmram->AddSize;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = size;
+	sCommand.DummyCycles = hmram->CfgDc;
+
+	return EMXXLX_Reg_Read(hmram, &sCommand, Value);
+}
+
+uint8_t EMXXLX_Write_Vol(EMXXLX_HandleTypeDef *hmram, uint32_t address,
+						 uint8_t *pData, uint8_t size)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the write register command */
+	sCommand.Instruction = MRAM_WRITE_VOL_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.Address = address;
+	sCommand.AddressMode = hmram->AddMode;
+	sCommand.AddressSize = hmram->AddSize;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = size;
+
+	return EMXXLX_Reg_Write(hmram, &sCommand, pData);
+}
+
+uint8_t EMXXLX_Write_Status(EMXXLX_HandleTypeDef *hmram, uint8_t *pData)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the write register command */
+	sCommand.Instruction = MRAM_WRITE_STATUS_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = 1;
+
+	return EMXXLX_Reg_Write(hmram, &sCommand, pData);
+}
+
+uint8_t EMXXLX_Read_Flags(EMXXLX_HandleTypeDef *hmram, uint8_t *Value)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the read register command */
+	sCommand.Instruction = MRAM_READ_FLAGS_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = 1;
+	sCommand.DummyCycles = hmram->CfgDc;
+
+	return EMXXLX_Reg_Read(hmram, &sCommand, Value);
+}
+
+uint8_t EMXXLX_Clear_flags(EMXXLX_HandleTypeDef *hmram)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the write register command */
+	sCommand.Instruction = MRAM_CLR_FLAGS_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
+
+	/* Configure the command */
+	if (EMXXLX_Command(hmram, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+uint8_t EMXXLX_Read_Status(EMXXLX_HandleTypeDef *hmram, uint8_t *Value)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	/* Initialize the read register command */
+	sCommand.Instruction = MRAM_READ_STATUS_REG_CMD;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = 1;
+	sCommand.DummyCycles = hmram->CfgDc;
+
+	return EMXXLX_Reg_Read(hmram, &sCommand, Value);
+}
+
+
+#if defined(EMXXLX_USE_TRACE)
+/**
+ *  @brief Clear the command trace and start the DWT cycle counter used for
+ * 		   the timestamps.
+ */
+void EMXXLX_Trace_Reset(void)
+{
+	__HAL_RCC_SRAM4_CLK_ENABLE();
+
+	memset(&EMXXLX_Trace, 0, sizeof(EMXXLX_Trace));
+	EMXXLX_Trace.Magic = EMXXLX_TRACE_MAGIC;
+	EMXXLX_Trace.EntrySize = sizeof(EMXXLX_TraceEntryTypeDef);
+	EMXXLX_Trace.Entries = EMXXLX_TRACE_ENTRIES;
+
+	if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U)
+	{
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+}
+
+/**
+ *  @brief Log a command in the trace ring buffer, the oldest entry is
+ * 		   overwritten once the buffer is full.
+ * 	@param hmram			MRAM device handle.
+ *  @param sCommand			Command about to be issued.
+ */
+static void EMXXLX_Trace_Record(EMXXLX_HandleTypeDef *hmram, OSPI_RegularCmdTypeDef *sCommand)
+{
+	EMXXLX_TraceEntryTypeDef *pEntry;
+	uint32_t primask = __get_PRIMASK();
+
+	/* Commands are issued from thread and interrupt context */
+	__disable_irq();
+	pEntry = &EMXXLX_Trace.Entry[EMXXLX_Trace.Head % EMXXLX_TRACE_ENTRIES];
+	EMXXLX_Trace.Head++;
+	__set_PRIMASK(primask);
+
+	pEntry->Timestamp = DWT->CYCCNT;
+	pEntry->Address = sCommand->Address;
+	pEntry->NbData = sCommand->NbData;
+	pEntry->Instruction = (uint8_t)sCommand->Instruction;
+	pEntry->Port = (hmram->hospi->Instance == OCTOSPI1) ? 1U : 2U;
+	pEntry->Mode = (((sCommand->InstructionMode >> OCTOSPI_CCR_IMODE_Pos) & 0x7U) << EMXXLX_TRACE_IMODE_Pos)
+			| (((sCommand->AddressMode >> OCTOSPI_CCR_ADMODE_Pos) & 0x7U) << EMXXLX_TRACE_ADMODE_Pos)
+			| (((sCommand->DataMode >> OCTOSPI_CCR_DMODE_Pos) & 0x7U) << EMXXLX_TRACE_DMODE_Pos)
+			| ((sCommand->InstructionDtrMode != HAL_OSPI_INSTRUCTION_DTR_DISABLE) ? EMXXLX_TRACE_DTR : 0U)
+			| ((sCommand->DQSMode != HAL_OSPI_DQS_DISABLE) ? EMXXLX_TRACE_DQS : 0U)
+			| ((EMXXLX_Dies(hmram) == 2U) ? EMXXLX_TRACE_DUALQUAD : 0U);
+}
+#endif /* EMXXLX_USE_TRACE */
+
+#if defined(EMXXLX_USE_STATS)
+/**
+ *  @brief Copy the statistics recorded since the last reset.
+ * 	@param hmram			MRAM device handle.
+ *  @param Stats			Destination of the statistics.
+ */
+void EMXXLX_GetStats(EMXXLX_HandleTypeDef *hmram, EMXXLX_StatsTypeDef *Stats)
+{
+	memcpy(Stats, &hmram->Stats, sizeof(*Stats));
+}
+
+/**
+ *  @brief Clear the statistics and start the DWT cycle counter.
+ * 	@param hmram			MRAM device handle.
+ */
+void EMXXLX_ResetStats(EMXXLX_HandleTypeDef *hmram)
+{
+	memset(&hmram->Stats, 0, sizeof(hmram->Stats));
+
+	if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U)
+	{
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+}
+
+/**
+ *  @brief Account one call of an instrumented operation.
+ * 	@param hmram			MRAM device handle.
+ *  @param Op				A value of @ref EMXXLX_Stats_Operation.
+ *  @param Bytes			Bytes moved by the call.
+ *  @param Start			DWT cycle counter at the start of the call.
+ *  @param Status			HAL status of the call.
+ */
+static void EMXXLX_Stats_Record(EMXXLX_HandleTypeDef *hmram, uint8_t Op, uint32_t Bytes,
+								uint32_t Start, uint8_t Status)
+{
+	EMXXLX_OpStatsTypeDef *pStats = &hmram->Stats.Op[Op];
+	uint32_t cycles = DWT->CYCCNT - Start;
+	uint32_t bucket = 31U - __CLZ(cycles | 1U);
+
+	/* Bucket n holds the calls of 2^(n + EMXXLX_STATS_FIRST_BUCKET) cycles and more */
+	bucket = (bucket > EMXXLX_STATS_FIRST_BUCKET) ? bucket - EMXXLX_STATS_FIRST_BUCKET : 0;
+	if (bucket >= EMXXLX_STATS_BUCKETS)
+	{
+		bucket = EMXXLX_STATS_BUCKETS - 1;
+	}
+
+	pStats->Calls++;
+	if (Status != HAL_OK)
+	{
+		pStats->Errors++;
+	}
+	else
+	{
+		pStats->Bytes += Bytes;
+	}
+	pStats->Cycles += cycles;
+	if (cycles > pStats->MaxCycles)
+	{
+		pStats->MaxCycles = cycles;
+	}
+	pStats->Histogram[bucket]++;
+}
+#endif /* EMXXLX_USE_STATS */
+
+#if defined(EMXXLX_USE_POWER)
+/**
+ *  @brief Enable the deep power-down manager and clear its accounting. The
+ * 		   device enters deep power-down from EMXXLX_Power_Process once idle
+ * 		   for IdleTimeout, the next command wakes it up.
+ * 	@param hmram			MRAM device handle, the device must be awake.
+ *  @param IdleTimeout		Idle time in ms before the deep power-down, 0 disables it.
+ */
+void EMXXLX_Power_Config(EMXXLX_HandleTypeDef *hmram, uint32_t IdleTimeout)
+{
+	memset(&hmram->Power, 0, sizeof(hmram->Power));
+	hmram->Power.State = EMXXLX_POWER_STANDBY;
+	hmram->Power.IdleTimeout = IdleTimeout;
+	hmram->Power.LastAccess = HAL_GetTick();
+	hmram->Power.StateTick = hmram->Power.LastAccess;
+
+	/* The wake-up latency is measured with the DWT cycle counter */
+	if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U)
+	{
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+}
+
+/**
+ *  @brief Enter deep power-down once the device has been idle for the
+ * 		   configured time, to be called periodically from the main loop.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status, HAL_BUSY while a transfer or memory-mapped mode is ongoing
+ */
+uint8_t EMXXLX_Power_Process(EMXXLX_HandleTypeDef *hmram)
+{
+	if ((hmram->Power.State != EMXXLX_POWER_STANDBY) || (hmram->Power.IdleTimeout == 0U)
+		|| ((HAL_GetTick() - hmram->Power.LastAccess) < hmram->Power.IdleTimeout))
+	{
+		return HAL_OK;
+	}
+
+	return EMXXLX_Power_Down(hmram);
+}
+
+/**
+ *  @brief Put the device in deep power-down now.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status, HAL_BUSY while a transfer or memory-mapped mode is ongoing
+ */
+uint8_t EMXXLX_Power_Down(EMXXLX_HandleTypeDef *hmram)
+{
+	if (hmram->Power.State == EMXXLX_POWER_DPD)
+	{
+		return HAL_OK;
+	}
+
+	if ((hmram->XferState != EMXXLX_XFER_IDLE) || (hmram->hospi->State != HAL_OSPI_STATE_READY))
+	{
+		return HAL_BUSY;
+	}
+
+	if (EMXXLX_Power_Command(hmram, MRAM_DPD_ENTER_CMD) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_Power_Account(hmram, EMXXLX_POWER_DPD);
+	return HAL_OK;
+}
+
+/**
+ *  @brief Wake the device up from deep power-down and wait for the exit
+ * 		   latency. Called by every command of the driver, it also restarts
+ * 		   the idle time.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+uint8_t EMXXLX_Power_Wake(EMXXLX_HandleTypeDef *hmram)
+{
+	uint32_t start, cycles;
+	uint32_t latency = EMXXLX_DPD_EXIT_US * (SystemCoreClock / 1000000U);
+
+	hmram->Power.LastAccess = HAL_GetTick();
+
+	if (hmram->Power.State != EMXXLX_POWER_DPD)
+	{
+		return HAL_OK;
+	}
+
+	start = DWT->CYCCNT;
+	if (EMXXLX_Power_Command(hmram, MRAM_DPD_EXIT_CMD) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	while ((DWT->CYCCNT - start) < latency)
+	{
+	}
+	cycles = DWT->CYCCNT - start;
+
+	hmram->Power.Wakeups++;
+	hmram->Power.WakeCycles += cycles;
+	if (cycles > hmram->Power.MaxWakeCycles)
+	{
+		hmram->Power.MaxWakeCycles = cycles;
+	}
+
+	EMXXLX_Power_Account(hmram, EMXXLX_POWER_STANDBY);
+	return HAL_OK;
+}
+
+/**
+ *  @brief Time and estimated energy of each power state since
+ * 		   EMXXLX_Power_Config, with the wake-up latency.
+ * 	@param hmram			MRAM device handle.
+ *  @param Stats			Destination of the statistics.
+ */
+void EMXXLX_GetPower(EMXXLX_HandleTypeDef *hmram, EMXXLX_PowerStatsTypeDef *Stats)
+{
+	static const uint32_t current[EMXXLX_POWER_STATES] = { EMXXLX_POWER_STANDBY_UA, EMXXLX_POWER_DPD_UA };
+	uint32_t mhz = SystemCoreClock / 1000000U;
+
+	for (uint32_t i = 0; i < EMXXLX_POWER_STATES; i++)
+	{
+		Stats->TimeMs[i] = hmram->Power.TimeMs[i];
+	}
+	Stats->TimeMs[hmram->Power.State] += HAL_GetTick() - hmram->Power.StateTick;
+
+	/* uA x mV x ms gives pJ */
+	for (uint32_t i = 0; i < EMXXLX_POWER_STATES; i++)
+	{
+		Stats->EnergyUj[i] = (Stats->TimeMs[i] * current[i] * EMXXLX_POWER_VCC_MV) / 1000000U;
+	}
+
+	Stats->Wakeups = hmram->Power.Wakeups;
+	Stats->WakeLatencyUs = (hmram->Power.Wakeups != 0U) ?
+			(uint32_t)(hmram->Power.WakeCycles / hmram->Power.Wakeups / mhz) : 0U;
+	Stats->MaxWakeLatencyUs = hmram->Power.MaxWakeCycles / mhz;
+}
+
+/**
+ *  @brief Send an instruction only command, used to enter and exit the
+ * 		   deep power-down.
+ * 	@param hmram			MRAM device handle.
+ *  @param Instruction		MRAM_DPD_ENTER_CMD or MRAM_DPD_EXIT_CMD.
+ *  @retval HAL status
+ */
+static uint8_t EMXXLX_Power_Command(EMXXLX_HandleTypeDef *hmram, uint8_t Instruction)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	sCommand.Instruction = Instruction;
+	sCommand.InstructionMode = hmram->InstMode;
+	EMXXLX_Apply_Dtr(hmram, &sCommand);
+
+	/* Sent directly, EMXXLX_Command would wake the device up again */
+	EMXXLX_TRACE(hmram, &sCommand);
+	if (HAL_OSPI_Command(hmram->hospi, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Account the time of the current power state and switch to State.
+ * 	@param hmram			MRAM device handle.
+ *  @param State			A value of @ref EMXXLX_Power_State.
+ */
+static void EMXXLX_Power_Account(EMXXLX_HandleTypeDef *hmram, uint8_t State)
+{
+	uint32_t now = HAL_GetTick();
+
+	hmram->Power.TimeMs[hmram->Power.State] += now - hmram->Power.StateTick;
+	hmram->Power.StateTick = now;
+	hmram->Power.State = State;
+}
+#endif /* EMXXLX_USE_POWER */
+
+/**
+ *  @brief Terminate the ongoing background transfer and notify the caller.
+ * 	@param hmram			MRAM device handle.
+ *  @param Status			HAL status of the transfer.
+ */
+static void EMXXLX_Xfer_Complete(EMXXLX_HandleTypeDef *hmram, uint8_t Status)
+{
+	EMXXLX_CallbackTypeDef callback;
+	void *context;
+	uint8_t state = EMXXLX_Xfer_Release(hmram, EMXXLX_XFER_IDLE, &callback, &context);
+
+	/* Released before notifying so that the callback can start a new transfer */
+	if (state != EMXXLX_XFER_IDLE)
+	{
+		EMXXLX_Xfer_Notify(hmram, state, callback, context, Status);
+	}
+}
+
+/**
+ *  @brief Release the background transfer under a short critical section,
+ * 		   so that the thread and the OSPI interrupts cannot both end it.
+ * 	@param hmram			MRAM device handle.
+ *  @param State			Transfer state to be released, EMXXLX_XFER_IDLE for any.
+ *  @param Callback			Destination of the completion callback of the transfer.
+ *  @param Context			Destination of the caller context of the transfer.
+ *  @retval State of the released transfer, EMXXLX_XFER_IDLE when none was
+ */
+static uint8_t EMXXLX_Xfer_Release(EMXXLX_HandleTypeDef *hmram, uint8_t State,
+								   EMXXLX_CallbackTypeDef *Callback, void **Context)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint8_t state;
+
+	__disable_irq();
+	state = hmram->XferState;
+	if ((State != EMXXLX_XFER_IDLE) && (state != State))
+	{
+		state = EMXXLX_XFER_IDLE;
+	}
+
+	*Callback = hmram->XferCallback;
+	*Context = hmram->XferContext;
+	if (state != EMXXLX_XFER_IDLE)
+	{
+		hmram->XferCallback = NULL;
+		hmram->XferContext = NULL;
+		hmram->XferState = EMXXLX_XFER_IDLE;
+	}
+	__set_PRIMASK(primask);
+
+	return state;
+}
+
+/**
+ *  @brief Notify the caller of the end of a released transfer.
+ * 	@param hmram			MRAM device handle.
+ *  @param State			State of the released transfer.
+ *  @param Callback			Completion callback of the transfer.
+ *  @param Context			Caller context of the transfer.
+ *  @param Status			HAL status of the transfer.
+ */
+static void EMXXLX_Xfer_Notify(EMXXLX_HandleTypeDef *hmram, uint8_t State,
+							   EMXXLX_CallbackTypeDef Callback, void *Context, uint8_t Status)
+{
+	if (Callback != NULL)
+	{
+		Callback(hmram, Status, Context);
+	}
+	else if (Status != HAL_OK)
+	{
+		EMXXLX_ErrorCallback(hmram);
+	}
+	else if (State == EMXXLX_XFER_RX_DMA)
+	{
+		EMXXLX_RxCpltCallback(hmram);
+	}
+	else if (State == EMXXLX_XFER_TX_DMA)
+	{
+		EMXXLX_TxCpltCallback(hmram);
+	}
+}
+
+/**
+ *  @brief OSPI status match callback, the device reported ready.
+ * 	@param hospi			SPI peripheral handle.
+ */
+void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi)
+{
+	EMXXLX_HandleTypeDef *hmram = EMXXLX_Get_Handle(hospi);
+
+	if (hmram == NULL)
+	{
+		return;
+	}
+
+	if (hmram->XferState == EMXXLX_XFER_ERASE_IT)
+	{
+		/* The block issued last is erased */
+		uint32_t block = EMXXLX_Erase_Plan(hmram, hmram->XferAddress, hmram->XferRemaining)
+				* EMXXLX_Dies(hmram);
+
+		hmram->XferAddress += block;
+		hmram->XferRemaining -= block;
+
+		if (hmram->XferRemaining == 0)
+		{
+			EMXXLX_Xfer_Complete(hmram, HAL_OK);
+		}
+		else if ((hmram->XferTimeout != HAL_MAX_DELAY)
+				&& ((HAL_GetTick() - hmram->XferTickstart) > hmram->XferTimeout))
+		{
+			EMXXLX_Xfer_Complete(hmram, HAL_TIMEOUT);
+		}
+		else if (EMXXLX_Xfer_Chunk(hmram) != HAL_OK)
+		{
+			EMXXLX_Xfer_Complete(hmram, HAL_ERROR);
+		}
+		return;
+	}
+
+	if (((hmram->XferState == EMXXLX_XFER_TX_DMA) || (hmram->XferState == EMXXLX_XFER_TX_IT))
+		&& (hmram->XferStep == EMXXLX_STEP_READY))
+	{
+		/* The device is ready, the next command can start */
+		if (hmram->XferRemaining == 0)
+		{
+			EMXXLX_Xfer_Complete(hmram, HAL_OK);
+		}
+		else if (EMXXLX_Xfer_Chunk(hmram) != HAL_OK)
+		{
+			EMXXLX_Xfer_Complete(hmram, HAL_ERROR);
+		}
+		return;
+	}
+
+	if (hmram->XferState != EMXXLX_XFER_POLL_IT)
+	{
+		return;
+	}
+
+	EMXXLX_Xfer_Complete(hmram, HAL_OK);
+}
+
+/**
+ *  @brief OSPI command complete callback, starts the data phase of a
+ * 		   background write once the write enable latch is set.
+ * 	@param hospi			SPI peripheral handle.
+ */
+void HAL_OSPI_CmdCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	EMXXLX_HandleTypeDef *hmram = EMXXLX_Get_Handle(hospi);
+
+	if (hmram == NULL)
+	{
+		return;
+	}
+
+	if ((hmram->XferState == EMXXLX_XFER_ERASE_IT) && (hmram->XferStep == EMXXLX_STEP_DATA))
+	{
+		/* The erase command is sent, the device is busy until the block is erased */
+		if (EMXXLX_Xfer_Ready(hmram) != HAL_OK)
+		{
+			EMXXLX_Xfer_Complete(hmram, HAL_ERROR);
+		}
+		return;
+	}
+
+	if (((hmram->XferState != EMXXLX_XFER_TX_DMA) && (hmram->XferState != EMXXLX_XFER_TX_IT)
+		&& (hmram->XferState != EMXXLX_XFER_ERASE_IT)) || (hmram->XferStep != EMXXLX_STEP_WEL))
+	{
+		return;
+	}
+
+	if (EMXXLX_Xfer_Data(hmram) != HAL_OK)
+	{
+		EMXXLX_Xfer_Complete(hmram, HAL_ERROR);
+	}
+}
+
+/**
+ *  @brief OSPI reception complete callback, chains the pending read commands.
+ * 	@param hospi			SPI peripheral handle.
+ */
+void HAL_OSPI_RxCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	EMXXLX_HandleTypeDef *hmram = EMXXLX_Get_Handle(hospi);
+
+	if (hmram == NULL)
+	{
+		return;
+	}
+
+	if (hmram->XferState != EMXXLX_XFER_RX_DMA && hmram->XferState != EMXXLX_XFER_RX_IT)
+	{
+		return;
+	}
+
+	if (hmram->XferRemaining != 0)
+	{
+		if (EMXXLX_Xfer_Chunk(hmram) != HAL_OK)
+		{
+			EMXXLX_Xfer_Complete(hmram, HAL_ERROR);
+		}
+		return;
+	}
+
+	EMXXLX_Xfer_Complete(hmram, HAL_OK);
+}
+
+/**
+ *  @brief OSPI transmission complete callback, waits for the device to be
+ * 		   ready before the next write command or the completion.
+ * 	@param hospi			SPI peripheral handle.
+ */
+void HAL_OSPI_TxCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	EMXXLX_HandleTypeDef *hmram = EMXXLX_Get_Handle(hospi);
+
+	if (hmram == NULL)
+	{
+		return;
+	}
+
+	if (((hmram->XferState != EMXXLX_XFER_TX_DMA) && (hmram->XferState != EMXXLX_XFER_TX_IT))
+		|| (hmram->XferStep != EMXXLX_STEP_DATA))
+	{
+		return;
+	}
+
+	if (EMXXLX_Xfer_Ready(hmram) != HAL_OK)
+	{
+		EMXXLX_Xfer_Complete(hmram, HAL_ERROR);
+	}
+}
+
+/**
+ *  @brief OSPI error callback, terminates the ongoing transfer.
+ * 	@param hospi			SPI peripheral handle.
+ */
+void HAL_OSPI_ErrorCallback(OSPI_HandleTypeDef *hospi)
+{
+	EMXXLX_HandleTypeDef *hmram = EMXXLX_Get_Handle(hospi);
+
+	if (hmram == NULL)
+	{
+		return;
+	}
+
+	if (hmram->XferState == EMXXLX_XFER_IDLE)
+	{
+		return;
+	}
+
+	EMXXLX_Xfer_Complete(hmram, HAL_ERROR);
+}
+
+/**
+ *  @brief Read transfer completed callback, to be overridden by the application.
+ * 	@param hmram			MRAM device handle.
+ */
+__weak void EMXXLX_RxCpltCallback(EMXXLX_HandleTypeDef *hmram)
+{
+	UNUSED(hmram);
+}
+
+/**
+ *  @brief Write transfer completed callback, to be overridden by the application.
+ * 	@param hmram			MRAM device handle.
+ */
+__weak void EMXXLX_TxCpltCallback(EMXXLX_HandleTypeDef *hmram)
+{
+	UNUSED(hmram);
+}
+
+/**
+ *  @brief Transfer error callback, to be overridden by the application.
+ * 	@param hmram			MRAM device handle.
+ */
+__weak void EMXXLX_ErrorCallback(EMXXLX_HandleTypeDef *hmram)
+{
+	UNUSED(hmram);
+}
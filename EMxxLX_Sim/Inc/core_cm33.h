@@ -0,0 +1,116 @@
+/*
+ * core_cm33.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host replacement of the CMSIS Cortex-M33 core header, found before the
+ *  device header includes the real one. It keeps the CMSIS names used by
+ *  the HAL headers and the driver: the interrupt mask is a variable, the
+ *  DWT cycle counter follows the simulated time and a busy wait on it, as
+ *  in EMXXLX_Power_Wake, jumps to the next microsecond or interrupt.
+ */
+
+#ifndef __CORE_CM33_H_GENERIC
+#define __CORE_CM33_H_GENERIC
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __CM33_CMSIS_VERSION_MAIN	(5U)
+#define __CM33_CMSIS_VERSION_SUB	(9U)
+#define __CORTEX_M					(33U)
+
+#define __I							volatile const
+#define __O							volatile
+#define __IO						volatile
+#define __IM						volatile const
+#define __OM						volatile
+#define __IOM						volatile
+
+#define __ASM						__asm
+#define __INLINE					inline
+#define __STATIC_INLINE				static inline
+#define __STATIC_FORCEINLINE		__attribute__((always_inline)) static inline
+#define __NO_RETURN					__attribute__((__noreturn__))
+#define __USED						__attribute__((used))
+#define __WEAK						__attribute__((weak))
+#define __PACKED					__attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT				struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION				union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)				__attribute__((aligned(x)))
+#define __RESTRICT					__restrict
+#define __COMPILER_BARRIER()		__asm volatile("" ::: "memory")
+
+struct __attribute__((packed)) T_UINT16_READ { uint16_t v; };
+struct __attribute__((packed)) T_UINT16_WRITE { uint16_t v; };
+struct __attribute__((packed)) T_UINT32_READ { uint32_t v; };
+struct __attribute__((packed)) T_UINT32_WRITE { uint32_t v; };
+
+#define __UNALIGNED_UINT16_READ(addr)			(((const struct T_UINT16_READ *)(const void *)(addr))->v)
+#define __UNALIGNED_UINT16_WRITE(addr, val)		(void)((((struct T_UINT16_WRITE *)(void *)(addr))->v) = (val))
+#define __UNALIGNED_UINT32_READ(addr)			(((const struct T_UINT32_READ *)(const void *)(addr))->v)
+#define __UNALIGNED_UINT32_WRITE(addr, val)		(void)((((struct T_UINT32_WRITE *)(void *)(addr))->v) = (val))
+
+/* Interrupt mask, the simulated interrupts are only delivered while it is clear */
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __disable_irq(void);
+void __enable_irq(void);
+
+#define __NOP()						__COMPILER_BARRIER()
+#define __DSB()						__sync_synchronize()
+#define __DMB()						__sync_synchronize()
+#define __ISB()						__sync_synchronize()
+#define __WFI()						__COMPILER_BARRIER()
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+	return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+	uint32_t result = 0U;
+
+	for (uint32_t i = 0U; i < 32U; i++)
+	{
+		result = (result << 1) | ((value >> i) & 1U);
+	}
+
+	return result;
+}
+
+typedef struct
+{
+	__IOM uint32_t CTRL;
+	__IOM uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	__IOM uint32_t DHCSR;
+	__OM  uint32_t DCRSR;
+	__IOM uint32_t DCRDR;
+	__IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Pos		0U
+#define DWT_CTRL_CYCCNTENA_Msk		(0x1UL << DWT_CTRL_CYCCNTENA_Pos)
+#define CoreDebug_DEMCR_TRCENA_Pos	24U
+#define CoreDebug_DEMCR_TRCENA_Msk	(1UL << CoreDebug_DEMCR_TRCENA_Pos)
+
+/* Every access to the cycle counter brings it up to the simulated time */
+DWT_Type *EMXXLX_Sim_Dwt(void);
+extern CoreDebug_Type EMXXLX_Sim_CoreDebug;
+
+#define DWT							(EMXXLX_Sim_Dwt())
+#define CoreDebug					(&EMXXLX_Sim_CoreDebug)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CORE_CM33_H_GENERIC */
@@ -0,0 +1,212 @@
+/*
+ * mram_sim.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host simulator of the EMxxLX behind the HAL_OSPI API, to run the driver
+ *  and the example modules on Linux. The HAL_OSPI_* entry points used by
+ *  the driver are implemented against an in-memory model of the devices,
+ *  the OCTOSPI registers are kept at their STM32U575 addresses so that the
+ *  direct register accesses of the driver also work.
+ *
+ *  Model of each device:
+ *  - volatile and nonvolatile configuration registers, status register,
+ *    flag status register and write enable latch, as read and written by
+ *    the register commands;
+ *  - interface mode of volatile register 0: a command sent with other
+ *    lines, transfer rate or address size than the device expects is
+ *    ignored, its reads return the idle bus level 0xFF;
+ *  - read latency of volatile register 1: data sampled with fewer or more
+ *    dummy cycles than the device latency is shifted on the bus;
+ *  - erase value of volatile register 8, wrap of volatile register 7,
+ *    deep power-down and 4-byte address mode;
+ *  - internal write and erase times, only the status and flag reads are
+ *    answered while busy;
+ *  - volatile registers reloaded from the nonvolatile ones by the JEDEC
+ *    reset sequence on the pins, the reset command and a power cycle;
+  - read sampling window, once DataSkewPs is set: each data bit is driven
+    DataDelayPs after its clock or DQS edge and is unstable for DataSkewPs.
+    The OCTOSPI samples it half a bit period after the edge, plus the delay
+    block phase when it is used. On the clock, add half a cycle with the
+    sample shifting and a quarter with the data hold, on DQS the added DS
+    delay of volatile register 4. A sample in the unstable part inverts
+    the data, a sample one bit period early or late shifts it on the bus.
+ *
+ *  Every command is timed from the OCTOSPI registers: chip select high
+ *  time, instruction, address, alternate bytes, dummy cycles and data
+ *  phases with their lines and transfer rate, in kernel clock periods
+ *  times the prescaler. The simulated time only moves with the simulated
+ *  hardware and the HAL calls, see EMXXLX_SIM_TimingTypeDef.
+ *
+ *  Interrupts: the completion of the _IT and _DMA calls, Command_IT and
+ *  AutoPolling_IT is delivered at its due time from HAL_GetTick, HAL_Delay,
+ *  the DWT cycle counter reads, __enable_irq and __set_PRIMASK, or from a
+ *  periodic host timer while the program spins without calling any of
+ *  them. Nothing is delivered while PRIMASK is set or from a callback.
+ *
+ *  Register level model: once enabled with EMXXLX_Sim_Registers, the
+ *  direct accesses of the driver to the OCTOSPI registers of a port are
+ *  trapped, so that an indirect read programmed through CR, CCR, TCR, DLR,
+ *  IR and AR is sent to the device and drained from a 32-byte FIFO through
+ *  SR and DR at the bus rate. Linux on x86-64 only.
+ *
+ *  Known differences with the hardware and the ST HAL:
+ *  - HAL_OSPI_Init programs the registers on every call, the ST HAL only
+ *    does it from the reset state;
+ *  - memory-mapped reads are not modelled, HAL_OSPI_MemoryMapped only
+ *    changes the state;
+ *  - a register write in octal DTR is contiguous, a padding byte lands in
+ *    the next register;
+ *  - a transfer error of a blocking call returns HAL_ERROR with
+ *    HAL_OSPI_ERROR_TRANSFER instead of waiting for the timeout.
+ */
+
+#include "main.h"
+#include "octospi.h"
+
+#ifndef INC_MRAM_SIM_H_
+#define INC_MRAM_SIM_H_
+
+#define EMXXLX_SIM_PORTS			2 // OCTOSPI instances, port 1 is hospi1 and port 2 is hospi2
+#define EMXXLX_SIM_DIES				2 // Devices per port, the second one only answers in dual-quad mode
+#define EMXXLX_SIM_SIZE_BITS		27 // Address bits of one device
+#define EMXXLX_SIM_SIZE				(1UL << EMXXLX_SIM_SIZE_BITS) // Bytes of one device
+#define EMXXLX_SIM_REGISTERS		9 // Volatile and nonvolatile configuration registers
+
+/** @defgroup EMXXLX_SIM_Flags EMXXLX SIM Flags
+  * @{
+  */
+#define EMXXLX_SIM_FLAG_READY					0x80U // Flag status register, no write or erase ongoing
+#define EMXXLX_SIM_FLAG_ERASE_ERROR				0x20U // Flag status register, erase of a protected area
+#define EMXXLX_SIM_FLAG_PROGRAM_ERROR			0x10U // Flag status register, write of a protected area
+#define EMXXLX_SIM_FLAG_PROTECTION				0x02U // Flag status register, protected area accessed
+#define EMXXLX_SIM_STATUS_BP					0x7CU // Status register block protect bits
+/**
+  * @}
+  */
+
+typedef struct
+{
+  uint32_t KernelClockHz;						/*!< OCTOSPI kernel clock, divided by the prescaler */
+
+  uint32_t ReadLatencyNs;						/*!< Device access time, the dummy cycles of a memory read must cover it */
+
+  uint32_t DataDelayPs;							/*!< Clock, or DQS, to data output delay of a read, with DataSkewPs only */
+
+  uint32_t DataSkewPs;							/*!< Unstable part of each read data bit, 0 for an ideal bus */
+
+  uint32_t WriteNs;								/*!< Internal time of a memory write, once the chip select is released */
+
+  uint32_t NvolWriteNs;							/*!< Internal time of a nonvolatile register write */
+
+  uint32_t Erase4kNs;							/*!< Internal time of a 4kB erase */
+
+  uint32_t Erase32kNs;							/*!< Internal time of a 32kB erase */
+
+  uint32_t Erase64kNs;							/*!< Internal time of a 64kB erase */
+
+  uint32_t EraseChipUs;							/*!< Internal time of a chip erase, in us */
+
+  uint32_t DpdExitNs;							/*!< Deep power-down exit time, commands are ignored until then */
+
+  uint32_t HalCallNs;							/*!< CPU time of one HAL_OSPI call */
+
+  uint32_t HalByteNs;							/*!< CPU time per byte of a blocking transfer, moved by the CPU */
+
+  uint32_t TickNs;								/*!< CPU time of one HAL_GetTick call */
+
+  uint32_t DwtNs;								/*!< CPU time of one DWT cycle counter read */
+
+  uint32_t RegNs;								/*!< CPU time of one OCTOSPI register access, see EMXXLX_Sim_Registers */
+} EMXXLX_SIM_TimingTypeDef;
+
+typedef struct
+{
+  uint8_t Port;									/*!< OCTOSPI instance, 1 or 2 */
+
+  uint8_t Instruction;							/*!< Instruction opcode */
+
+  uint8_t Lines;								/*!< Lines of the instruction phase */
+
+  uint8_t Dtr;									/*!< Non zero when the instruction is sent at double transfer rate */
+
+  uint8_t Dies;									/*!< Devices answering, 2 in dual-quad mode */
+
+  uint8_t Write;								/*!< Non zero when the data phase is sent to the device */
+
+  uint8_t Ignored;								/*!< Non zero when no device accepted the command */
+
+  uint32_t Address;								/*!< Address phase value, as sent by the OCTOSPI */
+
+  uint32_t NbData;								/*!< Data phase length */
+
+  uint32_t Cycles;								/*!< Bus clock cycles, chip select high time included */
+
+  uint64_t StartPs;								/*!< Simulated time of the chip select assertion, in ps */
+
+  uint64_t BusPs;								/*!< Bus time of the command, in ps */
+} EMXXLX_SIM_OpTypeDef;
+
+typedef struct
+{
+  uint32_t Commands;							/*!< Commands sent, automatic polling reads included */
+
+  uint32_t Ignored;								/*!< Commands no device accepted */
+
+  uint32_t Errors;								/*!< Transfer errors and timeouts */
+
+  uint64_t BytesRead;							/*!< Data phase bytes received */
+
+  uint64_t BytesWritten;						/*!< Data phase bytes sent */
+
+  uint64_t BusPs;								/*!< Cumulative bus time in ps */
+} EMXXLX_SIM_StatsTypeDef;
+
+typedef struct
+{
+  uint8_t Vol[EMXXLX_SIM_REGISTERS];			/*!< Volatile configuration registers */
+
+  uint8_t Nonvol[EMXXLX_SIM_REGISTERS];			/*!< Nonvolatile configuration registers */
+
+  uint8_t Status;								/*!< Status register, without the busy and WEL bits */
+
+  uint8_t Flags;								/*!< Error bits of the flag status register */
+
+  uint8_t Wel;									/*!< Write enable latch */
+
+  uint8_t Dpd;									/*!< Non zero in deep power-down */
+
+  uint8_t Busy;									/*!< Non zero while a write or erase is ongoing */
+} EMXXLX_SIM_RegsTypeDef;
+
+/**
+  * @brief Command observer, called once each command has been executed by
+  * 	   the devices.
+  */
+typedef void (*EMXXLX_SIM_ObserverTypeDef)(const EMXXLX_SIM_OpTypeDef *Op, void *Context);
+
+extern OSPI_HandleTypeDef hospi2;
+extern DMA_HandleTypeDef handle_GPDMA1_Channel1;
+
+/* Functions */
+void MX_OCTOSPI2_Init(void);
+
+void EMXXLX_Sim_Reset(void);
+void EMXXLX_Sim_PowerCycle(uint8_t Port);
+void EMXXLX_Sim_SetTiming(const EMXXLX_SIM_TimingTypeDef *Timing);
+void EMXXLX_Sim_GetTiming(EMXXLX_SIM_TimingTypeDef *Timing);
+void EMXXLX_Sim_SetObserver(EMXXLX_SIM_ObserverTypeDef Observer, void *Context);
+uint64_t EMXXLX_Sim_Now_ps(void);
+uint64_t EMXXLX_Sim_Now_ns(void);
+void EMXXLX_Sim_AutoIrq(uint8_t Enable);
+uint8_t EMXXLX_Sim_Pending(uint8_t Port);
+uint8_t EMXXLX_Sim_Step(void);
+void EMXXLX_Sim_Run(uint64_t Ns);
+void EMXXLX_Sim_Peek(uint8_t Port, uint8_t Die, uint32_t Address, uint8_t *pData, uint32_t Size);
+void EMXXLX_Sim_Poke(uint8_t Port, uint8_t Die, uint32_t Address, const uint8_t *pData, uint32_t Size);
+void EMXXLX_Sim_GetRegs(uint8_t Port, uint8_t Die, EMXXLX_SIM_RegsTypeDef *Regs);
+void EMXXLX_Sim_GetStats(uint8_t Port, EMXXLX_SIM_StatsTypeDef *Stats);
+void EMXXLX_Sim_ResetStats(void);
+uint8_t EMXXLX_Sim_Registers(uint8_t Port, uint8_t Enable);
+
+#endif /* INC_MRAM_SIM_H_ */
@@ -0,0 +1,81 @@
+/*
+ * mram_trace.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host decoder of the command trace recorded by the driver built with
+ *  EMXXLX_USE_TRACE. The input is a raw copy of EMXXLX_Trace, for example
+ *  dumped from SRAM4 with the debugger:
+ *
+ *    dump binary memory trace.bin &EMXXLX_Trace (char *)&EMXXLX_Trace + sizeof(EMXXLX_Trace)
+ *
+ *  The entries are put back in order, the wraps of the 32-bit DWT cycle
+ *  counter removed, and the commands summed per port and per opcode. The
+ *  bandwidth of a port is its data bytes over the time between its first
+ *  and its last command. build/emxxlx_trace prints the timeline and the
+ *  summary of a dump file.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef INC_MRAM_TRACE_H_
+#define INC_MRAM_TRACE_H_
+
+#define EMXXLX_TRACE_PORTS			2 // OCTOSPI instances
+
+typedef struct
+{
+  uint64_t Cycle;								/*!< DWT cycles since the oldest entry kept, counter wraps removed */
+
+  uint32_t Address;								/*!< Address phase value */
+
+  uint32_t NbData;								/*!< Data phase length */
+
+  uint8_t Instruction;							/*!< Instruction opcode */
+
+  uint8_t Port;									/*!< OCTOSPI instance, 1 or 2 */
+
+  uint16_t Mode;								/*!< Phase modes, see @ref EMXXLX_Trace_Mode */
+} EMXXLX_TRACE_EventTypeDef;
+
+typedef struct
+{
+  uint32_t Commands;							/*!< Commands issued on the port */
+
+  uint64_t BytesRead;							/*!< Data phase bytes of the read commands */
+
+  uint64_t BytesWritten;						/*!< Data phase bytes of the write commands */
+
+  uint64_t FirstCycle;							/*!< Cycle of the first command of the port */
+
+  uint64_t LastCycle;							/*!< Cycle of the last command of the port */
+} EMXXLX_TRACE_PortTypeDef;
+
+typedef struct
+{
+  uint32_t Logged;								/*!< Commands logged since the trace reset */
+
+  uint32_t Lost;								/*!< Oldest commands overwritten in the ring buffer */
+
+  uint32_t Count;								/*!< Entries decoded */
+
+  uint64_t Cycles;								/*!< Cycles between the oldest and the newest entry */
+
+  EMXXLX_TRACE_PortTypeDef Port[EMXXLX_TRACE_PORTS];	/*!< Indexed by port - 1 */
+
+  uint32_t OpCommands[256];						/*!< Commands per opcode */
+
+  uint64_t OpBytes[256];						/*!< Data phase bytes per opcode */
+} EMXXLX_TRACE_SummaryTypeDef;
+
+/* Functions */
+uint8_t EMXXLX_Trace_Decode(const void *pDump, size_t Size, EMXXLX_TRACE_EventTypeDef *pEvents,
+							uint32_t MaxEvents, EMXXLX_TRACE_SummaryTypeDef *Summary);
+uint8_t EMXXLX_Trace_IsWrite(uint8_t Instruction);
+const char *EMXXLX_Trace_Name(uint8_t Instruction);
+void EMXXLX_Trace_Print(FILE *Out, const EMXXLX_TRACE_EventTypeDef *pEvents,
+						const EMXXLX_TRACE_SummaryTypeDef *Summary, uint32_t CpuHz);
+
+#endif /* INC_MRAM_TRACE_H_ */
@@ -0,0 +1,1566 @@
+/*
+ * mram_sim.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Device model, simulated time and board of the EMxxLX host simulator:
+ *  OCTOSPI register pages, GPIO, tick, interrupt mask and DWT.
+ */
+
+#include "mram_sim_core.h"
+#include "mram.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define SIM_REGS_BASE				DLYB_OCTOSPI1_BASE_NS // First page of the delay blocks and OCTOSPI registers
+#define SIM_REGS_SIZE				0x4000UL // Up to the end of the OCTOSPI2 registers
+#define SIM_RCC_PAGE				(RCC_BASE_NS & ~0xFFFUL)
+
+/** @defgroup SIM_Source SIM Source
+  * @{
+  */
+#define SIM_SRC_IDLE							0x00U // Bus idle level, 0xFF
+#define SIM_SRC_MEM								0x01U // Memory array
+#define SIM_SRC_VOL								0x02U // Volatile configuration registers
+#define SIM_SRC_NONVOL							0x03U // Nonvolatile configuration registers
+#define SIM_SRC_VALUE							0x04U // Status or flag status register, repeated
+#define SIM_SRC_ID								0x05U // Manufacturer and device ID
+/**
+  * @}
+  */
+
+/** @defgroup SIM_Class SIM Class
+  * @{
+  */
+#define SIM_CLASS_OTHER							0x00U // Register or control command
+#define SIM_CLASS_READ							0x01U // Memory read
+#define SIM_CLASS_WRITE							0x02U // Memory write
+#define SIM_CLASS_ERASE							0x03U // Memory erase
+/**
+  * @}
+  */
+
+SIM_TypeDef Sim;
+CoreDebug_Type EMXXLX_Sim_CoreDebug;
+uint32_t SystemCoreClock = 160000000UL;
+
+OSPI_HandleTypeDef hospi1;
+OSPI_HandleTypeDef hospi2;
+DMA_HandleTypeDef handle_GPDMA1_Channel0;
+DMA_HandleTypeDef handle_GPDMA1_Channel1;
+
+static DWT_Type Sim_Dwt;
+static uint8_t *Sim_Storage;
+static uint8_t *Sim_Regs;
+
+static const uint8_t Sim_Id[] = { 0x6B, 0xBB, 0x1B };
+
+static const EMXXLX_SIM_TimingTypeDef Sim_Timing_Default = {
+	.KernelClockHz = 160000000UL,
+	.ReadLatencyNs = 60,
+	.WriteNs = 1000,
+	.NvolWriteNs = 50000,
+	.Erase4kNs = 40000,
+	.Erase32kNs = 320000,
+	.Erase64kNs = 640000,
+	.EraseChipUs = 1310000,
+	.DpdExitNs = 350000,
+	.HalCallNs = 300,
+	.HalByteNs = 60,
+	.TickNs = 100,
+	.DwtNs = 25,
+	.RegNs = 20,
+};
+
+static void Sim_Alarm(int Signal);
+static void Sim_Die_Reset(SIM_DieTypeDef *Die);
+static void Sim_Die_Factory(SIM_DieTypeDef *Die);
+
+/**
+ *  @brief Map the OCTOSPI and RCC registers at their STM32U575 addresses and
+ * 		   reserve the memory arrays, before main.
+ */
+__attribute__((constructor)) static void Sim_Setup(void)
+{
+	struct sigaction action = { 0 };
+	struct itimerval timer = { 0 };
+	int fd = memfd_create("emxxlx-ospi", 0);
+	void *rcc;
+
+	if ((fd < 0) || (ftruncate(fd, SIM_REGS_SIZE) != 0))
+	{
+		perror("emxxlx sim: registers");
+		abort();
+	}
+
+	/* The driver sees the fixed mapping, the model writes through the alias */
+	if ((mmap((void *)SIM_REGS_BASE, SIM_REGS_SIZE, PROT_READ | PROT_WRITE,
+			  MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0) != (void *)SIM_REGS_BASE)
+		|| ((Sim_Regs = mmap(NULL, SIM_REGS_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED))
+	{
+		perror("emxxlx sim: register mapping");
+		abort();
+	}
+	close(fd);
+
+	rcc = mmap((void *)SIM_RCC_PAGE, 0x1000, PROT_READ | PROT_WRITE,
+			   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	Sim_Storage = mmap(NULL, (size_t)EMXXLX_SIM_PORTS * EMXXLX_SIM_DIES * EMXXLX_SIM_SIZE,
+					   PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if ((rcc != (void *)SIM_RCC_PAGE) || (Sim_Storage == MAP_FAILED))
+	{
+		perror("emxxlx sim: mapping");
+		abort();
+	}
+
+	EMXXLX_Sim_Reset();
+
+	/* Interrupts of a program spinning without any simulator call */
+	action.sa_handler = Sim_Alarm;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGALRM, &action, NULL);
+	timer.it_interval.tv_usec = 1000;
+	timer.it_value.tv_usec = 1000;
+	setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+/**
+ *  @brief Simulator port of an OCTOSPI handle.
+ * 	@param hospi			OCTOSPI handle.
+ *  @retval Port
+ */
+SIM_PortTypeDef *Sim_Port(OSPI_HandleTypeDef *hospi)
+{
+	if (hospi->Instance == OCTOSPI2)
+	{
+		return &Sim.Port[1];
+	}
+
+	if (hospi->Instance != OCTOSPI1)
+	{
+		fprintf(stderr, "emxxlx sim: unknown OCTOSPI instance %p\n", (void *)hospi->Instance);
+		abort();
+	}
+
+	return &Sim.Port[0];
+}
+
+/**
+ *  @brief Bus clock period of a port.
+ * 	@param Port				Simulator port.
+ *  @retval Period in ps
+ */
+uint64_t Sim_Clock_Ps(SIM_PortTypeDef *Port)
+{
+	uint64_t prescaler = (Port->Regs->DCR2 & OCTOSPI_DCR2_PRESCALER) + 1U;
+
+	return (prescaler * 1000000000000ULL) / Sim.Timing.KernelClockHz;
+}
+
+/**
+ *  @brief Lines of a phase mode field.
+ */
+static uint8_t Sim_Lines(uint32_t Mode)
+{
+	static const uint8_t lines[8] = { 0, 1, 2, 4, 8, 0, 0, 0 };
+
+	return lines[Mode & 0x7U];
+}
+
+/**
+ *  @brief Decode the command programmed in the OCTOSPI registers, as the
+ * 		   controller sends it.
+ * 	@param Port				Simulator port.
+ *  @param Cmd				Decoded command.
+ */
+void Sim_Decode(SIM_PortTypeDef *Port, SIM_CmdTypeDef *Cmd)
+{
+	OCTOSPI_TypeDef *regs = Port->Regs;
+	uint32_t ccr = regs->CCR;
+	uint64_t tclk = Sim_Clock_Ps(Port);
+
+	memset(Cmd, 0, sizeof(*Cmd));
+	Cmd->ILines = Sim_Lines(ccr >> OCTOSPI_CCR_IMODE_Pos);
+	Cmd->IDtr = (ccr & OCTOSPI_CCR_IDTR) != 0U;
+	Cmd->IBytes = ((ccr & OCTOSPI_CCR_ISIZE) >> OCTOSPI_CCR_ISIZE_Pos) + 1U;
+	Cmd->Instruction = (uint8_t)regs->IR;
+	Cmd->ALines = Sim_Lines(ccr >> OCTOSPI_CCR_ADMODE_Pos);
+	Cmd->ADtr = (ccr & OCTOSPI_CCR_ADDTR) != 0U;
+	Cmd->ABytes = ((ccr & OCTOSPI_CCR_ADSIZE) >> OCTOSPI_CCR_ADSIZE_Pos) + 1U;
+	Cmd->Address = (Cmd->ALines != 0U) ? regs->AR : 0U;
+	Cmd->BLines = Sim_Lines(ccr >> OCTOSPI_CCR_ABMODE_Pos);
+	Cmd->BDtr = (ccr & OCTOSPI_CCR_ABDTR) != 0U;
+	Cmd->BBytes = ((ccr & OCTOSPI_CCR_ABSIZE) >> OCTOSPI_CCR_ABSIZE_Pos) + 1U;
+	Cmd->DLines = Sim_Lines(ccr >> OCTOSPI_CCR_DMODE_Pos);
+	Cmd->DDtr = (ccr & OCTOSPI_CCR_DDTR) != 0U;
+	Cmd->NbData = (Cmd->DLines != 0U) ? regs->DLR + 1U : 0U;
+	Cmd->Dqs = (ccr & OCTOSPI_CCR_DQSE) != 0U;
+	Cmd->Dcyc = regs->TCR & OCTOSPI_TCR_DCYC;
+	Cmd->Dies = ((regs->CR & OCTOSPI_CR_DMM) != 0U) ? 2U : 1U;
+	Cmd->Write = (regs->CR & OCTOSPI_CR_FMODE) == 0U;
+	if (Cmd->ILines == 0U)
+	{
+		Cmd->IBytes = 0;
+	}
+
+	/* Read sampling point, see EMXXLX_SIM_TimingTypeDef.DataSkewPs */
+	if ((regs->DCR1 & OCTOSPI_DCR1_DLYBYP) == 0U)
+	{
+		Cmd->SamplePs = Port->PhaseSel * (Port->Units + 1U) * SIM_DLYB_CELL_PS;
+	}
+	Cmd->SamplePs += (uint32_t)(tclk / (Cmd->DDtr ? 4U : 2U));
+	if (!Cmd->Dqs)
+	{
+		Cmd->SamplePs += ((regs->TCR & OCTOSPI_TCR_SSHIFT) != 0U) ? (uint32_t)(tclk / 2U) : 0U;
+		Cmd->SamplePs += ((regs->TCR & OCTOSPI_TCR_DHQC) != 0U) ? (uint32_t)(tclk / 4U) : 0U;
+	}
+}
+
+/**
+ *  @brief Clock cycles of one command phase.
+ */
+static uint32_t Sim_Phase_Cycles(uint32_t Bits, uint8_t Lines, uint8_t Dtr, uint8_t Dies)
+{
+	uint32_t width = (uint32_t)Lines * Dies * (Dtr ? 2U : 1U);
+
+	return (Lines == 0U) ? 0U : (Bits + width - 1U) / width;
+}
+
+/**
+ *  @brief Bus clock cycles of a command, chip select high time included.
+ * 	@param Port				Simulator port.
+ *  @param Cmd				Command.
+ *  @param NbData			Amount of bytes of the data phase.
+ *  @retval Clock cycles
+ */
+uint32_t Sim_Cycles(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd, uint32_t NbData)
+{
+	uint32_t cycles = ((Port->Regs->DCR1 & OCTOSPI_DCR1_CSHT) >> OCTOSPI_DCR1_CSHT_Pos) + 1U;
+
+	cycles += Sim_Phase_Cycles(8U * Cmd->IBytes, Cmd->ILines, Cmd->IDtr, 1);
+	cycles += Sim_Phase_Cycles(8U * Cmd->ABytes, Cmd->ALines, Cmd->ADtr, 1);
+	cycles += Sim_Phase_Cycles(8U * Cmd->BBytes, Cmd->BLines, Cmd->BDtr, 1);
+	cycles += Cmd->Dcyc;
+	cycles += Sim_Phase_Cycles(8U * NbData, Cmd->DLines, Cmd->DDtr, Cmd->Dies);
+
+	return cycles;
+}
+
+/**
+ *  @brief Check a command against the controller constraints.
+ * 	@param Port				Simulator port.
+ *  @param Cmd				Command.
+ *  @retval HAL_OSPI_ERROR_NONE or HAL_OSPI_ERROR_TRANSFER
+ */
+uint8_t Sim_Check(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd)
+{
+	uint64_t size = 2ULL << ((Port->Regs->DCR1 & OCTOSPI_DCR1_DEVSIZE) >> OCTOSPI_DCR1_DEVSIZE_Pos);
+
+	/* Dual-quad mode and octal DTR move pairs of bytes */
+	if ((Cmd->DLines != 0U) && (Cmd->NbData & 1U)
+		&& ((Cmd->Dies == 2U) || ((Cmd->DLines == 8U) && Cmd->DDtr)))
+	{
+		return HAL_OSPI_ERROR_TRANSFER;
+	}
+
+	if ((Cmd->ALines != 0U) && ((uint64_t)Cmd->Address + Cmd->NbData > size))
+	{
+		return HAL_OSPI_ERROR_TRANSFER;
+	}
+
+	return HAL_OSPI_ERROR_NONE;
+}
+
+/**
+ *  @brief Lines and transfer rate of the interface mode of a device.
+ */
+static uint8_t Sim_Protocol(const SIM_DieTypeDef *Die, uint8_t *Dtr)
+{
+	*Dtr = 0;
+	switch (Die->Vol[0] | MRAM_INTERFACE_DS)
+	{
+	case MRAM_DSPI_W_DS:
+		return 2;
+
+	case MRAM_QSPI_W_DS:
+		return 4;
+
+	case MRAM_QDTR_W_DS:
+		*Dtr = 1;
+		return 4;
+
+	case MRAM_ODTR_W_DS:
+		*Dtr = 1;
+		return 8;
+
+	case MRAM_OSPI_W_DS:
+		return 8;
+
+	default:
+		return 1;
+	}
+}
+
+/**
+ *  @brief Class of an instruction, a value of @ref SIM_Class.
+ */
+static uint8_t Sim_Class(uint8_t Instruction)
+{
+	switch (Instruction)
+	{
+	case MRAM_READ_CMD:
+	case MRAM_READ_FAST_CMD:
+	case MRAM_READ_DUAL_O_CMD:
+	case MRAM_READ_DUAL_IO_CMD:
+	case MRAM_READ_QUAD_O_CMD:
+	case MRAM_READ_QUAD_IO_CMD:
+	case MRAM_READ_OCTO_O_CMD:
+	case MRAM_READ_OCTO_IO_CMD:
+	case MRAM_READ_DTR_CMD:
+	case MRAM_READ_DTR_DUAL_O_CMD:
+	case MRAM_READ_DTR_DUAL_IO_CMD:
+	case MRAM_READ_DTR_QUAD_O_CMD:
+	case MRAM_READ_DTR_QUAD_IO_CMD:
+	case MRAM_READ_WORD_QUAD_IO_CMD:
+	case MRAM_READ_DTR_OCTO_O_CMD:
+	case MRAM_READ_DTR_OCTO_IO_CMD:
+	case MRAM_4BADD_READ_CMD:
+	case MRAM_4BADD_READ_FAST_CMD:
+	case MRAM_4BADD_READ_DUAL_O_CMD:
+	case MRAM_4BADD_READ_DUAL_IO_CMD:
+	case MRAM_4BADD_READ_QUAD_O_CMD:
+	case MRAM_4BADD_READ_QUAD_IO_CMD:
+	case MRAM_4BADD_READ_OCTO_O_CMD:
+	case MRAM_4BADD_READ_OCTO_IO_CMD:
+	case MRAM_4BADD_READ_DTR_CMD:
+	case MRAM_4BADD_READ_DTR_DUAL_IO_CMD:
+	case MRAM_4BADD_READ_DTR_QUAD_IO_CMD:
+		return SIM_CLASS_READ;
+
+	case MRAM_WRITE_CMD:
+	case MRAM_WRITE_DUAL_CMD:
+	case MRAM_WRITE_DUAL_E_CMD:
+	case MRAM_WRITE_QUAD_CMD:
+	case MRAM_WRITE_QUAD_E_CMD:
+	case MRAM_WRITE_OCTO_CMD:
+	case MRAM_WRITE_OCTO_E_CMD:
+	case MRAM_4BADD_WRITE_CMD:
+	case MRAM_4BADD_WRITE_QUAD_CMD:
+	case MRAM_4BADD_WRITE_QUAD_E_CMD:
+	case MRAM_4BADD_WRITE_OCTO_CMD:
+	case MRAM_4BADD_WRITE_OCTO_E_CMD:
+		return SIM_CLASS_WRITE;
+
+	case MRAM_ERASE_4kB_SECTOR_CMD:
+	case MRAM_ERASE_32kB_SECTOR_CMD:
+	case MRAM_ERASE_SECTOR_CMD:
+	case MRAM_ERASE_BULK_CMD:
+	case MRAM_ERASE_CHIP_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_4kB_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_32kB_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_CMD:
+		return SIM_CLASS_ERASE;
+
+	default:
+		return SIM_CLASS_OTHER;
+	}
+}
+
+/**
+ *  @brief Non zero for the instructions which always take a 4-byte address.
+ */
+static uint8_t Sim_4Byte(uint8_t Instruction)
+{
+	switch (Instruction)
+	{
+	case MRAM_4BADD_READ_CMD:
+	case MRAM_4BADD_READ_FAST_CMD:
+	case MRAM_4BADD_READ_DUAL_O_CMD:
+	case MRAM_4BADD_READ_DUAL_IO_CMD:
+	case MRAM_4BADD_READ_QUAD_O_CMD:
+	case MRAM_4BADD_READ_QUAD_IO_CMD:
+	case MRAM_4BADD_READ_OCTO_O_CMD:
+	case MRAM_4BADD_READ_OCTO_IO_CMD:
+	case MRAM_4BADD_READ_DTR_CMD:
+	case MRAM_4BADD_READ_DTR_DUAL_IO_CMD:
+	case MRAM_4BADD_READ_DTR_QUAD_IO_CMD:
+	case MRAM_4BADD_WRITE_CMD:
+	case MRAM_4BADD_WRITE_QUAD_CMD:
+	case MRAM_4BADD_WRITE_QUAD_E_CMD:
+	case MRAM_4BADD_WRITE_OCTO_CMD:
+	case MRAM_4BADD_WRITE_OCTO_E_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_4kB_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_32kB_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_CMD:
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+/**
+ *  @brief Check whether a device takes a command: instruction sent with
+ * 		   the lines and transfer rate of its interface mode, address size,
+ * 		   deep power-down and ongoing write or erase.
+ */
+static uint8_t Sim_Accept(const SIM_DieTypeDef *Die, const SIM_CmdTypeDef *Cmd, uint64_t Start)
+{
+	uint8_t dtr;
+	uint8_t lines = Sim_Protocol(Die, &dtr);
+	uint8_t bytes;
+
+	if ((Cmd->ILines != lines) || (Cmd->IDtr != dtr) || (Cmd->IBytes != 1U))
+	{
+		return 0;
+	}
+
+	if (Die->Dpd != 0U)
+	{
+		return Cmd->Instruction == MRAM_DPD_EXIT_CMD;
+	}
+
+	if (Start < Die->ReadyAt)
+	{
+		return 0;
+	}
+
+	if ((Start < Die->BusyUntil) && (Cmd->Instruction != MRAM_READ_STATUS_REG_CMD)
+		&& (Cmd->Instruction != MRAM_READ_FLAGS_CMD))
+	{
+		return 0;
+	}
+
+	if (Cmd->ALines != 0U)
+	{
+		bytes = (Sim_4Byte(Cmd->Instruction) || (Die->Vol[5] != 0xFFU)) ? 4U : 3U;
+		if (Cmd->ABytes != bytes)
+		{
+			return 0;
+		}
+	}
+
+	/* The single line mode has the dual and quad commands, the others are strict */
+	if ((lines != 1U) && (((Cmd->ALines != 0U) && ((Cmd->ALines != lines) || (Cmd->ADtr != dtr)))
+						  || ((Cmd->BLines != 0U) && ((Cmd->BLines != lines) || (Cmd->BDtr != dtr)))
+						  || ((Cmd->DLines != 0U) && ((Cmd->DLines != lines) || (Cmd->DDtr != dtr)))))
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ *  @brief Byte of the memory array of a device.
+ */
+static uint8_t Sim_Mem_Byte(const SIM_DieTypeDef *Die, uint32_t Address)
+{
+	uint32_t page = Address >> SIM_PAGE_BITS;
+
+	return Die->Valid[page] ? Die->Mem[Address] : Die->Fill[page];
+}
+
+/**
+ *  @brief Copy bytes of the memory array of a device.
+ */
+static void Sim_Mem_Read(const SIM_DieTypeDef *Die, uint32_t Address, uint8_t *pData, uint32_t Stride,
+						 uint32_t Size)
+{
+	while (Size != 0U)
+	{
+		uint32_t page = Address >> SIM_PAGE_BITS;
+		uint32_t chunk = (1UL << SIM_PAGE_BITS) - (Address & ((1UL << SIM_PAGE_BITS) - 1U));
+
+		chunk = (chunk < Size) ? chunk : Size;
+		if (Stride == 1U)
+		{
+			if (Die->Valid[page])
+			{
+				memcpy(pData, &Die->Mem[Address], chunk);
+			}
+			else
+			{
+				memset(pData, Die->Fill[page], chunk);
+			}
+		}
+		else
+		{
+			for (uint32_t i = 0; i < chunk; i++)
+			{
+				pData[i * Stride] = Die->Valid[page] ? Die->Mem[Address + i] : Die->Fill[page];
+			}
+		}
+
+		pData += chunk * Stride;
+		Address = (Address + chunk) & (EMXXLX_SIM_SIZE - 1U);
+		Size -= chunk;
+	}
+}
+
+/**
+ *  @brief Write bytes to the memory array of a device.
+ */
+static void Sim_Mem_Write(SIM_DieTypeDef *Die, uint32_t Address, const uint8_t *pData, uint32_t Stride,
+						  uint32_t Size)
+{
+	while (Size != 0U)
+	{
+		uint32_t page = Address >> SIM_PAGE_BITS;
+		uint32_t chunk = (1UL << SIM_PAGE_BITS) - (Address & ((1UL << SIM_PAGE_BITS) - 1U));
+
+		chunk = (chunk < Size) ? chunk : Size;
+		if (Die->Valid[page] == 0U)
+		{
+			memset(&Die->Mem[page << SIM_PAGE_BITS], Die->Fill[page], 1UL << SIM_PAGE_BITS);
+			Die->Valid[page] = 1;
+		}
+
+		for (uint32_t i = 0; i < chunk; i++)
+		{
+			Die->Mem[Address + i] = pData[i * Stride];
+		}
+
+		pData += chunk * Stride;
+		Address = (Address + chunk) & (EMXXLX_SIM_SIZE - 1U);
+		Size -= chunk;
+	}
+}
+
+/**
+ *  @brief Erase a range of the memory array of a device, the size is a
+ * 		   multiple of the page.
+ */
+static void Sim_Mem_Erase(SIM_DieTypeDef *Die, uint32_t Address, uint32_t Size, uint8_t Value)
+{
+	uint32_t first = Address >> SIM_PAGE_BITS;
+	uint32_t count = Size >> SIM_PAGE_BITS;
+
+	memset(&Die->Valid[first], 0, count);
+	memset(&Die->Fill[first], Value, count);
+	if (Size == EMXXLX_SIM_SIZE)
+	{
+		madvise(Die->Mem, EMXXLX_SIM_SIZE, MADV_DONTNEED);
+	}
+}
+
+/**
+ *  @brief Data phase byte k of a read, before the bus shift.
+ */
+static uint8_t Sim_Source_Byte(const SIM_DieTypeDef *Die, uint8_t Source, uint32_t Address, uint32_t Wrap,
+							   uint8_t Value, int64_t k)
+{
+	uint32_t offset;
+
+	if (k < 0)
+	{
+		return 0xFF;
+	}
+
+	switch (Source)
+	{
+	case SIM_SRC_MEM:
+		if (Wrap != 0U)
+		{
+			offset = (uint32_t)(((Address & (Wrap - 1U)) + (uint64_t)k) & (Wrap - 1U));
+			return Sim_Mem_Byte(Die, (Address & ~(Wrap - 1U)) + offset);
+		}
+		return Sim_Mem_Byte(Die, (uint32_t)((Address + (uint64_t)k) & (EMXXLX_SIM_SIZE - 1U)));
+
+	case SIM_SRC_VOL:
+		return ((uint64_t)Address + k < EMXXLX_SIM_REGISTERS) ? Die->Vol[Address + k] : 0xFF;
+
+	case SIM_SRC_NONVOL:
+		return ((uint64_t)Address + k < EMXXLX_SIM_REGISTERS) ? Die->Nonvol[Address + k] : 0xFF;
+
+	case SIM_SRC_VALUE:
+		return Value;
+
+	case SIM_SRC_ID:
+		return (k < (int64_t)sizeof(Sim_Id)) ? Sim_Id[k] : 0xFF;
+
+	default:
+		return 0xFF;
+	}
+}
+
+/**
+ *  @brief Send the data phase of a read from one device. The device drives
+ * 		   the data after its latency, the controller samples after its
+ * 		   dummy cycles: a difference shifts the bytes on the bus.
+ */
+static void Sim_Die_Read(SIM_DieTypeDef *Die, const SIM_CmdTypeDef *Cmd, uint32_t Address, uint8_t *pData,
+						 uint32_t Stride, uint32_t Count, uint64_t Start, uint64_t Tclk)
+{
+	uint8_t source = SIM_SRC_IDLE;
+	uint8_t value = 0xFF;
+	uint32_t wrap = 0;
+	int32_t latency = 0;
+	int64_t shift;
+	uint8_t busy = Start < Die->BusyUntil;
+	uint8_t garbled = 0;
+	uint8_t dtr;
+
+	switch (Cmd->Instruction)
+	{
+	case MRAM_READ_STATUS_REG_CMD:
+		source = SIM_SRC_VALUE;
+		value = Die->Status | (Die->Wel << 1) | busy;
+		break;
+
+	case MRAM_READ_FLAGS_CMD:
+		source = SIM_SRC_VALUE;
+		value = Die->Flags | (busy ? 0U : EMXXLX_SIM_FLAG_READY);
+		break;
+
+	case MRAM_READ_VOL_CMD:
+		source = SIM_SRC_VOL;
+		break;
+
+	case MRAM_READ_NONVOL_CMD:
+		source = SIM_SRC_NONVOL;
+		break;
+
+	case MRAM_READ_ID_CMD:
+	case MRAM_READ_ID_MULTIPLE_IO_CMD:
+		source = SIM_SRC_ID;
+		break;
+
+	default:
+		if (Sim_Class(Cmd->Instruction) == SIM_CLASS_READ)
+		{
+			source = SIM_SRC_MEM;
+			Address &= EMXXLX_SIM_SIZE - 1U;
+			wrap = (Die->Vol[7] == 0xFEU) ? 64U : (Die->Vol[7] == 0xFDU) ? 32U : (Die->Vol[7] == 0xFCU) ? 16U : 0U;
+
+			/* The latency of volatile register 1, at least the access time */
+			latency = ((Die->Vol[1] >= 1U) && (Die->Vol[1] <= 31U)) ? Die->Vol[1] : MRAM_DEFAULT_DC;
+			if ((Cmd->Instruction != MRAM_READ_CMD) && (Cmd->Instruction != MRAM_4BADD_READ_CMD))
+			{
+				int32_t access = (int32_t)((Sim.Timing.ReadLatencyNs * SIM_PS_PER_NS + Tclk - 1U) / Tclk);
+
+				latency = (access > latency) ? access : latency;
+			}
+			else
+			{
+				latency = 0;
+			}
+		}
+		break;
+	}
+
+	if ((source != SIM_SRC_MEM) && (source != SIM_SRC_IDLE) && (Sim_Protocol(Die, &dtr) == 8U))
+	{
+		latency = MRAM_8_DC;
+	}
+
+	/* Sampling on DQS needs the device to drive it */
+	if (Cmd->Dqs && ((Die->Vol[0] & MRAM_INTERFACE_DS) == 0U))
+	{
+		source = SIM_SRC_IDLE;
+	}
+
+	/* Alternate bytes take the place of latency cycles */
+	latency -= (int32_t)(Cmd->Dcyc + Sim_Phase_Cycles(8U * Cmd->BBytes, Cmd->BLines, Cmd->BDtr, 1));
+	shift = (int64_t)latency * Cmd->DLines * (Cmd->DDtr ? 2 : 1);
+
+	/* A sample in the unstable part of a bit is garbage, a sample one bit
+	   period away takes the neighbour bits */
+	if ((Sim.Timing.DataSkewPs != 0U) && (source != SIM_SRC_IDLE))
+	{
+		int64_t tbit = (int64_t)(Cmd->DDtr ? Tclk / 2U : Tclk);
+		int64_t p = (int64_t)Cmd->SamplePs - Sim.Timing.DataDelayPs - Sim.Timing.DataSkewPs;
+		int64_t slip;
+
+		if (Cmd->Dqs)
+		{
+			p += (Die->Vol[4] <= MRAM_0_ADDED_DELAY) ? (MRAM_0_ADDED_DELAY - Die->Vol[4]) * 100 : 0;
+		}
+		slip = (p >= 0) ? p / tbit : -((tbit - 1 - p) / tbit);
+		shift -= slip * Cmd->DLines;
+		garbled = (p - slip * tbit) >= (tbit - (int64_t)Sim.Timing.DataSkewPs);
+	}
+
+	if ((shift == 0) && (source == SIM_SRC_MEM) && (wrap == 0U) && !garbled)
+	{
+		Sim_Mem_Read(Die, Address, pData, Stride, Count);
+		return;
+	}
+
+	for (uint32_t i = 0; i < Count; i++)
+	{
+		int64_t t = 8 * (int64_t)i - shift;
+		int64_t q = (t >= 0) ? t / 8 : -((7 - t) / 8);
+		uint32_t r = (uint32_t)(t - 8 * q);
+		uint8_t byte = Sim_Source_Byte(Die, source, Address, wrap, value, q);
+
+		if (r != 0U)
+		{
+			byte = (uint8_t)((byte << r) | (Sim_Source_Byte(Die, source, Address, wrap, value, q + 1) >> (8U - r)));
+		}
+		pData[i * Stride] = garbled ? (uint8_t)~byte : byte;
+	}
+}
+
+/**
+ *  @brief Execute a command accepted by one device.
+ */
+static void Sim_Die_Execute(SIM_DieTypeDef *Die, const SIM_CmdTypeDef *Cmd, uint32_t Address, uint8_t *pData,
+							uint32_t Stride, uint32_t Count, uint64_t Start, uint64_t End, uint64_t Tclk)
+{
+	uint8_t protect = (Die->Status & EMXXLX_SIM_STATUS_BP) != 0U;
+	uint8_t erased = ((Die->Vol[8] & 0x80U) != 0U) ? 0xFFU : 0x00U;
+	uint32_t size = 0;
+	uint64_t ns = 0;
+
+	switch (Cmd->Instruction)
+	{
+	case MRAM_WRITE_ENABLE_CMD:
+		Die->Wel = 1;
+		return;
+
+	case MRAM_WRITE_DISABLE_CMD:
+		Die->Wel = 0;
+		return;
+
+	case MRAM_CLR_FLAGS_CMD:
+		Die->Flags = 0;
+		return;
+
+	case MRAM_RESET_CMD:
+		Sim_Die_Reset(Die);
+		return;
+
+	case MRAM_DPD_ENTER_CMD:
+		Die->Dpd = 1;
+		return;
+
+	case MRAM_DPD_EXIT_CMD:
+		Die->Dpd = 0;
+		Die->ReadyAt = End + Sim.Timing.DpdExitNs * SIM_PS_PER_NS;
+		return;
+
+	case MRAM_4BADD_ENTER_CMD:
+		Die->Vol[5] = 0xFE;
+		return;
+
+	case MRAM_4BADD_EXIT_CMD:
+		Die->Vol[5] = 0xFF;
+		return;
+
+	case MRAM_WRITE_STATUS_CMD:
+		if (Cmd->Write && (Count != 0U) && Die->Wel)
+		{
+			Die->Status = pData[0] & 0xFCU;
+		}
+		return;
+
+	case MRAM_WRITE_VOL_CMD:
+	case MRAM_WRITE_NONVOL_CMD:
+		if (!Cmd->Write || !Die->Wel)
+		{
+			return;
+		}
+
+		/* Bytes beyond the configuration registers are dropped, the DFU register among them */
+		for (uint32_t k = 0; (k < Count) && ((uint64_t)Address + k < EMXXLX_SIM_REGISTERS); k++)
+		{
+			if (Cmd->Instruction == MRAM_WRITE_VOL_CMD)
+			{
+				Die->Vol[Address + k] = pData[k * Stride];
+			}
+			else
+			{
+				Die->Nonvol[Address + k] = pData[k * Stride];
+			}
+		}
+
+		if (Cmd->Instruction == MRAM_WRITE_NONVOL_CMD)
+		{
+			Die->BusyUntil = End + Sim.Timing.NvolWriteNs * SIM_PS_PER_NS;
+		}
+		return;
+
+	default:
+		break;
+	}
+
+	switch (Sim_Class(Cmd->Instruction))
+	{
+	case SIM_CLASS_WRITE:
+		if (!Cmd->Write || !Die->Wel)
+		{
+			return;
+		}
+
+		Die->Wel = 0;
+		if (protect)
+		{
+			Die->Flags |= EMXXLX_SIM_FLAG_PROGRAM_ERROR | EMXXLX_SIM_FLAG_PROTECTION;
+			return;
+		}
+
+		Sim_Mem_Write(Die, Address & (EMXXLX_SIM_SIZE - 1U), pData, Stride, Count);
+		Die->BusyUntil = End + Sim.Timing.WriteNs * SIM_PS_PER_NS;
+		return;
+
+	case SIM_CLASS_ERASE:
+		if (!Die->Wel)
+		{
+			return;
+		}
+
+		Die->Wel = 0;
+		if (protect)
+		{
+			Die->Flags |= EMXXLX_SIM_FLAG_ERASE_ERROR | EMXXLX_SIM_FLAG_PROTECTION;
+			return;
+		}
+
+		switch (Cmd->Instruction)
+		{
+		case MRAM_ERASE_4kB_SECTOR_CMD:
+		case MRAM_4BADD_ERASE_SECTOR_4kB_CMD:
+			size = EMXXLX_ERASE_4KB;
+			ns = Sim.Timing.Erase4kNs;
+			break;
+
+		case MRAM_ERASE_32kB_SECTOR_CMD:
+		case MRAM_4BADD_ERASE_SECTOR_32kB_CMD:
+			size = EMXXLX_ERASE_32KB;
+			ns = Sim.Timing.Erase32kNs;
+			break;
+
+		case MRAM_ERASE_SECTOR_CMD:
+		case MRAM_4BADD_ERASE_SECTOR_CMD:
+			size = EMXXLX_ERASE_64KB;
+			ns = Sim.Timing.Erase64kNs;
+			break;
+
+		default:
+			size = EMXXLX_SIM_SIZE;
+			ns = (uint64_t)Sim.Timing.EraseChipUs * 1000U;
+			break;
+		}
+
+		Sim_Mem_Erase(Die, Address & (EMXXLX_SIM_SIZE - 1U) & ~(size - 1U), size, erased);
+		Die->BusyUntil = End + ns * SIM_PS_PER_NS;
+		return;
+
+	default:
+		if (!Cmd->Write && (Count != 0U))
+		{
+			Sim_Die_Read(Die, Cmd, Address, pData, Stride, Count, Start, Tclk);
+		}
+		return;
+	}
+}
+
+/**
+ *  @brief Send a command to the devices of a port and account for it.
+ * 	@param Port				Simulator port.
+ *  @param Cmd				Command.
+ *  @param pData			Data phase buffer, NULL without data phase.
+ *  @param NbData			Amount of bytes of the data phase actually sent.
+ *  @param Start			Chip select assertion, in ps.
+ */
+void Sim_Execute(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd, uint8_t *pData, uint32_t NbData,
+				 uint64_t Start)
+{
+	uint64_t tclk = Sim_Clock_Ps(Port);
+	EMXXLX_SIM_OpTypeDef op = { 0 };
+	uint32_t count = NbData / Cmd->Dies;
+	uint32_t address = Cmd->Address / Cmd->Dies;
+	uint8_t accepted = 0;
+
+	op.Port = (uint8_t)(Port - Sim.Port) + 1U;
+	op.Instruction = Cmd->Instruction;
+	op.Lines = Cmd->ILines;
+	op.Dtr = Cmd->IDtr;
+	op.Dies = Cmd->Dies;
+	op.Write = (Cmd->DLines != 0U) && Cmd->Write;
+	op.Address = Cmd->Address;
+	op.NbData = (Cmd->DLines != 0U) ? NbData : 0U;
+	op.Cycles = Sim_Cycles(Port, Cmd, op.NbData);
+	op.StartPs = Start;
+	op.BusPs = op.Cycles * tclk;
+
+	for (uint32_t d = 0; d < Cmd->Dies; d++)
+	{
+		SIM_DieTypeDef *die = &Port->Die[d];
+
+		if (Sim_Accept(die, Cmd, Start))
+		{
+			accepted++;
+			Sim_Die_Execute(die, Cmd, address, (pData != NULL) ? pData + d : NULL, Cmd->Dies,
+							(pData != NULL) ? count : 0U, Start, Start + op.BusPs, tclk);
+		}
+		else if ((pData != NULL) && !Cmd->Write)
+		{
+			for (uint32_t k = 0; k < count; k++)
+			{
+				pData[k * Cmd->Dies + d] = 0xFF;
+			}
+		}
+	}
+
+	op.Ignored = accepted == 0U;
+	Port->Stats.Commands++;
+	Port->Stats.Ignored += op.Ignored;
+	Port->Stats.BusPs += op.BusPs;
+	if (op.Write)
+	{
+		Port->Stats.BytesWritten += op.NbData;
+	}
+	else
+	{
+		Port->Stats.BytesRead += op.NbData;
+	}
+
+	if (Sim.Observer != NULL)
+	{
+		Sim.Observer(&op, Sim.Context);
+	}
+}
+
+/**
+ *  @brief Run an automatic polling: the devices are read every interval
+ * 		   until the first read once they are ready, which decides the
+ * 		   match.
+ * 	@param Port				Simulator port.
+ *  @param Cmd				Status read command.
+ *  @param Config			Automatic polling parameters.
+ *  @param Start			First read, in ps.
+ *  @retval Start of the matching read in ps, SIM_NEVER without match
+ */
+uint64_t Sim_Poll(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd, const OSPI_AutoPollingTypeDef *Config,
+				  uint64_t Start)
+{
+	uint64_t tclk = Sim_Clock_Ps(Port);
+	uint64_t bus = Sim_Cycles(Port, Cmd, Cmd->NbData) * tclk;
+	uint64_t period = bus + Config->Interval * tclk;
+	uint64_t ready = 0;
+	uint64_t polls = 0;
+	uint8_t status[4] = { 0 };
+	uint32_t value = 0;
+	uint32_t mismatch;
+
+	for (uint32_t d = 0; d < Cmd->Dies; d++)
+	{
+		ready = (Port->Die[d].BusyUntil > ready) ? Port->Die[d].BusyUntil : ready;
+		ready = (Port->Die[d].ReadyAt > ready) ? Port->Die[d].ReadyAt : ready;
+	}
+
+	/* The reads while the devices are busy do not match */
+	if (ready > Start)
+	{
+		polls = (ready - Start + period - 1U) / period;
+	}
+	Port->Stats.Commands += polls;
+	Port->Stats.BusPs += polls * bus;
+	Port->Stats.BytesRead += polls * Cmd->NbData;
+
+	Start += polls * period;
+	Sim_Execute(Port, Cmd, status, (Cmd->NbData < sizeof(status)) ? Cmd->NbData : sizeof(status), Start);
+	for (uint32_t i = 0; i < sizeof(status); i++)
+	{
+		value |= (uint32_t)status[i] << (8U * i);
+	}
+
+	mismatch = (value ^ Config->Match) & Config->Mask;
+	if ((Config->MatchMode == HAL_OSPI_MATCH_MODE_AND) ? (mismatch == 0U) : (mismatch != Config->Mask))
+	{
+		return Start;
+	}
+
+	Port->Stats.Errors++;
+	return SIM_NEVER;
+}
+
+/**
+ *  @brief Register the pending interrupt of a port.
+ */
+void Sim_Schedule(SIM_PortTypeDef *Port, uint8_t Event, OSPI_HandleTypeDef *hospi, const SIM_CmdTypeDef *Cmd,
+				  uint8_t *pData, uint64_t Start, uint64_t Due)
+{
+	Port->Event = Event;
+	Port->hospi = hospi;
+	Port->Cmd = *Cmd;
+	Port->pData = pData;
+	Port->Start = Start;
+	Port->Due = Due;
+	Port->Regs->SR |= OCTOSPI_SR_BUSY;
+}
+
+/**
+ *  @brief Drop the pending interrupt of a port.
+ */
+void Sim_Cancel(SIM_PortTypeDef *Port)
+{
+	Port->Event = SIM_EVENT_NONE;
+	Port->Error = HAL_OSPI_ERROR_NONE;
+	Port->Regs->SR &= ~OCTOSPI_SR_BUSY;
+}
+
+/**
+ *  @brief Non zero when the interrupts can be taken.
+ */
+static uint8_t Sim_Deliverable(void)
+{
+	return Sim.AutoIrq && (Sim.Primask == 0U) && (Sim.InIrq == 0U);
+}
+
+/**
+ *  @brief Port of the earliest pending interrupt, NULL without any.
+ */
+static SIM_PortTypeDef *Sim_Next(void)
+{
+	SIM_PortTypeDef *next = NULL;
+
+	for (uint32_t p = 0; p < EMXXLX_SIM_PORTS; p++)
+	{
+		SIM_PortTypeDef *port = &Sim.Port[p];
+
+		if ((port->Event != SIM_EVENT_NONE) && (port->Due != SIM_NEVER)
+			&& ((next == NULL) || (port->Due < next->Due)))
+		{
+			next = port;
+		}
+	}
+
+	return next;
+}
+
+/**
+ *  @brief Move the simulated time forward, taking the interrupts falling
+ * 		   due on the way when they are not masked.
+ * 	@param Until			Target time, in ps.
+ */
+void Sim_Advance(uint64_t Until)
+{
+	SIM_PortTypeDef *next;
+
+	while (Sim_Deliverable() && ((next = Sim_Next()) != NULL) && (next->Due <= Until))
+	{
+		Sim.Now = (next->Due > Sim.Now) ? next->Due : Sim.Now;
+		Sim_Complete(next);
+	}
+
+	Sim.Now = (Until > Sim.Now) ? Until : Sim.Now;
+}
+
+/**
+ *  @brief Take the interrupts already due.
+ */
+void Sim_Deliver(void)
+{
+	Sim_Advance(Sim.Now);
+}
+
+/**
+ *  @brief Host timer: the program spins without any simulator call, the
+ * 		   time jumps to the next interrupt.
+ */
+static void Sim_Alarm(int Signal)
+{
+	SIM_PortTypeDef *next;
+
+	(void)Signal;
+	if ((Sim.Depth == 0) && (Sim.Calls == Sim.AlarmCalls) && Sim_Deliverable() && ((next = Sim_Next()) != NULL))
+	{
+		SIM_ENTER();
+		Sim_Advance(next->Due);
+		SIM_LEAVE();
+	}
+	Sim.AlarmCalls = Sim.Calls;
+}
+
+/**
+ *  @brief Volatile registers reloaded from the nonvolatile ones.
+ */
+static void Sim_Die_Reset(SIM_DieTypeDef *Die)
+{
+	memcpy(Die->Vol, Die->Nonvol, sizeof(Die->Vol));
+	Die->Wel = 0;
+	Die->Flags = 0;
+	Die->Dpd = 0;
+}
+
+/**
+ *  @brief Device as delivered: registers at 0xFF, unprotected and erased.
+ */
+static void Sim_Die_Factory(SIM_DieTypeDef *Die)
+{
+	uint8_t *mem = Die->Mem;
+
+	memset(Die, 0, sizeof(*Die));
+	Die->Mem = mem;
+	memset(Die->Vol, 0xFF, sizeof(Die->Vol));
+	memset(Die->Nonvol, 0xFF, sizeof(Die->Nonvol));
+	memset(Die->Fill, 0xFF, sizeof(Die->Fill));
+	madvise(Die->Mem, EMXXLX_SIM_SIZE, MADV_DONTNEED);
+}
+
+/**
+ *  @brief Start over: factory devices, registers and handles cleared, time
+ * 		   at 0, default timing, no observer and automatic interrupts.
+ */
+void EMXXLX_Sim_Reset(void)
+{
+	SIM_ENTER();
+	Sim_Registers_Reset();
+	memset(Sim_Regs, 0, SIM_REGS_SIZE);
+	memset((void *)SIM_RCC_PAGE, 0, 0x1000);
+	for (uint32_t p = 0; p < EMXXLX_SIM_PORTS; p++)
+	{
+		SIM_PortTypeDef *port = &Sim.Port[p];
+
+		memset(port, 0, sizeof(*port));
+		port->Regs = (OCTOSPI_TypeDef *)(Sim_Regs + (((p == 0U) ? OCTOSPI1_R_BASE_NS : OCTOSPI2_R_BASE_NS)
+				- SIM_REGS_BASE));
+		port->Dlyb = (DLYB_TypeDef *)(Sim_Regs + (((p == 0U) ? DLYB_OCTOSPI1_BASE_NS : DLYB_OCTOSPI2_BASE_NS)
+				- SIM_REGS_BASE));
+		for (uint32_t d = 0; d < EMXXLX_SIM_DIES; d++)
+		{
+			port->Die[d].Mem = Sim_Storage + (size_t)(p * EMXXLX_SIM_DIES + d) * EMXXLX_SIM_SIZE;
+			Sim_Die_Factory(&port->Die[d]);
+		}
+	}
+
+	memset(&hospi1, 0, sizeof(hospi1));
+	memset(&hospi2, 0, sizeof(hospi2));
+	memset(&handle_GPDMA1_Channel0, 0, sizeof(handle_GPDMA1_Channel0));
+	memset(&handle_GPDMA1_Channel1, 0, sizeof(handle_GPDMA1_Channel1));
+	memset(&Sim_Dwt, 0, sizeof(Sim_Dwt));
+	memset(&EMXXLX_Sim_CoreDebug, 0, sizeof(EMXXLX_Sim_CoreDebug));
+
+	Sim.Now = 0;
+	Sim.Timing = Sim_Timing_Default;
+	Sim.Observer = NULL;
+	Sim.Context = NULL;
+	Sim.AutoIrq = 1;
+	Sim.InIrq = 0;
+	Sim.Primask = 0;
+	Sim.TickSpins = 0;
+	Sim.DwtSpins = 0;
+	Sim.DwtBase = 0;
+	Sim.DwtLast = 0;
+	Sim.Ncs = 1;
+	Sim.Io0 = 0;
+	SIM_LEAVE();
+}
+
+/**
+ *  @brief Power cycle the devices of a port: volatile registers reloaded,
+ * 		   write or erase in progress completed.
+ * 	@param Port				OCTOSPI instance, 1 or 2.
+ */
+void EMXXLX_Sim_PowerCycle(uint8_t Port)
+{
+	SIM_ENTER();
+	for (uint32_t d = 0; d < EMXXLX_SIM_DIES; d++)
+	{
+		SIM_DieTypeDef *die = &Sim.Port[Port - 1U].Die[d];
+
+		Sim_Die_Reset(die);
+		die->Status &= EMXXLX_SIM_STATUS_BP;
+		die->BusyUntil = 0;
+		die->ReadyAt = 0;
+	}
+	SIM_LEAVE();
+}
+
+void EMXXLX_Sim_SetTiming(const EMXXLX_SIM_TimingTypeDef *Timing)
+{
+	Sim.Timing = *Timing;
+}
+
+void EMXXLX_Sim_GetTiming(EMXXLX_SIM_TimingTypeDef *Timing)
+{
+	*Timing = Sim.Timing;
+}
+
+void EMXXLX_Sim_SetObserver(EMXXLX_SIM_ObserverTypeDef Observer, void *Context)
+{
+	Sim.Observer = Observer;
+	Sim.Context = Context;
+}
+
+uint64_t EMXXLX_Sim_Now_ps(void)
+{
+	return Sim.Now;
+}
+
+uint64_t EMXXLX_Sim_Now_ns(void)
+{
+	return Sim.Now / SIM_PS_PER_NS;
+}
+
+/**
+ *  @brief Enable or disable the delivery of the interrupts at their due
+ * 		   time. When disabled they are only taken by EMXXLX_Sim_Step.
+ * 	@param Enable			Non zero to deliver automatically.
+ */
+void EMXXLX_Sim_AutoIrq(uint8_t Enable)
+{
+	SIM_ENTER();
+	Sim.AutoIrq = Enable;
+	Sim_Deliver();
+	SIM_LEAVE();
+}
+
+/**
+ *  @brief Pending interrupt of a port.
+ * 	@param Port				OCTOSPI instance, 1 or 2.
+ *  @retval Non zero while an interrupt is pending
+ */
+uint8_t EMXXLX_Sim_Pending(uint8_t Port)
+{
+	return Sim.Port[Port - 1U].Event != SIM_EVENT_NONE;
+}
+
+/**
+ *  @brief Take the earliest pending interrupt, the time moves to its due
+ * 		   time when later.
+ *  @retval Non zero when an interrupt was taken
+ */
+uint8_t EMXXLX_Sim_Step(void)
+{
+	SIM_PortTypeDef *next;
+
+	SIM_ENTER();
+	next = Sim_Next();
+	if (next != NULL)
+	{
+		Sim.Now = (next->Due > Sim.Now) ? next->Due : Sim.Now;
+		Sim_Complete(next);
+	}
+	SIM_LEAVE();
+
+	return next != NULL;
+}
+
+/**
+ *  @brief Let the simulated time run, the interrupts being taken.
+ * 	@param Ns				Duration in ns.
+ */
+void EMXXLX_Sim_Run(uint64_t Ns)
+{
+	SIM_ENTER();
+	Sim_Advance(Sim.Now + Ns * SIM_PS_PER_NS);
+	SIM_LEAVE();
+}
+
+/**
+ *  @brief Read the memory array of a device, out of the bus.
+ * 	@param Port				OCTOSPI instance, 1 or 2.
+ *  @param Die				Device, 0 or 1 for the IO[7:4] device of dual-quad mode.
+ *  @param Address			Device address.
+ *  @param pData			Data buffer.
+ *  @param Size				Amount of bytes.
+ */
+void EMXXLX_Sim_Peek(uint8_t Port, uint8_t Die, uint32_t Address, uint8_t *pData, uint32_t Size)
+{
+	Sim_Mem_Read(&Sim.Port[Port - 1U].Die[Die], Address & (EMXXLX_SIM_SIZE - 1U), pData, 1, Size);
+}
+
+/**
+ *  @brief Write the memory array of a device, out of the bus.
+ * 	@param Port				OCTOSPI instance, 1 or 2.
+ *  @param Die				Device, 0 or 1 for the IO[7:4] device of dual-quad mode.
+ *  @param Address			Device address.
+ *  @param pData			Data buffer.
+ *  @param Size				Amount of bytes.
+ */
+void EMXXLX_Sim_Poke(uint8_t Port, uint8_t Die, uint32_t Address, const uint8_t *pData, uint32_t Size)
+{
+	Sim_Mem_Write(&Sim.Port[Port - 1U].Die[Die], Address & (EMXXLX_SIM_SIZE - 1U), pData, 1, Size);
+}
+
+/**
+ *  @brief Registers of a device at the current time.
+ * 	@param Port				OCTOSPI instance, 1 or 2.
+ *  @param Die				Device, 0 or 1 for the IO[7:4] device of dual-quad mode.
+ *  @param Regs				Registers to be filled.
+ */
+void EMXXLX_Sim_GetRegs(uint8_t Port, uint8_t Die, EMXXLX_SIM_RegsTypeDef *Regs)
+{
+	const SIM_DieTypeDef *die = &Sim.Port[Port - 1U].Die[Die];
+
+	memcpy(Regs->Vol, die->Vol, sizeof(Regs->Vol));
+	memcpy(Regs->Nonvol, die->Nonvol, sizeof(Regs->Nonvol));
+	Regs->Status = die->Status;
+	Regs->Flags = die->Flags;
+	Regs->Wel = die->Wel;
+	Regs->Dpd = die->Dpd;
+	Regs->Busy = Sim.Now < die->BusyUntil;
+}
+
+void EMXXLX_Sim_GetStats(uint8_t Port, EMXXLX_SIM_StatsTypeDef *Stats)
+{
+	*Stats = Sim.Port[Port - 1U].Stats;
+}
+
+void EMXXLX_Sim_ResetStats(void)
+{
+	for (uint32_t p = 0; p < EMXXLX_SIM_PORTS; p++)
+	{
+		memset(&Sim.Port[p].Stats, 0, sizeof(Sim.Port[p].Stats));
+	}
+}
+
+/* Board ------------------------------------------------------------------*/
+
+void Error_Handler(void)
+{
+	fprintf(stderr, "emxxlx sim: Error_Handler\n");
+	abort();
+}
+
+/**
+ *  @brief Board configuration of the OCTOSPI instances, as in octospi.c.
+ */
+static void Sim_OSPI_Init(OSPI_HandleTypeDef *hospi, OCTOSPI_TypeDef *Instance)
+{
+	HAL_OSPI_DLYB_CfgTypeDef HAL_OSPI_DLYB_Cfg_Struct = {0};
+
+	hospi->Instance = Instance;
+	hospi->Init.FifoThreshold = 1;
+	hospi->Init.DualQuad = HAL_OSPI_DUALQUAD_DISABLE;
+	hospi->Init.MemoryType = HAL_OSPI_MEMTYPE_MICRON;
+	hospi->Init.DeviceSize = 27;
+	hospi->Init.ChipSelectHighTime = 1;
+	hospi->Init.FreeRunningClock = HAL_OSPI_FREERUNCLK_DISABLE;
+	hospi->Init.ClockMode = HAL_OSPI_CLOCK_MODE_0;
+	hospi->Init.WrapSize = HAL_OSPI_WRAP_NOT_SUPPORTED;
+	hospi->Init.ClockPrescaler = 4;
+	hospi->Init.SampleShifting = HAL_OSPI_SAMPLE_SHIFTING_NONE;
+	hospi->Init.DelayHoldQuarterCycle = HAL_OSPI_DHQC_DISABLE;
+	hospi->Init.ChipSelectBoundary = 0;
+	hospi->Init.DelayBlockBypass = HAL_OSPI_DELAY_BLOCK_BYPASSED;
+	hospi->Init.MaxTran = 0;
+	hospi->Init.Refresh = 0;
+	if (HAL_OSPI_Init(hospi) != HAL_OK)
+	{
+		Error_Handler();
+	}
+
+	HAL_OSPI_DLYB_Cfg_Struct.Units = 0;
+	HAL_OSPI_DLYB_Cfg_Struct.PhaseSel = 0;
+	if (HAL_OSPI_DLYB_SetConfig(hospi, &HAL_OSPI_DLYB_Cfg_Struct) != HAL_OK)
+	{
+		Error_Handler();
+	}
+}
+
+void MX_OCTOSPI1_Init(void)
+{
+	Sim_OSPI_Init(&hospi1, OCTOSPI1);
+}
+
+void MX_OCTOSPI2_Init(void)
+{
+	Sim_OSPI_Init(&hospi2, OCTOSPI2);
+}
+
+void HAL_OSPI_MspInit(OSPI_HandleTypeDef *hospi)
+{
+	SIM_PortTypeDef *port = Sim_Port(hospi);
+
+	port->Msp = 1;
+	if (hospi->Instance == OCTOSPI1)
+	{
+		handle_GPDMA1_Channel0.Instance = GPDMA1_Channel0;
+		__HAL_LINKDMA(hospi, hdma, handle_GPDMA1_Channel0);
+	}
+	else
+	{
+		handle_GPDMA1_Channel1.Instance = GPDMA1_Channel1;
+		__HAL_LINKDMA(hospi, hdma, handle_GPDMA1_Channel1);
+	}
+}
+
+void HAL_OSPI_MspDeInit(OSPI_HandleTypeDef *hospi)
+{
+	SIM_PortTypeDef *port = Sim_Port(hospi);
+
+	port->Msp = 0;
+	port->ResetSeq = 0;
+	port->Pulses = 0;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, const GPIO_InitTypeDef *pGPIO_Init)
+{
+	(void)GPIOx;
+	(void)pGPIO_Init;
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin)
+{
+	(void)GPIOx;
+	(void)GPIO_Pin;
+}
+
+/**
+ *  @brief Output level of the pins, the JEDEC reset sequence is taken by
+ * 		   the devices of the ports whose pins are released by the OCTOSPI.
+ */
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	SIM_ENTER();
+	if ((GPIOx == IO0_GPIO_Port) && ((GPIO_Pin & IO0_Pin) != 0U))
+	{
+		Sim.Io0 = PinState != GPIO_PIN_RESET;
+	}
+
+	if ((GPIOx == NCS_GPIO_Port) && ((GPIO_Pin & NCS_Pin) != 0U))
+	{
+		/* IO0 is sampled on the rising edges of NCS, low, high, low, high resets */
+		if ((Sim.Ncs == 0U) && (PinState != GPIO_PIN_RESET))
+		{
+			for (uint32_t p = 0; p < EMXXLX_SIM_PORTS; p++)
+			{
+				SIM_PortTypeDef *port = &Sim.Port[p];
+
+				if (port->Msp != 0U)
+				{
+					continue;
+				}
+
+				port->ResetSeq = (uint8_t)((port->ResetSeq << 1) | Sim.Io0);
+				port->Pulses++;
+				if ((port->Pulses >= 4U) && ((port->ResetSeq & 0x7U) == 0x5U))
+				{
+					for (uint32_t d = 0; d < EMXXLX_SIM_DIES; d++)
+					{
+						Sim_Die_Reset(&port->Die[d]);
+					}
+					port->Pulses = 0;
+				}
+			}
+		}
+		Sim.Ncs = PinState != GPIO_PIN_RESET;
+	}
+	SIM_LEAVE();
+}
+
+/**
+ *  @brief Millisecond tick of the simulated time. A program polling the
+ * 		   tick without any other simulator call makes the time jump to
+ * 		   the next interrupt or millisecond.
+ */
+uint32_t HAL_GetTick(void)
+{
+	uint64_t target;
+	SIM_PortTypeDef *next;
+	uint32_t tick;
+
+	SIM_ENTER();
+	Sim.TickSpins = (Sim.TickCalls == Sim.Calls - 1) ? Sim.TickSpins + 1U : 0U;
+	Sim.Now += Sim.Timing.TickNs * SIM_PS_PER_NS;
+	if (Sim.TickSpins >= SIM_TICK_SPINS)
+	{
+		target = (Sim.Now / SIM_PS_PER_MS + 1U) * SIM_PS_PER_MS;
+		next = Sim_Next();
+		if (Sim_Deliverable() && (next != NULL) && (next->Due < target))
+		{
+			target = next->Due;
+		}
+		Sim_Advance(target);
+		Sim.TickSpins = 0;
+	}
+	else
+	{
+		Sim_Deliver();
+	}
+	Sim.TickCalls = Sim.Calls;
+	tick = (uint32_t)(Sim.Now / SIM_PS_PER_MS);
+	SIM_LEAVE();
+
+	return tick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	SIM_ENTER();
+	Sim_Advance(Sim.Now + ((uint64_t)Delay + ((Delay < HAL_MAX_DELAY) ? 1U : 0U)) * SIM_PS_PER_MS);
+	SIM_LEAVE();
+}
+
+uint32_t HAL_RCCEx_GetPeriphCLKFreq(uint64_t PeriphClk)
+{
+	return (PeriphClk == RCC_PERIPHCLK_OSPI) ? Sim.Timing.KernelClockHz : SystemCoreClock;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+	return Sim.Primask;
+}
+
+void __set_PRIMASK(uint32_t priMask)
+{
+	SIM_ENTER();
+	Sim.Primask = priMask & 1U;
+	Sim_Deliver();
+	SIM_LEAVE();
+}
+
+void __disable_irq(void)
+{
+	Sim.Primask = 1;
+}
+
+void __enable_irq(void)
+{
+	__set_PRIMASK(0);
+}
+
+/**
+ *  @brief DWT registers brought up to the simulated time. A value written
+ * 		   to the cycle counter since the last access rebases it. A program
+ * 		   busy waiting on the cycle counter without any other simulator
+ * 		   call makes the time jump to the next interrupt or microsecond.
+ */
+DWT_Type *EMXXLX_Sim_Dwt(void)
+{
+	uint64_t target;
+	SIM_PortTypeDef *next;
+	uint32_t cycles;
+
+	SIM_ENTER();
+	Sim.DwtSpins = (Sim.DwtCalls == Sim.Calls - 1) ? Sim.DwtSpins + 1U : 0U;
+	Sim.Now += Sim.Timing.DwtNs * SIM_PS_PER_NS;
+	if (Sim.DwtSpins >= SIM_DWT_SPINS)
+	{
+		target = (Sim.Now / SIM_PS_PER_US + 1U) * SIM_PS_PER_US;
+		next = Sim_Next();
+		if (Sim_Deliverable() && (next != NULL) && (next->Due < target))
+		{
+			target = next->Due;
+		}
+		Sim_Advance(target);
+		Sim.DwtSpins = 0;
+	}
+	else
+	{
+		Sim_Deliver();
+	}
+	Sim.DwtCalls = Sim.Calls;
+	cycles = (uint32_t)((Sim.Now * (SystemCoreClock / 1000000U)) / 1000000U);
+	if ((Sim_Dwt.CYCCNT != Sim.DwtLast) || ((Sim_Dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U))
+	{
+		Sim.DwtBase = cycles - Sim_Dwt.CYCCNT;
+	}
+	Sim_Dwt.CYCCNT = cycles - Sim.DwtBase;
+	Sim.DwtLast = Sim_Dwt.CYCCNT;
+	SIM_LEAVE();
+
+	return &Sim_Dwt;
+}
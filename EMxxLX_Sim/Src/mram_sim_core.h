@@ -0,0 +1,226 @@
+/*
+ * mram_sim_core.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Simulator internals shared by the device model and the HAL_OSPI
+ *  replacement, not part of the interface of mram_sim.h.
+ */
+
+#include "mram_sim.h"
+
+#include <signal.h>
+
+#ifndef SRC_MRAM_SIM_CORE_H_
+#define SRC_MRAM_SIM_CORE_H_
+
+#define SIM_PAGE_BITS				12 // Storage allocation unit, 4kB
+#define SIM_PAGES					(EMXXLX_SIM_SIZE >> SIM_PAGE_BITS) // Storage pages of one device
+#define SIM_PS_PER_NS				1000ULL
+#define SIM_PS_PER_US				1000000ULL
+#define SIM_PS_PER_MS				1000000000ULL
+#define SIM_TICK_SPINS				16U // HAL_GetTick calls in a row before the time jumps to the next event
+#define SIM_DWT_SPINS				16U // DWT accesses in a row before the time jumps to the next event
+#define SIM_NEVER					UINT64_MAX
+#define SIM_DLYB_CELL_PS			25U // Delay of one delay block unit
+#define SIM_FIFO_SIZE				32U // OCTOSPI FIFO bytes
+
+/** @defgroup SIM_Event SIM Event
+  * @{
+  */
+#define SIM_EVENT_NONE							0x00U // No interrupt pending
+#define SIM_EVENT_CMD							0x01U // Command without data, HAL_OSPI_CmdCpltCallback
+#define SIM_EVENT_RX							0x02U // Data phase received, HAL_OSPI_RxCpltCallback
+#define SIM_EVENT_TX							0x03U // Data phase sent, HAL_OSPI_TxCpltCallback
+#define SIM_EVENT_POLL							0x04U // Automatic polling match, HAL_OSPI_StatusMatchCallback
+/**
+  * @}
+  */
+
+typedef struct
+{
+  uint8_t Instruction;							/*!< Instruction opcode */
+
+  uint8_t ILines;								/*!< Lines of the instruction phase, 0 for none */
+
+  uint8_t IDtr;									/*!< Double transfer rate of the instruction phase */
+
+  uint8_t IBytes;								/*!< Instruction size */
+
+  uint8_t ALines;								/*!< Lines of the address phase, 0 for none */
+
+  uint8_t ADtr;									/*!< Double transfer rate of the address phase */
+
+  uint8_t ABytes;								/*!< Address size */
+
+  uint8_t BLines;								/*!< Lines of the alternate bytes phase, 0 for none */
+
+  uint8_t BDtr;									/*!< Double transfer rate of the alternate bytes phase */
+
+  uint8_t BBytes;								/*!< Alternate bytes size */
+
+  uint8_t DLines;								/*!< Lines of the data phase, 0 for none */
+
+  uint8_t DDtr;									/*!< Double transfer rate of the data phase */
+
+  uint8_t Dqs;									/*!< Data sampled on DQS */
+
+  uint8_t Dcyc;									/*!< Dummy cycles */
+
+  uint32_t SamplePs;							/*!< Read sampling point after the clock edge, or after DQS */
+
+  uint8_t Dies;									/*!< Devices answering, 2 in dual-quad mode */
+
+  uint8_t Write;								/*!< Non zero for an indirect write */
+
+  uint32_t Address;								/*!< Address phase value */
+
+  uint32_t NbData;								/*!< Data phase length */
+} SIM_CmdTypeDef;
+
+typedef struct
+{
+  uint8_t Vol[EMXXLX_SIM_REGISTERS];			/*!< Volatile configuration registers */
+
+  uint8_t Nonvol[EMXXLX_SIM_REGISTERS];			/*!< Nonvolatile configuration registers */
+
+  uint8_t Status;								/*!< Status register, without the busy and WEL bits */
+
+  uint8_t Flags;								/*!< Error bits of the flag status register */
+
+  uint8_t Wel;									/*!< Write enable latch */
+
+  uint8_t Dpd;									/*!< Deep power-down */
+
+  uint64_t BusyUntil;							/*!< End of the ongoing write or erase, in ps */
+
+  uint64_t ReadyAt;								/*!< End of the deep power-down exit, in ps */
+
+  uint8_t *Mem;									/*!< Memory array, pages allocated on first write */
+
+  uint8_t Valid[SIM_PAGES];						/*!< Non zero once the page holds data */
+
+  uint8_t Fill[SIM_PAGES];						/*!< Contents of a page which does not hold data */
+} SIM_DieTypeDef;
+
+typedef struct
+{
+  uint8_t Active;								/*!< Indirect read started from the registers and not drained yet */
+
+  uint32_t NbData;								/*!< Data phase length */
+
+  uint32_t Received;							/*!< Bytes entered in the FIFO */
+
+  uint32_t Consumed;							/*!< Bytes read from DR */
+
+  uint64_t DataStart;							/*!< Start of the data phase, in ps */
+
+  uint64_t DataPs;								/*!< Length of the data phase without FIFO stall, in ps */
+
+  uint64_t Stall;								/*!< Clock stopped on a full FIFO, in ps */
+} SIM_IndirectTypeDef;
+
+typedef struct
+{
+  SIM_DieTypeDef Die[EMXXLX_SIM_DIES];			/*!< Devices of the port */
+
+  OCTOSPI_TypeDef *Regs;						/*!< Writable view of the OCTOSPI registers */
+
+  DLYB_TypeDef *Dlyb;							/*!< Writable view of the delay block registers */
+
+  uint8_t Msp;									/*!< Non zero while the pins are driven by the OCTOSPI */
+
+  uint8_t ResetSeq;								/*!< IO0 level of the last NCS pulses, JEDEC reset detection */
+
+  uint8_t Pulses;								/*!< NCS pulses since the pins were released */
+
+  uint8_t Event;								/*!< Pending interrupt, a value of @ref SIM_Event */
+
+  uint8_t Error;								/*!< Error code of the pending interrupt, HAL_OSPI_ERROR_TRANSFER */
+
+  uint64_t Start;								/*!< Chip select assertion of the pending command, in ps */
+
+  uint64_t Due;									/*!< Time of the pending interrupt, in ps */
+
+  SIM_CmdTypeDef Cmd;							/*!< Pending command */
+
+  OSPI_HandleTypeDef *hospi;					/*!< Handle of the pending command */
+
+  uint8_t *pData;								/*!< Buffer of the pending data phase */
+
+  uint32_t Units;								/*!< Delay block unit delay */
+
+  uint32_t PhaseSel;							/*!< Delay block output clock phase */
+
+  uint8_t Trap;									/*!< Non zero when the register accesses are trapped */
+
+  SIM_IndirectTypeDef Indirect;					/*!< Indirect read of the register level model */
+
+  EMXXLX_SIM_StatsTypeDef Stats;				/*!< Port statistics */
+} SIM_PortTypeDef;
+
+typedef struct
+{
+  uint64_t Now;									/*!< Simulated time in ps */
+
+  EMXXLX_SIM_TimingTypeDef Timing;				/*!< Timing model */
+
+  SIM_PortTypeDef Port[EMXXLX_SIM_PORTS];		/*!< OCTOSPI instances */
+
+  EMXXLX_SIM_ObserverTypeDef Observer;			/*!< Command observer */
+
+  void *Context;								/*!< Observer context */
+
+  uint8_t AutoIrq;								/*!< Interrupts delivered at their due time */
+
+  uint8_t InIrq;								/*!< Non zero while a callback runs */
+
+  uint32_t Primask;								/*!< Interrupt mask */
+
+  volatile sig_atomic_t Depth;					/*!< Nesting of the simulator calls, the timer only delivers at 0 */
+
+  volatile sig_atomic_t Calls;					/*!< Simulator calls, a spinning program makes none */
+
+  sig_atomic_t AlarmCalls;						/*!< Calls at the last host timer tick */
+
+  sig_atomic_t TickCalls;						/*!< Calls at the last HAL_GetTick */
+
+  uint32_t TickSpins;							/*!< HAL_GetTick calls in a row */
+
+  sig_atomic_t DwtCalls;						/*!< Calls at the last DWT access */
+
+  uint32_t DwtSpins;							/*!< DWT accesses in a row */
+
+  uint32_t DwtBase;								/*!< Cycle counter offset */
+
+  uint32_t DwtLast;								/*!< Cycle counter value last published */
+
+  uint8_t Ncs;									/*!< Output level of the NCS pin */
+
+  uint8_t Io0;									/*!< Output level of the IO0 pin */
+} SIM_TypeDef;
+
+extern SIM_TypeDef Sim;
+
+#define SIM_ENTER()		do { Sim.Depth++; Sim.Calls++; __COMPILER_BARRIER(); } while (0)
+#define SIM_LEAVE()		do { __COMPILER_BARRIER(); Sim.Depth--; } while (0)
+
+/* Functions */
+SIM_PortTypeDef *Sim_Port(OSPI_HandleTypeDef *hospi);
+uint64_t Sim_Clock_Ps(SIM_PortTypeDef *Port);
+void Sim_Decode(SIM_PortTypeDef *Port, SIM_CmdTypeDef *Cmd);
+uint32_t Sim_Cycles(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd, uint32_t NbData);
+uint8_t Sim_Check(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd);
+void Sim_Execute(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd, uint8_t *pData, uint32_t NbData,
+				 uint64_t Start);
+uint64_t Sim_Poll(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd, const OSPI_AutoPollingTypeDef *Config,
+				  uint64_t Start);
+void Sim_Schedule(SIM_PortTypeDef *Port, uint8_t Event, OSPI_HandleTypeDef *hospi, const SIM_CmdTypeDef *Cmd,
+				  uint8_t *pData, uint64_t Start, uint64_t Due);
+void Sim_Cancel(SIM_PortTypeDef *Port);
+void Sim_Advance(uint64_t Until);
+void Sim_Deliver(void);
+void Sim_Complete(SIM_PortTypeDef *Port);
+void Sim_Registers_Reset(void);
+
+#endif /* SRC_MRAM_SIM_CORE_H_ */
@@ -0,0 +1,713 @@
+/*
+ * mram_sim_hal.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  HAL_OSPI entry points of the EMxxLX host simulator. The state machine,
+ *  the error codes and the register writes follow stm32u5xx_hal_ospi.c,
+ *  the commands are sent to the device model of mram_sim.c.
+ */
+
+#include "mram_sim_core.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_STATE_CFG_MASK			0x00000004U // Configured states, as OSPI_CFG_STATE_MASK
+#define SIM_STATE_BUSY_MASK			0x00000008U // Busy states, as OSPI_BUSY_STATE_MASK
+#define SIM_FMODE_WRITE				0x00000000U // Indirect write functional mode
+#define SIM_FMODE_READ				OCTOSPI_CR_FMODE_0 // Indirect read functional mode
+#define SIM_FMODE_POLLING			OCTOSPI_CR_FMODE_1 // Automatic polling functional mode
+#define SIM_FMODE_MAPPED			OCTOSPI_CR_FMODE // Memory-mapped functional mode
+
+/**
+ *  @brief Entry of a HAL call: CPU time and interrupts already due.
+ */
+static SIM_PortTypeDef *Sim_Enter(OSPI_HandleTypeDef *hospi)
+{
+	SIM_ENTER();
+	Sim.Now += Sim.Timing.HalCallNs * SIM_PS_PER_NS;
+	Sim_Deliver();
+
+	return Sim_Port(hospi);
+}
+
+/**
+ *  @brief Exit of a HAL call.
+ */
+static HAL_StatusTypeDef Sim_Leave(HAL_StatusTypeDef Status)
+{
+	SIM_LEAVE();
+
+	return Status;
+}
+
+/**
+ *  @brief Timeout of a HAL call: the simulated time runs for the timeout,
+ * 		   the handle goes to the error state.
+ */
+static HAL_StatusTypeDef Sim_Timeout(OSPI_HandleTypeDef *hospi, SIM_PortTypeDef *Port, uint32_t Timeout)
+{
+	if (Timeout == HAL_MAX_DELAY)
+	{
+		fprintf(stderr, "emxxlx sim: OCTOSPI%u waits forever\n", (unsigned)(Port - Sim.Port) + 1U);
+		abort();
+	}
+
+	Sim_Advance(Sim.Now + Timeout * SIM_PS_PER_MS);
+	Port->Stats.Errors++;
+	hospi->State = HAL_OSPI_STATE_ERROR;
+	hospi->ErrorCode |= HAL_OSPI_ERROR_TIMEOUT;
+
+	return HAL_ERROR;
+}
+
+/**
+ *  @brief Wait until the controller is no longer busy.
+ */
+static HAL_StatusTypeDef Sim_Wait_Busy(OSPI_HandleTypeDef *hospi, SIM_PortTypeDef *Port, uint32_t Timeout)
+{
+	if ((Port->Event != SIM_EVENT_NONE) && (Port->Due != SIM_NEVER) && (Timeout != 0U))
+	{
+		uint64_t limit = Sim.Now + (uint64_t)Timeout * SIM_PS_PER_MS;
+
+		Sim_Advance((Port->Due < limit) ? Port->Due : limit);
+	}
+
+	if ((Port->Regs->SR & OCTOSPI_SR_BUSY) == 0U)
+	{
+		return HAL_OK;
+	}
+
+	return Sim_Timeout(hospi, Port, Timeout);
+}
+
+/**
+ *  @brief Program the command registers, as OSPI_ConfigCmd.
+ */
+static HAL_StatusTypeDef Sim_ConfigCmd(OSPI_HandleTypeDef *hospi, OCTOSPI_TypeDef *Regs,
+									   OSPI_RegularCmdTypeDef *cmd)
+{
+	__IO uint32_t *ccr_reg;
+	__IO uint32_t *tcr_reg;
+	__IO uint32_t *ir_reg;
+	__IO uint32_t *abr_reg;
+
+	MODIFY_REG(Regs->CR, OCTOSPI_CR_FMODE, 0U);
+	if (hospi->Init.DualQuad == HAL_OSPI_DUALQUAD_DISABLE)
+	{
+		MODIFY_REG(Regs->CR, OCTOSPI_CR_MSEL, cmd->FlashId);
+	}
+
+	if (cmd->OperationType == HAL_OSPI_OPTYPE_WRITE_CFG)
+	{
+		ccr_reg = &Regs->WCCR;
+		tcr_reg = &Regs->WTCR;
+		ir_reg = &Regs->WIR;
+		abr_reg = &Regs->WABR;
+	}
+	else if (cmd->OperationType == HAL_OSPI_OPTYPE_WRAP_CFG)
+	{
+		ccr_reg = &Regs->WPCCR;
+		tcr_reg = &Regs->WPTCR;
+		ir_reg = &Regs->WPIR;
+		abr_reg = &Regs->WPABR;
+	}
+	else
+	{
+		ccr_reg = &Regs->CCR;
+		tcr_reg = &Regs->TCR;
+		ir_reg = &Regs->IR;
+		abr_reg = &Regs->ABR;
+	}
+
+	*ccr_reg = cmd->DQSMode | cmd->SIOOMode;
+	if (cmd->AlternateBytesMode != HAL_OSPI_ALTERNATE_BYTES_NONE)
+	{
+		*abr_reg = cmd->AlternateBytes;
+		MODIFY_REG(*ccr_reg, OCTOSPI_CCR_ABMODE | OCTOSPI_CCR_ABDTR | OCTOSPI_CCR_ABSIZE,
+				   cmd->AlternateBytesMode | cmd->AlternateBytesDtrMode | cmd->AlternateBytesSize);
+	}
+
+	MODIFY_REG(*tcr_reg, OCTOSPI_TCR_DCYC, cmd->DummyCycles);
+	if ((cmd->DataMode != HAL_OSPI_DATA_NONE) && (cmd->OperationType == HAL_OSPI_OPTYPE_COMMON_CFG))
+	{
+		Regs->DLR = cmd->NbData - 1U;
+	}
+
+	if ((cmd->InstructionMode == HAL_OSPI_INSTRUCTION_NONE) && (cmd->AddressMode == HAL_OSPI_ADDRESS_NONE))
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_PARAM;
+		return HAL_ERROR;
+	}
+
+	if (cmd->InstructionMode != HAL_OSPI_INSTRUCTION_NONE)
+	{
+		MODIFY_REG(*ccr_reg, OCTOSPI_CCR_IMODE | OCTOSPI_CCR_IDTR | OCTOSPI_CCR_ISIZE,
+				   cmd->InstructionMode | cmd->InstructionDtrMode | cmd->InstructionSize);
+		*ir_reg = cmd->Instruction;
+	}
+
+	if (cmd->AddressMode != HAL_OSPI_ADDRESS_NONE)
+	{
+		MODIFY_REG(*ccr_reg, OCTOSPI_CCR_ADMODE | OCTOSPI_CCR_ADDTR | OCTOSPI_CCR_ADSIZE,
+				   cmd->AddressMode | cmd->AddressDtrMode | cmd->AddressSize);
+		Regs->AR = cmd->Address;
+	}
+
+	if (cmd->DataMode != HAL_OSPI_DATA_NONE)
+	{
+		MODIFY_REG(*ccr_reg, OCTOSPI_CCR_DMODE | OCTOSPI_CCR_DDTR, cmd->DataMode | cmd->DataDtrMode);
+	}
+	else if ((hospi->Init.DelayHoldQuarterCycle == HAL_OSPI_DHQC_ENABLE)
+			 && (cmd->InstructionDtrMode == HAL_OSPI_INSTRUCTION_DTR_ENABLE))
+	{
+		/* The DHQC bit is linked with DDTR bit which should be activated */
+		MODIFY_REG(*ccr_reg, OCTOSPI_CCR_DDTR, HAL_OSPI_DATA_DTR_ENABLE);
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Bus time of a command in ps.
+ */
+static uint64_t Sim_Bus_Ps(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd)
+{
+	return Sim_Cycles(Port, Cmd, Cmd->NbData) * Sim_Clock_Ps(Port);
+}
+
+/**
+ *  @brief Data phase of a blocking or interrupt transfer, the CPU moves the
+ * 		   bytes.
+ */
+static uint64_t Sim_Cpu_Ps(SIM_PortTypeDef *Port, const SIM_CmdTypeDef *Cmd)
+{
+	uint64_t bus = Sim_Bus_Ps(Port, Cmd);
+	uint64_t cpu = (uint64_t)Cmd->NbData * Sim.Timing.HalByteNs * SIM_PS_PER_NS;
+
+	return (cpu > bus) ? cpu : bus;
+}
+
+/**
+ *  @brief Send the data phase of a blocking transfer.
+ */
+static HAL_StatusTypeDef Sim_Transfer(OSPI_HandleTypeDef *hospi, SIM_PortTypeDef *Port, uint8_t *pData,
+									  uint32_t FunctionalMode)
+{
+	SIM_CmdTypeDef cmd;
+	uint64_t start = Sim.Now;
+
+	if (pData == NULL)
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_PARAM;
+		return HAL_ERROR;
+	}
+
+	if (hospi->State != HAL_OSPI_STATE_CMD_CFG)
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return HAL_ERROR;
+	}
+
+	MODIFY_REG(Port->Regs->CR, OCTOSPI_CR_FMODE, FunctionalMode);
+	Sim_Decode(Port, &cmd);
+	hospi->State = HAL_OSPI_STATE_READY;
+	if (Sim_Check(Port, &cmd) != HAL_OSPI_ERROR_NONE)
+	{
+		Port->Stats.Errors++;
+		hospi->ErrorCode |= HAL_OSPI_ERROR_TRANSFER;
+		return HAL_ERROR;
+	}
+
+	Sim_Execute(Port, &cmd, pData, cmd.NbData, start);
+	Sim_Advance(start + Sim_Cpu_Ps(Port, &cmd));
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Start the data phase of an interrupt or DMA transfer.
+ */
+static HAL_StatusTypeDef Sim_Transfer_Start(OSPI_HandleTypeDef *hospi, SIM_PortTypeDef *Port, uint8_t *pData,
+											uint32_t FunctionalMode, uint8_t Dma)
+{
+	SIM_CmdTypeDef cmd;
+	uint8_t read = FunctionalMode == SIM_FMODE_READ;
+
+	if (pData == NULL)
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_PARAM;
+		return HAL_ERROR;
+	}
+
+	if (hospi->State != HAL_OSPI_STATE_CMD_CFG)
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return HAL_ERROR;
+	}
+
+	if (Dma && (hospi->hdma == NULL))
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_DMA;
+		hospi->State = HAL_OSPI_STATE_READY;
+		return HAL_ERROR;
+	}
+
+	MODIFY_REG(Port->Regs->CR, OCTOSPI_CR_FMODE, FunctionalMode);
+	if (Dma)
+	{
+		SET_BIT(Port->Regs->CR, OCTOSPI_CR_DMAEN);
+	}
+	Sim_Decode(Port, &cmd);
+	hospi->State = read ? HAL_OSPI_STATE_BUSY_RX : HAL_OSPI_STATE_BUSY_TX;
+	Sim_Schedule(Port, read ? SIM_EVENT_RX : SIM_EVENT_TX, hospi, &cmd, pData, Sim.Now,
+				 Sim.Now + (Dma ? Sim_Bus_Ps(Port, &cmd) : Sim_Cpu_Ps(Port, &cmd)));
+	Port->Error = Sim_Check(Port, &cmd);
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Take the pending interrupt of a port: the command takes effect,
+ * 		   the handle goes back to ready and the callback is called.
+ * 	@param Port				Simulator port.
+ */
+void Sim_Complete(SIM_PortTypeDef *Port)
+{
+	OSPI_HandleTypeDef *hospi = Port->hospi;
+	uint8_t event = Port->Event;
+	uint8_t error = Port->Error;
+
+	if (error != HAL_OSPI_ERROR_NONE)
+	{
+		Port->Stats.Errors++;
+	}
+	else if (event == SIM_EVENT_CMD)
+	{
+		Sim_Execute(Port, &Port->Cmd, NULL, 0, Port->Start);
+	}
+	else if ((event == SIM_EVENT_RX) || (event == SIM_EVENT_TX))
+	{
+		Sim_Execute(Port, &Port->Cmd, Port->pData, Port->Cmd.NbData, Port->Start);
+	}
+
+	Sim_Cancel(Port);
+	CLEAR_BIT(Port->Regs->CR, OCTOSPI_CR_DMAEN);
+	hospi->State = HAL_OSPI_STATE_READY;
+
+	Sim.InIrq = 1;
+	if (error != HAL_OSPI_ERROR_NONE)
+	{
+		hospi->ErrorCode |= error;
+		HAL_OSPI_ErrorCallback(hospi);
+	}
+	else if (event == SIM_EVENT_CMD)
+	{
+		HAL_OSPI_CmdCpltCallback(hospi);
+	}
+	else if (event == SIM_EVENT_RX)
+	{
+		HAL_OSPI_RxCpltCallback(hospi);
+	}
+	else if (event == SIM_EVENT_TX)
+	{
+		HAL_OSPI_TxCpltCallback(hospi);
+	}
+	else
+	{
+		HAL_OSPI_StatusMatchCallback(hospi);
+	}
+	Sim.InIrq = 0;
+}
+
+/**
+ *  @brief Program the OCTOSPI registers from hospi->Init. Unlike the ST HAL
+ * 		   it does so on every call, the MSP is only initialized from the
+ * 		   reset state.
+ */
+HAL_StatusTypeDef HAL_OSPI_Init(OSPI_HandleTypeDef *hospi)
+{
+	SIM_PortTypeDef *port;
+	OCTOSPI_TypeDef *regs;
+
+	if (hospi == NULL)
+	{
+		return HAL_ERROR;
+	}
+
+	port = Sim_Enter(hospi);
+	regs = port->Regs;
+	hospi->ErrorCode = HAL_OSPI_ERROR_NONE;
+	if (hospi->State == HAL_OSPI_STATE_RESET)
+	{
+		HAL_OSPI_MspInit(hospi);
+		hospi->Timeout = HAL_OSPI_TIMEOUT_DEFAULT_VALUE;
+	}
+
+	regs->DCR1 = hospi->Init.MemoryType | ((hospi->Init.DeviceSize - 1U) << OCTOSPI_DCR1_DEVSIZE_Pos)
+			| ((hospi->Init.ChipSelectHighTime - 1U) << OCTOSPI_DCR1_CSHT_Pos) | hospi->Init.DelayBlockBypass
+			| hospi->Init.ClockMode | hospi->Init.FreeRunningClock;
+	regs->DCR2 = hospi->Init.WrapSize | ((hospi->Init.ClockPrescaler - 1U) << OCTOSPI_DCR2_PRESCALER_Pos);
+	regs->DCR3 = hospi->Init.MaxTran | (hospi->Init.ChipSelectBoundary << OCTOSPI_DCR3_CSBOUND_Pos);
+	regs->DCR4 = hospi->Init.Refresh;
+	regs->CR = ((hospi->Init.FifoThreshold - 1U) << OCTOSPI_CR_FTHRES_Pos) | hospi->Init.DualQuad | OCTOSPI_CR_EN;
+	regs->TCR = hospi->Init.SampleShifting | hospi->Init.DelayHoldQuarterCycle;
+	regs->SR &= OCTOSPI_SR_BUSY;
+	hospi->State = HAL_OSPI_STATE_READY;
+
+	return Sim_Leave(HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Command(OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd, uint32_t Timeout)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+	uint32_t state = hospi->State;
+	SIM_CmdTypeDef decoded;
+	uint64_t start;
+
+	if (!((state == HAL_OSPI_STATE_READY)
+		  || ((state == HAL_OSPI_STATE_READ_CMD_CFG) && ((cmd->OperationType == HAL_OSPI_OPTYPE_WRITE_CFG)
+														 || (cmd->OperationType == HAL_OSPI_OPTYPE_WRAP_CFG)))
+		  || ((state == HAL_OSPI_STATE_WRITE_CMD_CFG) && ((cmd->OperationType == HAL_OSPI_OPTYPE_READ_CFG)
+														  || (cmd->OperationType == HAL_OSPI_OPTYPE_WRAP_CFG)))))
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	if ((Sim_Wait_Busy(hospi, port, Timeout) != HAL_OK) || (Sim_ConfigCmd(hospi, port->Regs, cmd) != HAL_OK))
+	{
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	if (cmd->DataMode == HAL_OSPI_DATA_NONE)
+	{
+		if (cmd->OperationType != HAL_OSPI_OPTYPE_COMMON_CFG)
+		{
+			return Sim_Leave(HAL_OK);
+		}
+
+		/* The command is sent on the write of the instruction or address */
+		Sim_Decode(port, &decoded);
+		start = Sim.Now;
+		Sim_Execute(port, &decoded, NULL, 0, start);
+		Sim_Advance(start + Sim_Bus_Ps(port, &decoded));
+		if (Timeout == 0U)
+		{
+			return Sim_Leave(Sim_Timeout(hospi, port, 0));
+		}
+
+		return Sim_Leave(HAL_OK);
+	}
+
+	if (cmd->OperationType == HAL_OSPI_OPTYPE_COMMON_CFG)
+	{
+		hospi->State = HAL_OSPI_STATE_CMD_CFG;
+	}
+	else if (cmd->OperationType == HAL_OSPI_OPTYPE_READ_CFG)
+	{
+		hospi->State = (state == HAL_OSPI_STATE_WRITE_CMD_CFG) ? HAL_OSPI_STATE_CMD_CFG
+				: HAL_OSPI_STATE_READ_CMD_CFG;
+	}
+	else if (cmd->OperationType == HAL_OSPI_OPTYPE_WRITE_CFG)
+	{
+		hospi->State = (state == HAL_OSPI_STATE_READ_CMD_CFG) ? HAL_OSPI_STATE_CMD_CFG
+				: HAL_OSPI_STATE_WRITE_CMD_CFG;
+	}
+
+	return Sim_Leave(HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Command_IT(OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+	SIM_CmdTypeDef decoded;
+
+	if ((hospi->State != HAL_OSPI_STATE_READY) || (cmd->OperationType != HAL_OSPI_OPTYPE_COMMON_CFG)
+		|| (cmd->DataMode != HAL_OSPI_DATA_NONE))
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	if ((Sim_Wait_Busy(hospi, port, hospi->Timeout) != HAL_OK) || (Sim_ConfigCmd(hospi, port->Regs, cmd) != HAL_OK))
+	{
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	Sim_Decode(port, &decoded);
+	hospi->State = HAL_OSPI_STATE_BUSY_CMD;
+	Sim_Schedule(port, SIM_EVENT_CMD, hospi, &decoded, NULL, Sim.Now, Sim.Now + Sim_Bus_Ps(port, &decoded));
+
+	return Sim_Leave(HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Receive(OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	(void)Timeout;
+	return Sim_Leave(Sim_Transfer(hospi, port, pData, SIM_FMODE_READ));
+}
+
+HAL_StatusTypeDef HAL_OSPI_Transmit(OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	(void)Timeout;
+	return Sim_Leave(Sim_Transfer(hospi, port, pData, SIM_FMODE_WRITE));
+}
+
+HAL_StatusTypeDef HAL_OSPI_Receive_IT(OSPI_HandleTypeDef *hospi, uint8_t *pData)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	return Sim_Leave(Sim_Transfer_Start(hospi, port, pData, SIM_FMODE_READ, 0));
+}
+
+HAL_StatusTypeDef HAL_OSPI_Transmit_IT(OSPI_HandleTypeDef *hospi, uint8_t *pData)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	return Sim_Leave(Sim_Transfer_Start(hospi, port, pData, SIM_FMODE_WRITE, 0));
+}
+
+HAL_StatusTypeDef HAL_OSPI_Receive_DMA(OSPI_HandleTypeDef *hospi, uint8_t *pData)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	return Sim_Leave(Sim_Transfer_Start(hospi, port, pData, SIM_FMODE_READ, 1));
+}
+
+HAL_StatusTypeDef HAL_OSPI_Transmit_DMA(OSPI_HandleTypeDef *hospi, uint8_t *pData)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	return Sim_Leave(Sim_Transfer_Start(hospi, port, pData, SIM_FMODE_WRITE, 1));
+}
+
+/**
+ *  @brief Program the automatic polling registers and send the command.
+ */
+static void Sim_Polling_Config(SIM_PortTypeDef *Port, OSPI_AutoPollingTypeDef *cfg, SIM_CmdTypeDef *Cmd)
+{
+	OCTOSPI_TypeDef *regs = Port->Regs;
+
+	regs->PSMAR = cfg->Match;
+	regs->PSMKR = cfg->Mask;
+	regs->PIR = cfg->Interval;
+	MODIFY_REG(regs->CR, OCTOSPI_CR_PMM | OCTOSPI_CR_APMS | OCTOSPI_CR_FMODE,
+			   cfg->MatchMode | cfg->AutomaticStop | SIM_FMODE_POLLING);
+	Sim_Decode(Port, Cmd);
+}
+
+HAL_StatusTypeDef HAL_OSPI_AutoPolling(OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg, uint32_t Timeout)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+	SIM_CmdTypeDef cmd;
+	uint64_t match;
+
+	if ((hospi->State != HAL_OSPI_STATE_CMD_CFG) || (cfg->AutomaticStop != HAL_OSPI_AUTOMATIC_STOP_ENABLE))
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	if (Sim_Wait_Busy(hospi, port, Timeout) != HAL_OK)
+	{
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	Sim_Polling_Config(port, cfg, &cmd);
+	match = Sim_Poll(port, &cmd, cfg, Sim.Now);
+	if (match == SIM_NEVER)
+	{
+		return Sim_Leave(Sim_Timeout(hospi, port, Timeout));
+	}
+
+	Sim_Advance(match + Sim_Bus_Ps(port, &cmd));
+	hospi->State = HAL_OSPI_STATE_READY;
+
+	return Sim_Leave(HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_OSPI_AutoPolling_IT(OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+	SIM_CmdTypeDef cmd;
+	uint64_t match;
+
+	if (hospi->State != HAL_OSPI_STATE_CMD_CFG)
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	if (Sim_Wait_Busy(hospi, port, hospi->Timeout) != HAL_OK)
+	{
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	/* Without match the polling goes on until aborted */
+	Sim_Polling_Config(port, cfg, &cmd);
+	match = Sim_Poll(port, &cmd, cfg, Sim.Now);
+	hospi->State = HAL_OSPI_STATE_BUSY_AUTO_POLLING;
+	Sim_Schedule(port, SIM_EVENT_POLL, hospi, &cmd, NULL, match,
+				 (match == SIM_NEVER) ? SIM_NEVER : match + Sim_Bus_Ps(port, &cmd));
+
+	return Sim_Leave(HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_OSPI_MemoryMapped(OSPI_HandleTypeDef *hospi, OSPI_MemoryMappedTypeDef *cfg)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	if (hospi->State != HAL_OSPI_STATE_CMD_CFG)
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	if (Sim_Wait_Busy(hospi, port, hospi->Timeout) != HAL_OK)
+	{
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	MODIFY_REG(port->Regs->CR, OCTOSPI_CR_TCEN | OCTOSPI_CR_FMODE, cfg->TimeOutActivation | SIM_FMODE_MAPPED);
+	port->Regs->SR |= OCTOSPI_SR_BUSY;
+	hospi->State = HAL_OSPI_STATE_BUSY_MEM_MAPPED;
+
+	return Sim_Leave(HAL_OK);
+}
+
+/**
+ *  @brief Abort the ongoing operation. A command whose bus time is over has
+ * 		   taken effect, a write cut in its data phase has written the bytes
+ * 		   already sent.
+ */
+HAL_StatusTypeDef HAL_OSPI_Abort(OSPI_HandleTypeDef *hospi)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+	uint32_t state = hospi->State;
+	uint32_t align;
+	uint64_t sent;
+
+	if (((state & SIM_STATE_BUSY_MASK) == 0U) && ((state & SIM_STATE_CFG_MASK) == 0U))
+	{
+		hospi->ErrorCode = HAL_OSPI_ERROR_INVALID_SEQUENCE;
+		return Sim_Leave(HAL_ERROR);
+	}
+
+	CLEAR_BIT(port->Regs->CR, OCTOSPI_CR_DMAEN);
+	if ((port->Event != SIM_EVENT_NONE) && (port->Error == HAL_OSPI_ERROR_NONE) && (port->Event != SIM_EVENT_POLL))
+	{
+		if (Sim.Now >= port->Due)
+		{
+			Sim_Execute(port, &port->Cmd, port->pData, port->Cmd.NbData, port->Start);
+		}
+		else if ((port->Event == SIM_EVENT_TX) && (Sim.Now > port->Start))
+		{
+			align = ((port->Cmd.Dies == 2U) || ((port->Cmd.DLines == 8U) && port->Cmd.DDtr)) ? 2U : 1U;
+			sent = (uint64_t)port->Cmd.NbData * (Sim.Now - port->Start) / (port->Due - port->Start);
+			Sim_Execute(port, &port->Cmd, port->pData, (uint32_t)sent & ~(align - 1U), port->Start);
+		}
+	}
+
+	Sim_Cancel(port);
+	hospi->State = HAL_OSPI_STATE_READY;
+
+	return Sim_Leave(HAL_OK);
+}
+
+HAL_StatusTypeDef HAL_OSPI_DLYB_SetConfig(OSPI_HandleTypeDef *hospi, HAL_OSPI_DLYB_CfgTypeDef *pdlyb_cfg)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+
+	SET_BIT(port->Regs->DCR1, OCTOSPI_DCR1_FRCK);
+	hospi->State = HAL_OSPI_STATE_BUSY_CMD;
+	port->Dlyb->CR = DLYB_CR_DEN | DLYB_CR_SEN;
+	port->Dlyb->CFGR = (pdlyb_cfg->Units << DLYB_CFGR_UNIT_Pos) | pdlyb_cfg->PhaseSel;
+	port->Dlyb->CR = DLYB_CR_DEN;
+	port->Units = pdlyb_cfg->Units;
+	port->PhaseSel = pdlyb_cfg->PhaseSel;
+	(void)HAL_OSPI_Abort(hospi);
+	CLEAR_BIT(port->Regs->DCR1, OCTOSPI_DCR1_FRCK);
+
+	return Sim_Leave(HAL_OK);
+}
+
+/**
+ *  @brief Delay block length of one bus clock period, SIM_DLYB_CELL_PS per
+ * 		   unit and DLYB_MAX_SELECT cells.
+ */
+HAL_StatusTypeDef HAL_OSPI_DLYB_GetClockPeriod(OSPI_HandleTypeDef *hospi, HAL_OSPI_DLYB_CfgTypeDef *pdlyb_cfg)
+{
+	SIM_PortTypeDef *port = Sim_Enter(hospi);
+	uint64_t period = Sim_Clock_Ps(port);
+	uint64_t units = (period + DLYB_MAX_SELECT * SIM_DLYB_CELL_PS - 1U) / (DLYB_MAX_SELECT * SIM_DLYB_CELL_PS);
+	uint64_t phases;
+
+	SET_BIT(port->Regs->DCR1, OCTOSPI_DCR1_FRCK);
+	hospi->State = HAL_OSPI_STATE_BUSY_CMD;
+	units = (units == 0U) ? 0U : (units > DLYB_MAX_UNIT) ? DLYB_MAX_UNIT - 1U : units - 1U;
+	phases = period / ((units + 1U) * SIM_DLYB_CELL_PS);
+	pdlyb_cfg->Units = (uint32_t)units;
+	pdlyb_cfg->PhaseSel = (phases > DLYB_MAX_SELECT) ? DLYB_MAX_SELECT : (uint32_t)phases;
+	(void)HAL_OSPI_Abort(hospi);
+	CLEAR_BIT(port->Regs->DCR1, OCTOSPI_DCR1_FRCK);
+
+	return Sim_Leave(HAL_OK);
+}
+
+/* Callbacks of the ST HAL, overridden by the application -----------------*/
+
+__weak void HAL_OSPI_ErrorCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_AbortCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_FifoThresholdCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_CmdCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_RxCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_TxCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_RxHalfCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_TxHalfCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_TimeOutCallback(OSPI_HandleTypeDef *hospi)
+{
+	UNUSED(hospi);
+}
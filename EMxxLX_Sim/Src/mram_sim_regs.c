@@ -0,0 +1,482 @@
+/*
+ * mram_sim_regs.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Register level model of the OCTOSPI indirect read. The register page of
+ *  a port is protected, each access of the program faults: the faulting
+ *  instruction is decoded for its direction and width, SR and DR are
+ *  updated before a read, the instruction is single-stepped on the
+ *  unprotected page and a write is acted upon once done.
+ */
+
+#include "mram_sim_core.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <ucontext.h>
+
+#define SIM_PAGE_MASK				0xFFFUL
+#define SIM_EFLAGS_TF				0x100U // Trap flag, single step
+
+/** @defgroup SIM_Access SIM Access
+  * @{
+  */
+#define SIM_ACCESS_LOAD							0x01U // Register read
+#define SIM_ACCESS_STORE						0x02U // Register write
+#define SIM_ACCESS_RMW							(SIM_ACCESS_LOAD | SIM_ACCESS_STORE) // Read-modify-write
+/**
+  * @}
+  */
+
+typedef struct
+{
+  SIM_PortTypeDef *Port;						/*!< Port of the access being single-stepped */
+
+  uint32_t Offset;								/*!< Register offset */
+
+  uint8_t Access;								/*!< A value of @ref SIM_Access */
+} SIM_StepTypeDef;
+
+static uint8_t *Sim_Fifo[EMXXLX_SIM_PORTS];
+static uint32_t Sim_Fifo_Size[EMXXLX_SIM_PORTS];
+static SIM_StepTypeDef Sim_Step;
+static uint8_t Sim_Handlers;
+
+/**
+ *  @brief Fixed address of the registers of a port, as seen by the driver.
+ */
+static uintptr_t Sim_Registers_Base(SIM_PortTypeDef *Port)
+{
+	return (Port == &Sim.Port[0]) ? OCTOSPI1_R_BASE_NS : OCTOSPI2_R_BASE_NS;
+}
+
+static void Sim_Registers_Protect(SIM_PortTypeDef *Port, int Prot)
+{
+	if (mprotect((void *)(Sim_Registers_Base(Port) & ~SIM_PAGE_MASK), SIM_PAGE_MASK + 1U, Prot) != 0)
+	{
+		perror("emxxlx sim: register protection");
+		abort();
+	}
+}
+
+/**
+ *  @brief Direction and width of the memory operand of an x86-64
+ * 		   instruction, for the forms compilers use on volatile registers.
+ *  @retval Non zero when decoded
+ */
+static uint8_t Sim_Registers_Decode(const uint8_t *Code, uint8_t *Access, uint8_t *Width)
+{
+	uint8_t operand = 4;
+	uint8_t op;
+	uint8_t reg;
+
+	for (;; Code++)
+	{
+		if (*Code == 0x66U)
+		{
+			operand = 2;
+		}
+		else if ((*Code != 0xF0U) && (*Code != 0xF2U) && (*Code != 0xF3U) && (*Code != 0x2EU)
+				 && (*Code != 0x3EU) && (*Code != 0x26U) && (*Code != 0x36U) && (*Code != 0x64U)
+				 && (*Code != 0x65U) && (*Code != 0x67U))
+		{
+			break;
+		}
+	}
+
+	if ((*Code & 0xF0U) == 0x40U)
+	{
+		operand = ((*Code & 0x08U) != 0U) ? 8U : operand;
+		Code++;
+	}
+
+	op = Code[0];
+	reg = (Code[1] >> 3) & 0x07U;
+	if (op == 0x0FU)
+	{
+		*Access = SIM_ACCESS_LOAD;
+		*Width = ((Code[1] == 0xB6U) || (Code[1] == 0xBEU)) ? 1U : 2U;
+		return (Code[1] == 0xB6U) || (Code[1] == 0xBEU) || (Code[1] == 0xB7U) || (Code[1] == 0xBFU);
+	}
+
+	*Width = ((op & 0x01U) != 0U) ? operand : 1U;
+
+	/* ALU operations, r/m first or register first */
+	if ((op < 0x40U) && ((op & 0x07U) < 0x04U))
+	{
+		*Access = (((op & 0x02U) != 0U) || ((op & 0xF8U) == 0x38U)) ? SIM_ACCESS_LOAD : SIM_ACCESS_RMW;
+		return 1;
+	}
+
+	switch (op)
+	{
+	case 0x84:
+	case 0x85:
+	case 0x8A:
+	case 0x8B:
+		*Access = SIM_ACCESS_LOAD;
+		return 1;
+
+	case 0x88:
+	case 0x89:
+	case 0xC6:
+	case 0xC7:
+		*Access = SIM_ACCESS_STORE;
+		return 1;
+
+	case 0x80:
+	case 0x81:
+	case 0x83:
+		*Width = (op == 0x80U) ? 1U : operand;
+		*Access = (reg == 7U) ? SIM_ACCESS_LOAD : SIM_ACCESS_RMW;
+		return 1;
+
+	case 0xF6:
+	case 0xF7:
+		*Access = SIM_ACCESS_LOAD;
+		return reg <= 1U;
+
+	default:
+		return 0;
+	}
+}
+
+/**
+ *  @brief Arrival time of a byte of the indirect read.
+ * 	@param Index			Number of the byte, from 1.
+ */
+static uint64_t Sim_Indirect_Arrival(const SIM_IndirectTypeDef *Indirect, uint32_t Index)
+{
+	return Indirect->DataStart + Indirect->Stall + (Indirect->DataPs * Index) / Indirect->NbData;
+}
+
+/**
+ *  @brief Bring the FIFO and SR up to the simulated time.
+ */
+static void Sim_Indirect_Update(SIM_PortTypeDef *Port)
+{
+	SIM_IndirectTypeDef *indirect = &Port->Indirect;
+	uint32_t level;
+
+	if (!indirect->Active)
+	{
+		Port->Regs->SR &= ~(OCTOSPI_SR_FLEVEL | OCTOSPI_SR_FTF);
+		return;
+	}
+
+	while ((indirect->Received < indirect->NbData) && (indirect->Received - indirect->Consumed < SIM_FIFO_SIZE)
+		   && (Sim_Indirect_Arrival(indirect, indirect->Received + 1U) <= Sim.Now))
+	{
+		indirect->Received++;
+	}
+
+	level = indirect->Received - indirect->Consumed;
+	MODIFY_REG(Port->Regs->SR, OCTOSPI_SR_FLEVEL | OCTOSPI_SR_FTF | OCTOSPI_SR_BUSY,
+			   (level << OCTOSPI_SR_FLEVEL_Pos) | OCTOSPI_SR_BUSY);
+	if ((level > ((Port->Regs->CR & OCTOSPI_CR_FTHRES) >> OCTOSPI_CR_FTHRES_Pos))
+		|| ((level != 0U) && (indirect->Received == indirect->NbData)))
+	{
+		Port->Regs->SR |= OCTOSPI_SR_FTF;
+	}
+
+	/* Done once the last byte is read out */
+	if (indirect->Received == indirect->NbData)
+	{
+		Port->Regs->SR |= OCTOSPI_SR_TCF;
+		if (level == 0U)
+		{
+			indirect->Active = 0;
+			Port->Regs->SR &= ~OCTOSPI_SR_BUSY;
+		}
+	}
+}
+
+/**
+ *  @brief Start the indirect read programmed in the registers.
+ */
+static void Sim_Indirect_Start(SIM_PortTypeDef *Port)
+{
+	SIM_IndirectTypeDef *indirect = &Port->Indirect;
+	uint32_t p = (uint32_t)(Port - Sim.Port);
+	uint64_t tclk = Sim_Clock_Ps(Port);
+	SIM_CmdTypeDef cmd;
+	uint32_t cycles;
+
+	if ((Port->Regs->CR & OCTOSPI_CR_FMODE) != OCTOSPI_CR_FMODE_0)
+	{
+		fprintf(stderr, "emxxlx sim: OCTOSPI%u command started from the registers outside indirect read\n",
+				(unsigned)p + 1U);
+		abort();
+	}
+
+	Sim_Decode(Port, &cmd);
+	if ((cmd.DLines == 0U) || (Sim_Check(Port, &cmd) != HAL_OSPI_ERROR_NONE))
+	{
+		Port->Regs->SR |= OCTOSPI_SR_TEF;
+		return;
+	}
+
+	if (Sim_Fifo_Size[p] < cmd.NbData)
+	{
+		Sim_Fifo[p] = realloc(Sim_Fifo[p], cmd.NbData);
+		Sim_Fifo_Size[p] = cmd.NbData;
+		if (Sim_Fifo[p] == NULL)
+		{
+			abort();
+		}
+	}
+
+	Sim_Execute(Port, &cmd, Sim_Fifo[p], cmd.NbData, Sim.Now);
+	cycles = Sim_Cycles(Port, &cmd, 0);
+	indirect->Active = 1;
+	indirect->NbData = cmd.NbData;
+	indirect->Received = 0;
+	indirect->Consumed = 0;
+	indirect->Stall = 0;
+	indirect->DataStart = Sim.Now + cycles * tclk;
+	indirect->DataPs = (Sim_Cycles(Port, &cmd, cmd.NbData) - cycles) * tclk;
+	Port->Regs->SR &= ~OCTOSPI_SR_TCF;
+}
+
+/**
+ *  @brief DR read: the bytes are taken from the FIFO, the bus access waits
+ * 		   until they arrived.
+ */
+static void Sim_Indirect_Read(SIM_PortTypeDef *Port, uint8_t Width)
+{
+	SIM_IndirectTypeDef *indirect = &Port->Indirect;
+	uint8_t *dr = (uint8_t *)&Port->Regs->DR;
+	uint32_t wanted;
+	uint32_t count;
+
+	memset(dr, 0, sizeof(Port->Regs->DR));
+	if (!indirect->Active)
+	{
+		return;
+	}
+
+	wanted = indirect->Consumed + Width;
+	wanted = (wanted > indirect->NbData) ? indirect->NbData : wanted;
+	if (indirect->Received < wanted)
+	{
+		Sim.Now = Sim_Indirect_Arrival(indirect, wanted);
+		Sim_Indirect_Update(Port);
+	}
+
+	/* The clock restarts once the full FIFO is read */
+	if ((indirect->Received - indirect->Consumed == SIM_FIFO_SIZE) && (indirect->Received < indirect->NbData)
+		&& (Sim_Indirect_Arrival(indirect, indirect->Received + 1U) < Sim.Now))
+	{
+		indirect->Stall += Sim.Now - Sim_Indirect_Arrival(indirect, indirect->Received + 1U);
+	}
+
+	count = indirect->Received - indirect->Consumed;
+	count = (count > Width) ? Width : count;
+	memcpy(dr, Sim_Fifo[Port - Sim.Port] + indirect->Consumed, count);
+	indirect->Consumed += count;
+	Sim_Indirect_Update(Port);
+}
+
+/**
+ *  @brief Register read, before the instruction.
+ */
+static void Sim_Registers_Load(SIM_PortTypeDef *Port, uint32_t Offset, uint8_t Width)
+{
+	Sim_Indirect_Update(Port);
+	if (Offset == offsetof(OCTOSPI_TypeDef, DR))
+	{
+		Sim_Indirect_Read(Port, Width);
+	}
+}
+
+/**
+ *  @brief Register write, once the instruction is done.
+ */
+static void Sim_Registers_Store(SIM_PortTypeDef *Port, uint32_t Offset)
+{
+	OCTOSPI_TypeDef *regs = Port->Regs;
+
+	switch (Offset)
+	{
+	case offsetof(OCTOSPI_TypeDef, CR):
+		if ((regs->CR & OCTOSPI_CR_ABORT) != 0U)
+		{
+			Port->Indirect.Active = 0;
+			regs->CR &= ~OCTOSPI_CR_ABORT;
+			regs->SR &= ~OCTOSPI_SR_BUSY;
+		}
+		break;
+
+	case offsetof(OCTOSPI_TypeDef, FCR):
+		regs->SR &= ~(regs->FCR & (OCTOSPI_FCR_CTEF | OCTOSPI_FCR_CTCF | OCTOSPI_FCR_CSMF | OCTOSPI_FCR_CTOF));
+		regs->FCR = 0;
+		break;
+
+	case offsetof(OCTOSPI_TypeDef, AR):
+		if ((regs->CCR & OCTOSPI_CCR_ADMODE) != 0U)
+		{
+			Sim_Indirect_Start(Port);
+		}
+		break;
+
+	case offsetof(OCTOSPI_TypeDef, IR):
+		if ((regs->CCR & OCTOSPI_CCR_ADMODE) == 0U)
+		{
+			Sim_Indirect_Start(Port);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	Sim_Indirect_Update(Port);
+}
+
+/**
+ *  @brief Access to a protected register page: the registers are brought
+ * 		   up to date and the instruction is single-stepped.
+ */
+static void Sim_Registers_Fault(int Signal, siginfo_t *Info, void *Context)
+{
+	ucontext_t *context = Context;
+	uintptr_t address = (uintptr_t)Info->si_addr;
+	SIM_PortTypeDef *port = NULL;
+	uint8_t access;
+	uint8_t width;
+
+	for (uint32_t p = 0; p < EMXXLX_SIM_PORTS; p++)
+	{
+		uintptr_t base = Sim_Registers_Base(&Sim.Port[p]);
+
+		if (Sim.Port[p].Trap && (address >= base) && (address < base + sizeof(OCTOSPI_TypeDef)))
+		{
+			port = &Sim.Port[p];
+		}
+	}
+
+	if (port == NULL)
+	{
+		signal(SIGSEGV, SIG_DFL);
+		return;
+	}
+
+	if (!Sim_Registers_Decode((const uint8_t *)context->uc_mcontext.gregs[REG_RIP], &access, &width))
+	{
+		fprintf(stderr, "emxxlx sim: register access not decoded at %p\n",
+				(void *)context->uc_mcontext.gregs[REG_RIP]);
+		abort();
+	}
+
+	/* Kept nested until the single step is over, no interrupt in between */
+	Sim.Depth++;
+	if (port->Indirect.Active && (port->Indirect.Received < port->Indirect.NbData))
+	{
+		/* Waiting for data is progress, the tick does not jump */
+		Sim.Calls++;
+	}
+	Sim.Now += Sim.Timing.RegNs * SIM_PS_PER_NS;
+	Sim_Step.Port = port;
+	Sim_Step.Offset = (uint32_t)(address - Sim_Registers_Base(port)) & ~3U;
+	Sim_Step.Access = access;
+	if ((access & SIM_ACCESS_LOAD) != 0U)
+	{
+		Sim_Registers_Load(port, Sim_Step.Offset, width);
+	}
+
+	Sim_Registers_Protect(port, PROT_READ | PROT_WRITE);
+	context->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+
+/**
+ *  @brief End of the single step.
+ */
+static void Sim_Registers_Trap(int Signal, siginfo_t *Info, void *Context)
+{
+	ucontext_t *context = Context;
+
+	context->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)SIM_EFLAGS_TF;
+	if (Sim_Step.Port == NULL)
+	{
+		return;
+	}
+
+	if ((Sim_Step.Access & SIM_ACCESS_STORE) != 0U)
+	{
+		Sim_Registers_Store(Sim_Step.Port, Sim_Step.Offset);
+	}
+
+	if (Sim_Step.Port->Trap)
+	{
+		Sim_Registers_Protect(Sim_Step.Port, PROT_NONE);
+	}
+	Sim_Step.Port = NULL;
+	Sim.Depth--;
+}
+
+/**
+ *  @brief Registers released, before a simulator reset.
+ */
+void Sim_Registers_Reset(void)
+{
+	for (uint32_t p = 0; p < EMXXLX_SIM_PORTS; p++)
+	{
+		if (Sim.Port[p].Trap)
+		{
+			Sim_Registers_Protect(&Sim.Port[p], PROT_READ | PROT_WRITE);
+		}
+	}
+}
+
+/**
+ *  @brief Trap the accesses of the program to the OCTOSPI registers of a
+ * 		   port, for the indirect reads programmed without the HAL.
+ * 	@param Port				OCTOSPI instance, 1 or 2.
+ *  @param Enable			Non zero to trap the accesses.
+ *  @retval HAL_OK, HAL_ERROR when the host does not support it
+ */
+uint8_t EMXXLX_Sim_Registers(uint8_t Port, uint8_t Enable)
+{
+	SIM_PortTypeDef *port = &Sim.Port[Port - 1U];
+	struct sigaction action = { 0 };
+
+	if (!Sim_Handlers)
+	{
+		action.sa_sigaction = Sim_Registers_Fault;
+		action.sa_flags = SA_SIGINFO;
+		sigemptyset(&action.sa_mask);
+		sigaction(SIGSEGV, &action, NULL);
+		action.sa_sigaction = Sim_Registers_Trap;
+		sigaction(SIGTRAP, &action, NULL);
+		Sim_Handlers = 1;
+	}
+
+	SIM_ENTER();
+	port->Trap = Enable != 0U;
+	memset(&port->Indirect, 0, sizeof(port->Indirect));
+	Sim_Registers_Protect(port, port->Trap ? PROT_NONE : (PROT_READ | PROT_WRITE));
+	SIM_LEAVE();
+
+	return HAL_OK;
+}
+
+#else
+
+void Sim_Registers_Reset(void)
+{
+}
+
+uint8_t EMXXLX_Sim_Registers(uint8_t Port, uint8_t Enable)
+{
+	UNUSED(Port);
+
+	return (Enable != 0U) ? HAL_ERROR : HAL_OK;
+}
+
+#endif /* __x86_64__ && __linux__ */
@@ -0,0 +1,295 @@
+/*
+ * mram_trace.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host decoder of the driver command trace, see Inc/mram_trace.h. Built
+ *  with EMXXLX_USE_TRACE for the layout of EMXXLX_TraceTypeDef, the number
+ *  of entries is taken from the dump.
+ */
+
+#include "mram_trace.h"
+#include "mram.h"
+
+#include <string.h>
+
+#if !defined(EMXXLX_USE_TRACE)
+#error "mram_trace.c needs EMXXLX_USE_TRACE"
+#endif
+
+#define TRACE_HEADER_SIZE			offsetof(EMXXLX_TraceTypeDef, Entry)
+
+/**
+ *  @brief Put the entries of a trace dump back in order, oldest first, and
+ * 		   sum them per port and per opcode.
+ * 	@param pDump			Raw copy of EMXXLX_Trace.
+ *  @param Size				Size of the dump in bytes.
+ *  @param pEvents			Destination of the entries, can be NULL for the summary only.
+ *  @param MaxEvents		Size of pEvents, the newest entries are kept.
+ *  @param Summary			Destination of the summary.
+ *  @retval HAL status, HAL_ERROR if the dump is not an initialized trace
+ */
+uint8_t EMXXLX_Trace_Decode(const void *pDump, size_t Size, EMXXLX_TRACE_EventTypeDef *pEvents,
+							uint32_t MaxEvents, EMXXLX_TRACE_SummaryTypeDef *Summary)
+{
+	const uint8_t *dump = (const uint8_t *)pDump;
+	EMXXLX_TraceTypeDef header;
+	EMXXLX_TraceEntryTypeDef entry;
+	uint64_t cycle = 0;
+	uint32_t first, last = 0;
+
+	memset(Summary, 0, sizeof(*Summary));
+	if ((dump == NULL) || (Size < TRACE_HEADER_SIZE))
+	{
+		return HAL_ERROR;
+	}
+
+	memcpy(&header, dump, TRACE_HEADER_SIZE);
+	if ((header.Magic != EMXXLX_TRACE_MAGIC) || (header.EntrySize != sizeof(EMXXLX_TraceEntryTypeDef))
+		|| (header.Entries == 0U) || ((header.Entries & (header.Entries - 1U)) != 0U)
+		|| ((Size - TRACE_HEADER_SIZE) / header.EntrySize < header.Entries))
+	{
+		return HAL_ERROR;
+	}
+
+	Summary->Logged = header.Head;
+	Summary->Count = (header.Head < header.Entries) ? header.Head : header.Entries;
+	if ((pEvents != NULL) && (Summary->Count > MaxEvents))
+	{
+		Summary->Count = MaxEvents;
+	}
+	Summary->Lost = header.Head - Summary->Count;
+
+	first = header.Head - Summary->Count;
+	for (uint32_t i = 0; i < Summary->Count; i++)
+	{
+		EMXXLX_TRACE_PortTypeDef *port;
+
+		memcpy(&entry, dump + TRACE_HEADER_SIZE
+			   + (size_t)((first + i) % header.Entries) * header.EntrySize, sizeof(entry));
+
+		/* Entries are less than one counter period apart */
+		if (i != 0U)
+		{
+			cycle += (uint32_t)(entry.Timestamp - last);
+		}
+		last = entry.Timestamp;
+
+		if (pEvents != NULL)
+		{
+			pEvents[i].Cycle = cycle;
+			pEvents[i].Address = entry.Address;
+			pEvents[i].NbData = entry.NbData;
+			pEvents[i].Instruction = entry.Instruction;
+			pEvents[i].Port = entry.Port;
+			pEvents[i].Mode = entry.Mode;
+		}
+
+		Summary->OpCommands[entry.Instruction]++;
+		Summary->OpBytes[entry.Instruction] += entry.NbData;
+		if ((entry.Port == 0U) || (entry.Port > EMXXLX_TRACE_PORTS))
+		{
+			continue;
+		}
+
+		port = &Summary->Port[entry.Port - 1U];
+		if (port->Commands == 0U)
+		{
+			port->FirstCycle = cycle;
+		}
+		port->Commands++;
+		port->LastCycle = cycle;
+		if (EMXXLX_Trace_IsWrite(entry.Instruction))
+		{
+			port->BytesWritten += entry.NbData;
+		}
+		else
+		{
+			port->BytesRead += entry.NbData;
+		}
+	}
+	Summary->Cycles = cycle;
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Direction of the data phase of a command.
+ *  @retval Non zero when the data phase is sent to the device
+ */
+uint8_t EMXXLX_Trace_IsWrite(uint8_t Instruction)
+{
+	switch (Instruction)
+	{
+	case MRAM_WRITE_STATUS_CMD:
+	case MRAM_WRITE_NONVOL_CMD:
+	case MRAM_WRITE_VOL_CMD:
+	case MRAM_WRITE_CMD:
+	case MRAM_WRITE_DUAL_CMD:
+	case MRAM_WRITE_DUAL_E_CMD:
+	case MRAM_WRITE_QUAD_CMD:
+	case MRAM_WRITE_QUAD_E_CMD:
+	case MRAM_WRITE_OCTO_CMD:
+	case MRAM_WRITE_OCTO_E_CMD:
+	case MRAM_OTP_WRITE_CMD:
+	case MRAM_4BADD_WRITE_CMD:
+	case MRAM_4BADD_WRITE_QUAD_CMD:
+	case MRAM_4BADD_WRITE_QUAD_E_CMD:
+	case MRAM_4BADD_WRITE_OCTO_CMD:
+	case MRAM_4BADD_WRITE_OCTO_E_CMD:
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+/**
+ *  @brief Short name of the commands issued by the driver.
+ *  @retval Name, "?" for an unknown opcode
+ */
+const char *EMXXLX_Trace_Name(uint8_t Instruction)
+{
+	switch (Instruction)
+	{
+	case MRAM_WRITE_ENABLE_CMD:			return "WREN";
+	case MRAM_WRITE_DISABLE_CMD:		return "WRDI";
+	case MRAM_WRITE_STATUS_CMD:			return "WRSR";
+	case MRAM_WRITE_NONVOL_CMD:			return "WRNV";
+	case MRAM_WRITE_VOL_CMD:			return "WRVR";
+	case MRAM_READ_STATUS_REG_CMD:		return "RDSR";
+	case MRAM_READ_FLAGS_CMD:			return "RDFSR";
+	case MRAM_CLR_FLAGS_CMD:			return "CLFSR";
+	case MRAM_READ_NONVOL_CMD:			return "RDNV";
+	case MRAM_READ_VOL_CMD:				return "RDVR";
+	case MRAM_READ_ID_CMD:				return "RDID";
+	case MRAM_READ_ID_MULTIPLE_IO_CMD:	return "MIORDID";
+	case MRAM_RESET_ENABLE_CMD:			return "RSTEN";
+	case MRAM_RESET_CMD:				return "RST";
+	case MRAM_DPD_ENTER_CMD:			return "DPD";
+	case MRAM_DPD_EXIT_CMD:				return "RDPD";
+	case MRAM_ERASE_4kB_SECTOR_CMD:		return "ERASE4K";
+	case MRAM_ERASE_32kB_SECTOR_CMD:	return "ERASE32K";
+	case MRAM_ERASE_SECTOR_CMD:			return "ERASE64K";
+	case MRAM_ERASE_CHIP_CMD:			return "ERASECHIP";
+	case MRAM_4BADD_ERASE_SECTOR_4kB_CMD:	return "ERASE4K";
+	case MRAM_4BADD_ERASE_SECTOR_32kB_CMD:	return "ERASE32K";
+	case MRAM_4BADD_ERASE_SECTOR_CMD:	return "ERASE64K";
+	case MRAM_READ_CMD:
+	case MRAM_READ_FAST_CMD:
+	case MRAM_READ_DUAL_O_CMD:
+	case MRAM_READ_DUAL_IO_CMD:
+	case MRAM_READ_QUAD_O_CMD:
+	case MRAM_READ_QUAD_IO_CMD:
+	case MRAM_READ_OCTO_O_CMD:
+	case MRAM_READ_OCTO_IO_CMD:
+	case MRAM_READ_DTR_CMD:
+	case MRAM_READ_DTR_DUAL_O_CMD:
+	case MRAM_READ_DTR_DUAL_IO_CMD:
+	case MRAM_READ_DTR_QUAD_O_CMD:
+	case MRAM_READ_DTR_QUAD_IO_CMD:
+	case MRAM_READ_WORD_QUAD_IO_CMD:
+	case MRAM_READ_DTR_OCTO_O_CMD:
+	case MRAM_READ_DTR_OCTO_IO_CMD:
+	case MRAM_4BADD_READ_CMD:
+	case MRAM_4BADD_READ_FAST_CMD:
+	case MRAM_4BADD_READ_DUAL_O_CMD:
+	case MRAM_4BADD_READ_DUAL_IO_CMD:
+	case MRAM_4BADD_READ_QUAD_O_CMD:
+	case MRAM_4BADD_READ_QUAD_IO_CMD:
+	case MRAM_4BADD_READ_OCTO_O_CMD:
+	case MRAM_4BADD_READ_OCTO_IO_CMD:
+	case MRAM_4BADD_READ_DTR_CMD:
+	case MRAM_4BADD_READ_DTR_DUAL_IO_CMD:
+	case MRAM_4BADD_READ_DTR_QUAD_IO_CMD:
+		return "READ";
+	case MRAM_WRITE_CMD:
+	case MRAM_WRITE_DUAL_CMD:
+	case MRAM_WRITE_DUAL_E_CMD:
+	case MRAM_WRITE_QUAD_CMD:
+	case MRAM_WRITE_QUAD_E_CMD:
+	case MRAM_WRITE_OCTO_CMD:
+	case MRAM_WRITE_OCTO_E_CMD:
+	case MRAM_4BADD_WRITE_CMD:
+	case MRAM_4BADD_WRITE_QUAD_CMD:
+	case MRAM_4BADD_WRITE_QUAD_E_CMD:
+	case MRAM_4BADD_WRITE_OCTO_CMD:
+	case MRAM_4BADD_WRITE_OCTO_E_CMD:
+		return "WRITE";
+	default:
+		return "?";
+	}
+}
+
+/**
+ *  @brief Lines of one phase of a trace mode, '0' when the phase is absent.
+ */
+static char EMXXLX_Trace_Lines(uint16_t Mode, uint32_t Pos)
+{
+	static const char lines[8] = { '0', '1', '2', '4', '8', '?', '?', '?' };
+
+	return lines[(Mode >> Pos) & 0x7U];
+}
+
+/**
+ *  @brief Print the timeline of the decoded entries, then the summary per
+ * 		   port and per opcode.
+ * 	@param Out				Output stream.
+ *  @param pEvents			Entries of EMXXLX_Trace_Decode, can be NULL for the summary only.
+ *  @param Summary			Summary of EMXXLX_Trace_Decode.
+ *  @param CpuHz			Frequency of the DWT cycle counter.
+ */
+void EMXXLX_Trace_Print(FILE *Out, const EMXXLX_TRACE_EventTypeDef *pEvents,
+						const EMXXLX_TRACE_SummaryTypeDef *Summary, uint32_t CpuHz)
+{
+	double us = 1e6 / CpuHz;
+
+	fprintf(Out, "%u commands logged, %u decoded, %u overwritten\n", (unsigned)Summary->Logged,
+			(unsigned)Summary->Count, (unsigned)Summary->Lost);
+
+	if (pEvents != NULL)
+	{
+		fprintf(Out, "%12s %4s %4s %-9s %10s %8s %s\n", "time us", "port", "op", "name", "address",
+				"bytes", "mode");
+		for (uint32_t i = 0; i < Summary->Count; i++)
+		{
+			const EMXXLX_TRACE_EventTypeDef *event = &pEvents[i];
+
+			fprintf(Out, "%12.3f %4u   %02X %-9s 0x%08X %8u %c-%c-%c%s%s%s\n", event->Cycle * us,
+					(unsigned)event->Port, (unsigned)event->Instruction, EMXXLX_Trace_Name(event->Instruction),
+					(unsigned)event->Address, (unsigned)event->NbData,
+					EMXXLX_Trace_Lines(event->Mode, EMXXLX_TRACE_IMODE_Pos),
+					EMXXLX_Trace_Lines(event->Mode, EMXXLX_TRACE_ADMODE_Pos),
+					EMXXLX_Trace_Lines(event->Mode, EMXXLX_TRACE_DMODE_Pos),
+					((event->Mode & EMXXLX_TRACE_DTR) != 0U) ? " DTR" : "",
+					((event->Mode & EMXXLX_TRACE_DQS) != 0U) ? " DQS" : "",
+					((event->Mode & EMXXLX_TRACE_DUALQUAD) != 0U) ? " dual-quad" : "");
+		}
+	}
+
+	fprintf(Out, "\n%4s %8s %12s %12s %12s %10s\n", "port", "commands", "read", "written", "span us", "MB/s");
+	for (uint32_t p = 0; p < EMXXLX_TRACE_PORTS; p++)
+	{
+		const EMXXLX_TRACE_PortTypeDef *port = &Summary->Port[p];
+		uint64_t span = port->LastCycle - port->FirstCycle;
+
+		if (port->Commands == 0U)
+		{
+			continue;
+		}
+
+		fprintf(Out, "%4u %8u %12llu %12llu %12.3f %10.2f\n", (unsigned)p + 1U, (unsigned)port->Commands,
+				(unsigned long long)port->BytesRead, (unsigned long long)port->BytesWritten, span * us,
+				(span != 0U) ? (port->BytesRead + port->BytesWritten) / (span * us) : 0.0);
+	}
+
+	fprintf(Out, "\n%4s %-9s %8s %12s\n", "op", "name", "commands", "bytes");
+	for (uint32_t op = 0; op < 256U; op++)
+	{
+		if (Summary->OpCommands[op] != 0U)
+		{
+			fprintf(Out, "  %02X %-9s %8u %12llu\n", (unsigned)op, EMXXLX_Trace_Name((uint8_t)op),
+					(unsigned)Summary->OpCommands[op], (unsigned long long)Summary->OpBytes[op]);
+		}
+	}
+}
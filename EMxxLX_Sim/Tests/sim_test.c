@@ -0,0 +1,101 @@
+/*
+ * sim_test.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "sim_test.h"
+
+uint32_t Sim_Test_Failed;
+
+static uint32_t Sim_Test_Count;
+static uint32_t Sim_Test_Failures;
+
+/**
+ *  @brief Run one test on a reset simulator and print its result.
+ * 	@param Name				Test name.
+ *  @param Test				Test function.
+ */
+void Sim_Test_Run(const char *Name, void (*Test)(void))
+{
+	EMXXLX_Sim_Reset();
+	MX_OCTOSPI1_Init();
+	MX_OCTOSPI2_Init();
+
+	Sim_Test_Failed = 0;
+	Test();
+	Sim_Test_Count++;
+	Sim_Test_Failures += Sim_Test_Failed;
+	printf("%s %s\n", (Sim_Test_Failed != 0U) ? "FAIL" : "ok  ", Name);
+}
+
+/**
+ *  @brief Print the summary of the tests run.
+ *  @retval Exit status of the test program, 0 when every test passed.
+ */
+int Sim_Test_Report(void)
+{
+	printf("%lu tests, %lu failed\n", (unsigned long)Sim_Test_Count, (unsigned long)Sim_Test_Failures);
+	return (Sim_Test_Failures != 0U) ? 1 : 0;
+}
+
+/**
+ *  @brief Configuration of the example in main.c, in the given device
+ * 		   interface mode.
+ * 	@param SpiInterfaceMode	Device interface mode, see the Interface Mode Values.
+ *  @retval Device configuration
+ */
+EMXXLX_ConfigurationTypeDef Sim_Test_Config(uint8_t SpiInterfaceMode)
+{
+	EMXXLX_ConfigurationTypeDef config = { 0 };
+
+	config.SpiInterfaceMode = SpiInterfaceMode;
+	config.DummyCycles = MRAM_DEFAULT_DC;
+	config.DriverStrenght = MRAM_50_DRIVER_STR;
+	config.AddedDsDelay = MRAM_0_ADDED_DELAY;
+	config.AddressMode = MRAM_ADDRESS_BYTES_4;
+	config.XIPConfiguration = MRAM_XIP_DISABLE;
+	config.WrapConfiguration = MRAM_CONTINUOUS_WRAP;
+	config.EraseBitValue = MRAM_ERASE_VALUE_1;
+	config.ResetPinEnable = MRAM_RESET_ENABLE;
+	config.WriteMode = MRAM_NONVOLATILE;
+	config.OtpLockEnable = MRAM_OTPLOCK_ENABLE;
+	return config;
+}
+
+/**
+ *  @brief Fill a buffer with a pseudo-random pattern.
+ * 	@param pData			Buffer.
+ *  @param Size				Amount of bytes.
+ *  @param Seed				Pattern seed, the same seed gives the same pattern.
+ */
+void Sim_Test_Pattern(uint8_t *pData, uint32_t Size, uint32_t Seed)
+{
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		Seed = Seed * 1103515245U + 12345U;
+		pData[i] = (uint8_t)(Seed >> 16);
+	}
+}
+
+/**
+ *  @brief Spin on the HAL tick as a main loop would, until the background
+ * 		   transfer of a device is over.
+ * 	@param hmram			MRAM device handle.
+ *  @param Timeout			Timeout in ms of simulated time.
+ *  @retval HAL_OK once idle, HAL_TIMEOUT otherwise
+ */
+uint8_t Sim_Test_Wait(EMXXLX_HandleTypeDef *hmram, uint32_t Timeout)
+{
+	uint32_t tickstart = HAL_GetTick();
+
+	while (EMXXLX_Get_XferState(hmram) != EMXXLX_XFER_IDLE)
+	{
+		if ((HAL_GetTick() - tickstart) > Timeout)
+		{
+			return HAL_TIMEOUT;
+		}
+	}
+
+	return HAL_OK;
+}
@@ -0,0 +1,61 @@
+/*
+ * sim_test.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Runner of the host tests. Every test starts from a reset simulator with
+ *  the OCTOSPI instances initialized as on the board, a failed check prints
+ *  its location and ends the test.
+ */
+
+#include "mram_sim.h"
+#include "mram.h"
+
+#include <stdio.h>
+
+#ifndef TESTS_SIM_TEST_H_
+#define TESTS_SIM_TEST_H_
+
+extern uint32_t Sim_Test_Failed;
+
+/**
+  * @brief Fail the running test when Cond does not hold.
+  */
+#define SIM_CHECK(Cond) \
+	do \
+	{ \
+		if (!(Cond)) \
+		{ \
+			printf("  %s:%d: %s\n", __FILE__, __LINE__, #Cond); \
+			Sim_Test_Failed = 1; \
+			return; \
+		} \
+	} while (0)
+
+/**
+  * @brief Fail the running test when Actual differs from Expected.
+  */
+#define SIM_CHECK_EQ(Actual, Expected) \
+	do \
+	{ \
+		unsigned long long actual_ = (unsigned long long)(Actual); \
+		unsigned long long expected_ = (unsigned long long)(Expected); \
+		if (actual_ != expected_) \
+		{ \
+			printf("  %s:%d: %s is 0x%llX, expected 0x%llX\n", __FILE__, __LINE__, #Actual, \
+				   actual_, expected_); \
+			Sim_Test_Failed = 1; \
+			return; \
+		} \
+	} while (0)
+
+#define SIM_RUN(Test)		Sim_Test_Run(#Test, Test)
+
+/* Functions */
+void Sim_Test_Run(const char *Name, void (*Test)(void));
+int Sim_Test_Report(void);
+EMXXLX_ConfigurationTypeDef Sim_Test_Config(uint8_t SpiInterfaceMode);
+void Sim_Test_Pattern(uint8_t *pData, uint32_t Size, uint32_t Seed);
+uint8_t Sim_Test_Wait(EMXXLX_HandleTypeDef *hmram, uint32_t Timeout);
+
+#endif /* TESTS_SIM_TEST_H_ */
@@ -0,0 +1,257 @@
+/*
+ * test_async.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the interrupt driven transfers. The automatic delivery of
+ *  the simulator is turned off and every OCTOSPI interrupt is taken with
+ *  EMXXLX_Sim_Step, so that the state machine is checked after each one.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_ADDRESS				0x020000U // Start of the transfers
+#define TEST_SIZE					300U
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[EMXXLX_ERASE_64KB + EMXXLX_ERASE_4KB];
+static uint8_t Test_Check[EMXXLX_ERASE_64KB + EMXXLX_ERASE_4KB];
+static uint32_t Test_Calls;
+static uint8_t Test_Status;
+static void *Test_Context;
+
+static void Test_Callback(EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context)
+{
+	Test_Calls++;
+	Test_Status = Status;
+	Test_Context = Context;
+}
+
+/**
+ *  @brief Device in octal mode with known data, interrupts taken by hand.
+ */
+static uint8_t Test_Setup(void)
+{
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	if (EMXXLX_Init(&hmram, Sim_Test_Config(MRAM_OSPI_W_DS), 8) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	Sim_Test_Pattern(Test_Buffer, sizeof(Test_Buffer), 1);
+	EMXXLX_Sim_Poke(1, 0, TEST_ADDRESS, Test_Buffer, sizeof(Test_Buffer));
+	memset(Test_Check, 0, sizeof(Test_Check));
+	Test_Calls = 0;
+	Test_Status = HAL_BUSY;
+	Test_Context = NULL;
+	EMXXLX_Sim_AutoIrq(0);
+	return HAL_OK;
+}
+
+/**
+ *  @brief A read is one receive interrupt, the buffer is only filled then.
+ */
+static void Test_Read_Steps(void)
+{
+	uint8_t context;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_ReadAsync(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE, Test_Callback, &context), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_RX_IT);
+	SIM_CHECK(EMXXLX_Sim_Pending(1));
+	SIM_CHECK_EQ(Test_Check[0] | Test_Check[TEST_SIZE - 1U], 0);
+	SIM_CHECK_EQ(EMXXLX_ReadAsync(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE, Test_Callback, NULL), HAL_BUSY);
+
+	SIM_CHECK(EMXXLX_Sim_Step());
+	SIM_CHECK_EQ(Test_Calls, 1);
+	SIM_CHECK_EQ(Test_Status, HAL_OK);
+	SIM_CHECK(Test_Context == &context);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_IDLE);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+	SIM_CHECK(!EMXXLX_Sim_Step());
+}
+
+/**
+ *  @brief A write goes through its write enable, data phase and ready poll,
+ * 		   one interrupt each.
+ */
+static void Test_Write_Steps(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	EMXXLX_SIM_RegsTypeDef regs;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 2);
+
+	/* Longer than the interrupt handling */
+	EMXXLX_Sim_GetTiming(&timing);
+	timing.WriteNs = 20000;
+	EMXXLX_Sim_SetTiming(&timing);
+
+	SIM_CHECK_EQ(EMXXLX_WriteAsync(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_TX_IT);
+	SIM_CHECK_EQ(hmram.XferStep, EMXXLX_STEP_WEL);
+
+	/* Write enable sent, the data phase is started */
+	SIM_CHECK(EMXXLX_Sim_Step());
+	SIM_CHECK_EQ(hmram.XferStep, EMXXLX_STEP_DATA);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Wel, 1);
+	EMXXLX_Sim_Peek(1, 0, TEST_ADDRESS, Test_Check, TEST_SIZE);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) != 0);
+
+	/* Data sent, the device is busy and polled */
+	SIM_CHECK(EMXXLX_Sim_Step());
+	SIM_CHECK_EQ(hmram.XferStep, EMXXLX_STEP_READY);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Busy, 1);
+	EMXXLX_Sim_Peek(1, 0, TEST_ADDRESS, Test_Check, TEST_SIZE);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+	SIM_CHECK_EQ(Test_Calls, 0);
+
+	/* Ready */
+	SIM_CHECK(EMXXLX_Sim_Step());
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Busy, 0);
+	SIM_CHECK_EQ(Test_Calls, 1);
+	SIM_CHECK_EQ(Test_Status, HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_IDLE);
+	SIM_CHECK(!EMXXLX_Sim_Step());
+}
+
+/**
+ *  @brief A background erase takes the largest blocks first, three
+ * 		   interrupts per block, and reports its progress in between.
+ */
+static void Test_Erase_Steps(void)
+{
+	uint32_t size = EMXXLX_ERASE_64KB + EMXXLX_ERASE_4KB;
+	uint32_t steps = 0;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_EraseAsync(&hmram, TEST_ADDRESS, size, HAL_MAX_DELAY, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_ERASE_IT);
+	while (EMXXLX_Sim_Step())
+	{
+		steps++;
+		if (steps == 3U)
+		{
+			SIM_CHECK_EQ(EMXXLX_Erase_Progress(&hmram), EMXXLX_ERASE_64KB);
+		}
+	}
+
+	SIM_CHECK_EQ(steps, 6);
+	SIM_CHECK_EQ(EMXXLX_Erase_Progress(&hmram), size);
+	SIM_CHECK_EQ(Test_Calls, 1);
+	SIM_CHECK_EQ(Test_Status, HAL_OK);
+
+	memset(Test_Buffer, 0xFF, size);
+	EMXXLX_Sim_Peek(1, 0, TEST_ADDRESS, Test_Check, size);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, size) == 0);
+}
+
+/**
+ *  @brief The ready poll of a device busy writing ends once it is ready.
+ */
+static void Test_Poll_Steps(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	uint64_t t0;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	EMXXLX_Sim_GetTiming(&timing);
+	timing.NvolWriteNs = 2000000;
+	EMXXLX_Sim_SetTiming(&timing);
+
+	Test_Buffer[0] = MRAM_25_DRIVER_STR;
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	t0 = EMXXLX_Sim_Now_ns();
+	SIM_CHECK_EQ(EMXXLX_Write_Nonvol(&hmram, 3, Test_Buffer, 1), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_Polling_MemReady_IT(&hmram, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_POLL_IT);
+	SIM_CHECK(EMXXLX_Sim_Step());
+	SIM_CHECK_EQ(Test_Calls, 1);
+	SIM_CHECK(EMXXLX_Sim_Now_ns() - t0 >= timing.NvolWriteNs);
+}
+
+/**
+ *  @brief An abort between two interrupts ends the write with an error and
+ * 		   leaves the OCTOSPI ready for the next command.
+ */
+static void Test_Abort(void)
+{
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_WriteAsync(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK(EMXXLX_Sim_Step());
+	SIM_CHECK_EQ(EMXXLX_Abort(&hmram), HAL_OK);
+	SIM_CHECK_EQ(Test_Calls, 1);
+	SIM_CHECK_EQ(Test_Status, HAL_ERROR);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_IDLE);
+	SIM_CHECK(!EMXXLX_Sim_Pending(1));
+
+	/* Part of the data phase may have been sent, the device is then busy writing it */
+	SIM_CHECK_EQ(EMXXLX_Polling_MemReady(&hmram, 10), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+}
+
+/**
+ *  @brief Nothing is delivered while the interrupts are masked.
+ */
+static void Test_Masked(void)
+{
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	EMXXLX_Sim_AutoIrq(1);
+
+	__disable_irq();
+	SIM_CHECK_EQ(EMXXLX_ReadAsync(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE, Test_Callback, NULL), HAL_OK);
+	HAL_Delay(10);
+	SIM_CHECK_EQ(Test_Calls, 0);
+	__enable_irq();
+	SIM_CHECK_EQ(Test_Calls, 1);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+}
+
+static void Test_Chain_Callback(EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context)
+{
+	Test_Calls++;
+	if (Test_Calls == 1U)
+	{
+		Test_Status = EMXXLX_ReadAsync(hmram, TEST_ADDRESS + TEST_SIZE, Test_Check + TEST_SIZE, TEST_SIZE,
+									   Test_Chain_Callback, NULL);
+	}
+}
+
+/**
+ *  @brief The completion callback can start the next transfer.
+ */
+static void Test_Chain(void)
+{
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	EMXXLX_Sim_AutoIrq(1);
+
+	SIM_CHECK_EQ(EMXXLX_ReadAsync(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE, Test_Chain_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(Sim_Test_Wait(&hmram, 10), HAL_OK);
+	SIM_CHECK_EQ(Test_Calls, 2);
+	SIM_CHECK_EQ(Test_Status, HAL_OK);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, 2U * TEST_SIZE) == 0);
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Read_Steps);
+	SIM_RUN(Test_Write_Steps);
+	SIM_RUN(Test_Erase_Steps);
+	SIM_RUN(Test_Poll_Steps);
+	SIM_RUN(Test_Abort);
+	SIM_RUN(Test_Masked);
+	SIM_RUN(Test_Chain);
+	return Sim_Test_Report();
+}
@@ -0,0 +1,169 @@
+/*
+ * test_cal.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of EMXXLX_Calibrate against sampling window errors injected
+ *  by the simulator, see EMXXLX_SIM_TimingTypeDef.DataSkewPs: a window
+ *  only reachable with the delay block, one only open at a slower clock,
+ *  none at all, and the DQS strobe of octal DTR.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_SCRATCH				0x040000U // Calibration pattern address
+#define TEST_ADDRESS				0x050000U // Start of the transfers
+#define TEST_SIZE					4096U
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[TEST_SIZE];
+static uint8_t Test_Check[TEST_SIZE];
+
+/**
+ *  @brief Device initialized on an ideal bus with reference data written,
+ * 		   then the sampling window of the board applied.
+ */
+static uint8_t Test_Setup(uint8_t SpiInterfaceMode, uint8_t InterfaceMode, uint32_t DelayPs, uint32_t SkewPs)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	if ((EMXXLX_Init(&hmram, Sim_Test_Config(SpiInterfaceMode), InterfaceMode) != HAL_OK)
+			|| (EMXXLX_WriteBuffer(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_Sim_GetTiming(&timing);
+	timing.DataDelayPs = DelayPs;
+	timing.DataSkewPs = SkewPs;
+	EMXXLX_Sim_SetTiming(&timing);
+	return HAL_OK;
+}
+
+/**
+ *  @brief Read the reference data back.
+ *  @retval Non zero when it matches
+ */
+static uint8_t Test_Read_Back(void)
+{
+	memset(Test_Check, 0, TEST_SIZE);
+	return (EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE) == HAL_OK)
+			&& (memcmp(Test_Check, Test_Buffer, TEST_SIZE) == 0);
+}
+
+/**
+ *  @brief The default sampling point misses the data eye at full speed, the
+ * 		   delay block reaches it: the fastest clock is kept, centered.
+ */
+static void Test_Delay_Block(void)
+{
+	uint8_t ds = 0;
+
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 1);
+	SIM_CHECK_EQ(Test_Setup(MRAM_OSPI_W_DS, 8, 4000, 3500), HAL_OK);
+	SIM_CHECK(!Test_Read_Back());
+
+	SIM_CHECK_EQ(EMXXLX_Calibrate(&hmram, 8, TEST_SCRATCH), HAL_OK);
+	SIM_CHECK(hmram.Calibration.Valid);
+	SIM_CHECK_EQ(hmram.Calibration.InterfaceMode, 8);
+	SIM_CHECK_EQ(hmram.Calibration.ClockPrescaler, 1);
+	SIM_CHECK_EQ(hmram.Calibration.DelayBlockBypass, HAL_OSPI_DELAY_BLOCK_USED);
+	SIM_CHECK(hmram.Calibration.Window >= EMXXLX_CAL_MIN_WINDOW);
+	SIM_CHECK_EQ(hospi1.Init.ClockPrescaler, 1);
+	SIM_CHECK(Test_Read_Back());
+
+	/* The DS delay is kept in the nonvolatile register */
+	SIM_CHECK_EQ(EMXXLX_Read_Nonvol(&hmram, 4, &ds, 1), HAL_OK);
+	SIM_CHECK_EQ(ds, hmram.Calibration.DsDelay);
+
+	/* The next initialization applies the calibration */
+	SIM_CHECK_EQ(EMXXLX_Init(&hmram, Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+	SIM_CHECK_EQ(hospi1.Init.DelayBlockBypass, HAL_OSPI_DELAY_BLOCK_USED);
+	SIM_CHECK(Test_Read_Back());
+}
+
+/**
+ *  @brief A data eye too narrow for the fastest clock: a slower one is kept.
+ */
+static void Test_Slower_Clock(void)
+{
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 2);
+	SIM_CHECK_EQ(Test_Setup(MRAM_OSPI_W_DS, 8, 1000, 5500), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_Calibrate(&hmram, 8, TEST_SCRATCH), HAL_OK);
+	SIM_CHECK(hmram.Calibration.ClockPrescaler > 1U);
+	SIM_CHECK(hmram.Calibration.Window >= EMXXLX_CAL_MIN_WINDOW);
+	SIM_CHECK_EQ(hospi1.Init.ClockPrescaler, hmram.Calibration.ClockPrescaler);
+	SIM_CHECK(Test_Read_Back());
+}
+
+/**
+ *  @brief No stable window at any clock: the calibration fails, and the
+ * 		   device reads again once the bus is fixed and reinitialized.
+ */
+static void Test_No_Window(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 3);
+	SIM_CHECK_EQ(Test_Setup(MRAM_OSPI_W_DS, 8, 0, 30000), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_Calibrate(&hmram, 8, TEST_SCRATCH), HAL_ERROR);
+	SIM_CHECK(!hmram.Calibration.Valid);
+	SIM_CHECK(!Test_Read_Back());
+
+	EMXXLX_Sim_GetTiming(&timing);
+	timing.DataSkewPs = 0;
+	EMXXLX_Sim_SetTiming(&timing);
+	/* The status polling of the pattern write timed out, the port is in error */
+	SIM_CHECK_EQ(HAL_OSPI_Init(&hospi1), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Init(&hmram, Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+	SIM_CHECK_EQ(hospi1.Init.ClockPrescaler, 1);
+	SIM_CHECK(Test_Read_Back());
+}
+
+/**
+ *  @brief In octal DTR the reads are sampled on DQS, which comes with the
+ * 		   data: the added DS delay and the delay block move the sample
+ * 		   into the eye at the fastest clock. Writing the DS delay of register 4
+ * 		   keeps the address mode of register 5.
+ */
+static void Test_Dqs(void)
+{
+	EMXXLX_SIM_RegsTypeDef regs;
+
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 4);
+	SIM_CHECK_EQ(Test_Setup(MRAM_ODTR_W_DS, EMXXLX_OCTAL_DTR_MODE, 0, 1600), HAL_OK);
+	SIM_CHECK(!Test_Read_Back());
+
+	SIM_CHECK_EQ(EMXXLX_Calibrate(&hmram, EMXXLX_OCTAL_DTR_MODE, TEST_SCRATCH), HAL_OK);
+	SIM_CHECK_EQ(hmram.Calibration.ClockPrescaler, 1);
+	SIM_CHECK(hmram.Calibration.Window >= EMXXLX_CAL_MIN_WINDOW);
+	SIM_CHECK(Test_Read_Back());
+
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK(hmram.Calibration.DsDelay != MRAM_0_ADDED_DELAY);
+	SIM_CHECK_EQ(regs.Vol[4], hmram.Calibration.DsDelay);
+	SIM_CHECK_EQ(regs.Vol[5], MRAM_ADDRESS_BYTES_4);
+	SIM_CHECK_EQ(regs.Nonvol[5], MRAM_ADDRESS_BYTES_4);
+
+	/* The next initialization applies the calibration again */
+	SIM_CHECK_EQ(EMXXLX_Init(&hmram, Sim_Test_Config(MRAM_ODTR_W_DS), EMXXLX_OCTAL_DTR_MODE), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Vol[4], hmram.Calibration.DsDelay);
+	SIM_CHECK_EQ(regs.Vol[5], MRAM_ADDRESS_BYTES_4);
+	SIM_CHECK(Test_Read_Back());
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Delay_Block);
+	SIM_RUN(Test_Slower_Clock);
+	SIM_RUN(Test_No_Window);
+	SIM_RUN(Test_Dqs);
+	return Sim_Test_Report();
+}
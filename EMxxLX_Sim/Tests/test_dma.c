@@ -0,0 +1,249 @@
+/*
+ * test_dma.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the DMA transfers: data integrity across the
+ *  EMXXLX_DMA_MAX_XFER split, commands issued in order while the CPU is
+ *  free, and completion callbacks called once, after the last command.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_ADDRESS				0x010000U // Start of the transfers
+#define TEST_SIZE					(2U * EMXXLX_DMA_MAX_XFER + 0x123U) // Three DMA blocks, the last one partial
+#define TEST_LOG_ENTRIES			256U
+
+/** @defgroup TEST_Event TEST Event
+  * @{
+  */
+#define TEST_EVENT_COMMAND						0x00U // Command executed by the device
+#define TEST_EVENT_RX_CPLT						0x01U // EMXXLX_RxCpltCallback
+#define TEST_EVENT_TX_CPLT						0x02U // EMXXLX_TxCpltCallback
+#define TEST_EVENT_ERROR						0x03U // EMXXLX_ErrorCallback
+#define TEST_EVENT_USER							0x04U // Callback given to the transfer
+/**
+  * @}
+  */
+
+typedef struct
+{
+  uint8_t Event;								/*!< A value of @ref TEST_Event */
+
+  uint8_t Status;								/*!< HAL status given to the user callback */
+
+  uint8_t Busy;									/*!< Device busy when the callback runs */
+
+  EMXXLX_SIM_OpTypeDef Op;						/*!< Command, for TEST_EVENT_COMMAND */
+} TEST_LogTypeDef;
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[TEST_SIZE];
+static uint8_t Test_Check[TEST_SIZE];
+static TEST_LogTypeDef Test_Log[TEST_LOG_ENTRIES];
+static uint32_t Test_Entries;
+static void *Test_Context;
+
+static void Test_Record(uint8_t Event, uint8_t Status, const EMXXLX_SIM_OpTypeDef *Op)
+{
+	EMXXLX_SIM_RegsTypeDef regs;
+	TEST_LogTypeDef *entry;
+
+	if (Test_Entries >= TEST_LOG_ENTRIES)
+	{
+		return;
+	}
+
+	entry = &Test_Log[Test_Entries++];
+	memset(entry, 0, sizeof(*entry));
+	entry->Event = Event;
+	entry->Status = Status;
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	entry->Busy = regs.Busy;
+	if (Op != NULL)
+	{
+		entry->Op = *Op;
+	}
+}
+
+static void Test_Observer(const EMXXLX_SIM_OpTypeDef *Op, void *Context)
+{
+	Test_Record(TEST_EVENT_COMMAND, HAL_OK, Op);
+}
+
+void EMXXLX_RxCpltCallback(EMXXLX_HandleTypeDef *hmram)
+{
+	Test_Record(TEST_EVENT_RX_CPLT, HAL_OK, NULL);
+}
+
+void EMXXLX_TxCpltCallback(EMXXLX_HandleTypeDef *hmram)
+{
+	Test_Record(TEST_EVENT_TX_CPLT, HAL_OK, NULL);
+}
+
+void EMXXLX_ErrorCallback(EMXXLX_HandleTypeDef *hmram)
+{
+	Test_Record(TEST_EVENT_ERROR, HAL_ERROR, NULL);
+}
+
+static void Test_Callback(EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context)
+{
+	Test_Context = Context;
+	Test_Record(TEST_EVENT_USER, Status, NULL);
+}
+
+/**
+ *  @brief Device in octal mode with known data, the log empty.
+ */
+static uint8_t Test_Setup(void)
+{
+	EMXXLX_ConfigurationTypeDef config = Sim_Test_Config(MRAM_OSPI_W_DS);
+
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	if (EMXXLX_Init(&hmram, config, 8) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 1);
+	EMXXLX_Sim_Poke(1, 0, TEST_ADDRESS, Test_Buffer, TEST_SIZE);
+	memset(Test_Check, 0, TEST_SIZE);
+	Test_Entries = 0;
+	Test_Context = NULL;
+	EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+	return HAL_OK;
+}
+
+/**
+ *  @brief A DMA read returns before the bus transfer, reads every block in
+ * 		   order and calls EMXXLX_RxCpltCallback once, after the last one.
+ */
+static void Test_Read_DMA(void)
+{
+	uint32_t address = TEST_ADDRESS, remaining = TEST_SIZE, blocks = 0;
+	uint64_t t0;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	t0 = EMXXLX_Sim_Now_ps();
+	SIM_CHECK_EQ(EMXXLX_Read_DMA(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_RX_DMA);
+	SIM_CHECK_EQ(Test_Entries, 0);
+	SIM_CHECK_EQ(EMXXLX_Read_DMA(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_BUSY);
+	SIM_CHECK_EQ(Sim_Test_Wait(&hmram, 100), HAL_OK);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+
+	for (uint32_t i = 0; i + 1U < Test_Entries; i++)
+	{
+		const EMXXLX_SIM_OpTypeDef *op = &Test_Log[i].Op;
+
+		SIM_CHECK_EQ(Test_Log[i].Event, TEST_EVENT_COMMAND);
+		SIM_CHECK_EQ(op->Instruction, hmram.Read);
+		SIM_CHECK_EQ(op->Address, address);
+		SIM_CHECK_EQ(op->NbData, (remaining > EMXXLX_DMA_MAX_XFER) ? EMXXLX_DMA_MAX_XFER : remaining);
+		SIM_CHECK(op->StartPs >= t0);
+		address += op->NbData;
+		remaining -= op->NbData;
+		blocks++;
+	}
+
+	SIM_CHECK_EQ(blocks, 3);
+	SIM_CHECK_EQ(remaining, 0);
+	SIM_CHECK_EQ(Test_Log[Test_Entries - 1U].Event, TEST_EVENT_RX_CPLT);
+	SIM_CHECK(EMXXLX_Sim_Now_ps() >= Test_Log[Test_Entries - 2U].Op.StartPs + Test_Log[Test_Entries - 2U].Op.BusPs);
+}
+
+/**
+ *  @brief A DMA write sends each block after its write enable, waits for
+ * 		   the device to be ready in between and calls the user callback
+ * 		   with its context once everything is written.
+ */
+static void Test_Write_DMA(void)
+{
+	uint32_t address = TEST_ADDRESS, remaining = TEST_SIZE, blocks = 0, i = 0;
+	uint8_t context;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 2);
+
+	SIM_CHECK_EQ(EMXXLX_WriteAsync_DMA(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE, Test_Callback, &context),
+				 HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_TX_DMA);
+	SIM_CHECK_EQ(Sim_Test_Wait(&hmram, 100), HAL_OK);
+
+	/* Write enable, data phase and ready flag poll for each block */
+	while (remaining != 0U)
+	{
+		SIM_CHECK(i + 3U < Test_Entries);
+		SIM_CHECK_EQ(Test_Log[i].Op.Instruction, MRAM_WRITE_ENABLE_CMD);
+		SIM_CHECK_EQ(Test_Log[i + 1U].Op.Instruction, hmram.Write);
+		SIM_CHECK_EQ(Test_Log[i + 1U].Op.Address, address);
+		SIM_CHECK_EQ(Test_Log[i + 1U].Op.NbData,
+					 (remaining > EMXXLX_DMA_MAX_XFER) ? EMXXLX_DMA_MAX_XFER : remaining);
+		SIM_CHECK_EQ(Test_Log[i + 2U].Op.Instruction, MRAM_READ_FLAGS_CMD);
+		SIM_CHECK(Test_Log[i + 2U].Op.StartPs >= Test_Log[i + 1U].Op.StartPs + Test_Log[i + 1U].Op.BusPs);
+		address += Test_Log[i + 1U].Op.NbData;
+		remaining -= Test_Log[i + 1U].Op.NbData;
+		blocks++;
+		i += 3U;
+	}
+
+	SIM_CHECK_EQ(blocks, 3);
+	SIM_CHECK_EQ(Test_Entries, i + 1U);
+	SIM_CHECK_EQ(Test_Log[i].Event, TEST_EVENT_USER);
+	SIM_CHECK_EQ(Test_Log[i].Status, HAL_OK);
+	SIM_CHECK_EQ(Test_Log[i].Busy, 0);
+	SIM_CHECK(Test_Context == &context);
+
+	EMXXLX_Sim_Peek(1, 0, TEST_ADDRESS, Test_Check, TEST_SIZE);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+}
+
+/**
+ *  @brief Without a user callback the write ends in EMXXLX_TxCpltCallback.
+ */
+static void Test_Write_DMA_Weak(void)
+{
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 3);
+
+	SIM_CHECK_EQ(EMXXLX_Write_DMA(&hmram, TEST_ADDRESS, Test_Buffer, 1000), HAL_OK);
+	SIM_CHECK_EQ(Sim_Test_Wait(&hmram, 100), HAL_OK);
+	SIM_CHECK_EQ(Test_Log[Test_Entries - 1U].Event, TEST_EVENT_TX_CPLT);
+
+	EMXXLX_Sim_Peek(1, 0, TEST_ADDRESS, Test_Check, 1000);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, 1000) == 0);
+}
+
+/**
+ *  @brief A transfer which the OCTOSPI rejects ends in the error callback
+ * 		   and leaves the driver idle.
+ */
+static void Test_Read_DMA_Error(void)
+{
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	/* Beyond the end of the device, the OCTOSPI raises a transfer error */
+	SIM_CHECK_EQ(EMXXLX_ReadAsync(&hmram, EMXXLX_SIM_SIZE - 16U, Test_Check, 32, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(Sim_Test_Wait(&hmram, 100), HAL_OK);
+	SIM_CHECK_EQ(Test_Log[Test_Entries - 1U].Event, TEST_EVENT_USER);
+	SIM_CHECK_EQ(Test_Log[Test_Entries - 1U].Status, HAL_ERROR);
+	SIM_CHECK_EQ(EMXXLX_Get_XferState(&hmram), EMXXLX_XFER_IDLE);
+
+	/* The next transfer runs normally */
+	SIM_CHECK_EQ(EMXXLX_Read_DMA(&hmram, TEST_ADDRESS, Test_Check, 64), HAL_OK);
+	SIM_CHECK_EQ(Sim_Test_Wait(&hmram, 100), HAL_OK);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, 64) == 0);
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Read_DMA);
+	SIM_RUN(Test_Write_DMA);
+	SIM_RUN(Test_Write_DMA_Weak);
+	SIM_RUN(Test_Read_DMA_Error);
+	return Sim_Test_Report();
+}
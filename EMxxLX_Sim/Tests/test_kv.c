@@ -0,0 +1,370 @@
+/*
+ * test_kv.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the key-value store of the example, see mram_kv.h: the
+ *  store on a blank and on a damaged device, get and put, in place updates
+ *  without erase, the RAM index rebuilt after a power cycle, a power loss
+ *  after each write command of an update, and the latency of get and put
+ *  on the simulated bus.
+ */
+
+#include "sim_test.h"
+#include "mram_kv.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_BASE					0x600000U // Store address, as in the example
+#define TEST_KEY					0x4B000000U // First key of the tests
+#define TEST_WRITES					8U // Write commands recorded by the power loss test
+#define TEST_SAMPLES				64U // Accesses measured by the latency test
+
+static EMXXLX_HandleTypeDef hmram;
+static MRAM_KV_HandleTypeDef hkv;
+static uint8_t Test_Image[TEST_WRITES + 1U][MRAM_KV_SIZE];
+static EMXXLX_SIM_OpTypeDef Test_Writes[TEST_WRITES];
+static uint32_t Test_Count;
+static uint32_t Test_Erases;
+
+/**
+ *  @brief Count the erases and keep the store after each data write.
+ */
+static void Test_Observer(const EMXXLX_SIM_OpTypeDef *Op, void *Context)
+{
+	switch (Op->Instruction)
+	{
+	case MRAM_ERASE_4kB_SECTOR_CMD:
+	case MRAM_ERASE_32kB_SECTOR_CMD:
+	case MRAM_ERASE_SECTOR_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_4kB_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_32kB_CMD:
+	case MRAM_4BADD_ERASE_SECTOR_CMD:
+	case MRAM_ERASE_CHIP_CMD:
+		Test_Erases++;
+		return;
+
+	default:
+		break;
+	}
+
+	if (Op->Write)
+	{
+		if (Test_Count < TEST_WRITES)
+		{
+			Test_Writes[Test_Count] = *Op;
+			EMXXLX_Sim_Peek(1, 0, TEST_BASE, Test_Image[Test_Count + 1U], MRAM_KV_SIZE);
+		}
+		Test_Count++;
+	}
+}
+
+/**
+ *  @brief Device in octal mode.
+ */
+static uint8_t Test_Init(void)
+{
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	return EMXXLX_Init(&hmram, Sim_Test_Config(MRAM_OSPI_W_DS), 8);
+}
+
+/**
+ *  @brief Power cycle the device and mount the store again.
+ */
+static uint8_t Test_Remount(void)
+{
+	EMXXLX_Sim_PowerCycle(1);
+	if (Test_Init() != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	memset(&hkv, 0x5A, sizeof(hkv));
+	return MRAM_KV_Mount(&hkv, &hmram, TEST_BASE);
+}
+
+/**
+ *  @brief Value of a key at a version, 0 to MRAM_KV_VALUE_SIZE bytes.
+ */
+static uint32_t Test_Value(uint32_t Key, uint32_t Version, uint8_t *pValue)
+{
+	uint32_t length = (Key * 7U + Version) % (MRAM_KV_VALUE_SIZE + 1U);
+
+	Sim_Test_Pattern(pValue, length, Key ^ (Version << 16));
+	return length;
+}
+
+/**
+ *  @brief Check the value of a key.
+ *  @retval Non zero when the store holds the version
+ */
+static uint8_t Test_Holds(uint32_t Key, uint32_t Version)
+{
+	uint8_t expected[MRAM_KV_VALUE_SIZE], value[MRAM_KV_VALUE_SIZE];
+	uint32_t length = sizeof(value);
+	uint32_t size = Test_Value(Key, Version, expected);
+
+	return (MRAM_KV_Get(&hkv, Key, value, &length) == HAL_OK) && (length == size)
+			&& (memcmp(value, expected, size) == 0);
+}
+
+/**
+ *  @brief Put the value of a key at a version.
+ */
+static uint8_t Test_Put(uint32_t Key, uint32_t Version)
+{
+	uint8_t value[MRAM_KV_VALUE_SIZE];
+	uint32_t length = Test_Value(Key, Version, value);
+
+	return MRAM_KV_Put(&hkv, Key, value, length);
+}
+
+/**
+ *  @brief A blank device has no store, a damaged header is not formatted
+ * 		   over, an empty store mounts with no key.
+ */
+static void Test_Mount(void)
+{
+	uint8_t byte = 2;
+
+	SIM_CHECK_EQ(Test_Init(), HAL_OK);
+	SIM_CHECK_EQ(MRAM_KV_Mount(&hkv, &hmram, TEST_BASE), MRAM_KV_NO_STORE);
+
+	SIM_CHECK_EQ(MRAM_KV_Format(&hkv, &hmram, TEST_BASE), HAL_OK);
+	SIM_CHECK_EQ(hkv.Count, 0);
+	SIM_CHECK_EQ(Test_Remount(), HAL_OK);
+	SIM_CHECK_EQ(hkv.Count, 0);
+
+	/* Other layout version */
+	EMXXLX_Sim_Poke(1, 0, TEST_BASE + offsetof(MRAM_KV_HeaderTypeDef, Version), &byte, 1);
+	SIM_CHECK_EQ(Test_Remount(), HAL_ERROR);
+}
+
+/**
+ *  @brief Keys of every length are stored and read back, the invalid
+ * 		   requests are refused, a full store takes no more keys and a
+ * 		   deleted key frees its slot.
+ */
+static void Test_Put_Get(void)
+{
+	uint8_t value[MRAM_KV_VALUE_SIZE + 1U] = { 0 };
+	uint32_t length;
+
+	SIM_CHECK_EQ(Test_Init(), HAL_OK);
+	SIM_CHECK_EQ(MRAM_KV_Format(&hkv, &hmram, TEST_BASE), HAL_OK);
+
+	for (uint32_t i = 0; i < MRAM_KV_SLOTS; i++)
+	{
+		SIM_CHECK_EQ(Test_Put(TEST_KEY + i, 0), HAL_OK);
+	}
+	SIM_CHECK_EQ(hkv.Count, MRAM_KV_SLOTS);
+	for (uint32_t i = 0; i < MRAM_KV_SLOTS; i++)
+	{
+		SIM_CHECK(Test_Holds(TEST_KEY + i, 0));
+	}
+
+	/* Full store, unknown key, too small a buffer, too long a value, reserved key */
+	SIM_CHECK_EQ(Test_Put(TEST_KEY - 1U, 0), HAL_ERROR);
+	length = sizeof(value);
+	SIM_CHECK_EQ(MRAM_KV_Get(&hkv, TEST_KEY - 1U, value, &length), HAL_ERROR);
+	length = 0;
+	SIM_CHECK_EQ(MRAM_KV_Get(&hkv, TEST_KEY + MRAM_KV_VALUE_SIZE, value, &length), HAL_ERROR);
+	SIM_CHECK_EQ(MRAM_KV_Put(&hkv, TEST_KEY, value, MRAM_KV_VALUE_SIZE + 1U), HAL_ERROR);
+	SIM_CHECK_EQ(MRAM_KV_Put(&hkv, MRAM_KV_EMPTY_KEY, value, 4), HAL_ERROR);
+	SIM_CHECK(Test_Holds(TEST_KEY, 0));
+
+	/* A deleted key is gone, its slot takes a new key */
+	SIM_CHECK_EQ(MRAM_KV_Delete(&hkv, TEST_KEY + 100U), HAL_OK);
+	SIM_CHECK_EQ(MRAM_KV_Delete(&hkv, TEST_KEY + 100U), HAL_ERROR);
+	SIM_CHECK(!Test_Holds(TEST_KEY + 100U, 0));
+	SIM_CHECK_EQ(Test_Put(TEST_KEY - 1U, 0), HAL_OK);
+	SIM_CHECK(Test_Holds(TEST_KEY - 1U, 0));
+	SIM_CHECK(Test_Holds(TEST_KEY + 101U, 0));
+	SIM_CHECK_EQ(hkv.Count, MRAM_KV_SLOTS);
+}
+
+/**
+ *  @brief Updates are written in place without erase, two write commands
+ * 		   each, and the RAM index rebuilt at mount finds the last values.
+ */
+static void Test_Update(void)
+{
+	SIM_CHECK_EQ(Test_Init(), HAL_OK);
+	SIM_CHECK_EQ(MRAM_KV_Format(&hkv, &hmram, TEST_BASE), HAL_OK);
+	for (uint32_t i = 0; i < 64U; i++)
+	{
+		SIM_CHECK_EQ(Test_Put(TEST_KEY + i, 0), HAL_OK);
+	}
+
+	Test_Count = 0;
+	Test_Erases = 0;
+	EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+	for (uint32_t v = 1; v <= 10U; v++)
+	{
+		SIM_CHECK_EQ(Test_Put(TEST_KEY + 3U, v), HAL_OK);
+		SIM_CHECK(Test_Holds(TEST_KEY + 3U, v));
+	}
+	EMXXLX_Sim_SetObserver(NULL, NULL);
+
+	/* Two data writes per update, inside the slot of the key */
+	SIM_CHECK_EQ(Test_Erases, 0);
+	SIM_CHECK_EQ(Test_Count, 20);
+	for (uint32_t i = 0; i < TEST_WRITES; i++)
+	{
+		SIM_CHECK(Test_Writes[i].Address >= TEST_BASE + sizeof(MRAM_KV_HeaderTypeDef) + 3U * sizeof(MRAM_KV_SlotTypeDef));
+		SIM_CHECK(Test_Writes[i].Address < TEST_BASE + sizeof(MRAM_KV_HeaderTypeDef) + 4U * sizeof(MRAM_KV_SlotTypeDef));
+	}
+
+	SIM_CHECK_EQ(MRAM_KV_Delete(&hkv, TEST_KEY + 5U), HAL_OK);
+	SIM_CHECK_EQ(Test_Remount(), HAL_OK);
+	SIM_CHECK_EQ(hkv.Count, 63);
+	SIM_CHECK(Test_Holds(TEST_KEY + 3U, 10));
+	SIM_CHECK(!Test_Holds(TEST_KEY + 5U, 0));
+	for (uint32_t i = 6; i < 64U; i++)
+	{
+		SIM_CHECK(Test_Holds(TEST_KEY + i, 0));
+	}
+}
+
+/**
+ *  @brief Mount the store as left by a power loss: the image before the
+ * 		   write command Cut, with the first Torn bytes of it written.
+ *  @retval 1 when the key holds version 1, 0 when it holds version 0 or is
+ * 			not stored for a new key, -1 otherwise
+ */
+static int32_t Test_Cut(uint32_t Key, uint8_t New, uint32_t Cut, uint32_t Torn)
+{
+	uint32_t offset = Test_Writes[Cut].Address - TEST_BASE;
+	uint8_t value[MRAM_KV_VALUE_SIZE];
+	uint32_t length = sizeof(value);
+
+	EMXXLX_Sim_Poke(1, 0, TEST_BASE, Test_Image[Cut], MRAM_KV_SIZE);
+	EMXXLX_Sim_Poke(1, 0, Test_Writes[Cut].Address, &Test_Image[Cut + 1U][offset], Torn);
+	if (Test_Remount() != HAL_OK)
+	{
+		return -1;
+	}
+
+	if (Test_Holds(Key, 1))
+	{
+		return 1;
+	}
+	if (New)
+	{
+		return (MRAM_KV_Get(&hkv, Key, value, &length) != HAL_OK) ? 0 : -1;
+	}
+	return Test_Holds(Key, 0) ? 0 : -1;
+}
+
+/**
+ *  @brief A power loss at any point of an update or of a new key keeps the
+ * 		   previous or the new value, never a damaged one, and the other
+ * 		   keys.
+ */
+static void Test_Power_Fail(void)
+{
+	static const uint32_t keys[] = { TEST_KEY + 7U, TEST_KEY + 40U };
+	int32_t version, last;
+	uint8_t fresh;
+
+	for (uint32_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+	{
+		SIM_CHECK_EQ(Test_Init(), HAL_OK);
+		SIM_CHECK_EQ(MRAM_KV_Format(&hkv, &hmram, TEST_BASE), HAL_OK);
+		for (uint32_t i = 0; i < 32U; i++)
+		{
+			SIM_CHECK_EQ(Test_Put(TEST_KEY + i, 0), HAL_OK);
+		}
+
+		/* An update of a stored key, the first put of a new one */
+		fresh = keys[k] >= TEST_KEY + 32U;
+		Test_Count = 0;
+		EMXXLX_Sim_Peek(1, 0, TEST_BASE, Test_Image[0], MRAM_KV_SIZE);
+		EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+		SIM_CHECK_EQ(Test_Put(keys[k], 1), HAL_OK);
+		EMXXLX_Sim_SetObserver(NULL, NULL);
+		SIM_CHECK(Test_Count < TEST_WRITES);
+
+		last = 0;
+		for (uint32_t cut = 0; cut < Test_Count; cut++)
+		{
+			for (uint32_t torn = 0; torn < Test_Writes[cut].NbData; torn += 2U)
+			{
+				version = Test_Cut(keys[k], fresh, cut, torn);
+				SIM_CHECK(version >= last);
+				last = version;
+				SIM_CHECK(Test_Holds(TEST_KEY + 1U, 0));
+				SIM_CHECK_EQ(hkv.Count, fresh ? 32U + (uint32_t)version : 32U);
+			}
+		}
+
+		/* All the writes done */
+		EMXXLX_Sim_Poke(1, 0, TEST_BASE, Test_Image[Test_Count], MRAM_KV_SIZE);
+		SIM_CHECK_EQ(Test_Remount(), HAL_OK);
+		SIM_CHECK(Test_Holds(keys[k], 1));
+	}
+}
+
+static int Test_Compare(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *  @brief Get and put latency on the simulated bus, CPU time of the HAL
+ * 		   calls included: a few microseconds, as one read for a get and
+ * 		   two writes for a put.
+ */
+static void Test_Latency(void)
+{
+	static uint64_t samples[2][TEST_SAMPLES];
+	uint8_t value[MRAM_KV_VALUE_SIZE];
+	uint32_t length;
+	uint64_t start;
+
+	SIM_CHECK_EQ(Test_Init(), HAL_OK);
+	SIM_CHECK_EQ(MRAM_KV_Format(&hkv, &hmram, TEST_BASE), HAL_OK);
+	for (uint32_t i = 0; i < MRAM_KV_SLOTS; i++)
+	{
+		SIM_CHECK_EQ(Test_Put(TEST_KEY + i, 0), HAL_OK);
+	}
+
+	Sim_Test_Pattern(value, sizeof(value), 9);
+	for (uint32_t i = 0; i < TEST_SAMPLES; i++)
+	{
+		uint32_t key = TEST_KEY + (i * 97U) % MRAM_KV_SLOTS;
+
+		start = EMXXLX_Sim_Now_ns();
+		length = sizeof(value);
+		SIM_CHECK_EQ(MRAM_KV_Get(&hkv, key, value, &length), HAL_OK);
+		samples[0][i] = EMXXLX_Sim_Now_ns() - start;
+
+		start = EMXXLX_Sim_Now_ns();
+		SIM_CHECK_EQ(MRAM_KV_Put(&hkv, key, value, MRAM_KV_VALUE_SIZE), HAL_OK);
+		samples[1][i] = EMXXLX_Sim_Now_ns() - start;
+	}
+
+	for (uint32_t op = 0; op < 2U; op++)
+	{
+		qsort(samples[op], TEST_SAMPLES, sizeof(samples[op][0]), Test_Compare);
+		printf("  %s %u bytes: p50 %llu ns, p99 %llu ns\n", (op == 0U) ? "get" : "put", (unsigned)MRAM_KV_VALUE_SIZE,
+			   (unsigned long long)samples[op][TEST_SAMPLES / 2U],
+			   (unsigned long long)samples[op][TEST_SAMPLES * 99U / 100U]);
+	}
+	SIM_CHECK(samples[0][TEST_SAMPLES - 1U] < 5000U);
+	SIM_CHECK(samples[1][TEST_SAMPLES - 1U] < 10000U);
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Mount);
+	SIM_RUN(Test_Put_Get);
+	SIM_RUN(Test_Update);
+	SIM_RUN(Test_Power_Fail);
+	SIM_RUN(Test_Latency);
+	return Sim_Test_Report();
+}
@@ -0,0 +1,213 @@
+/*
+ * test_ll.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the low-level read, built with EMXXLX_USE_LL_READ. The
+ *  OCTOSPI registers of hospi1 are trapped once the device is initialized,
+ *  so that EMXXLX_Read programs the command and drains the FIFO on the
+ *  register level model of the simulator.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_ADDRESS				0x004000U // Start of the data
+#define TEST_SIZE					4096U
+
+typedef struct
+{
+  uint8_t InterfaceMode;						/*!< InterfaceMode given to EMXXLX_Init */
+
+  uint8_t SpiInterfaceMode;						/*!< Device interface mode, volatile and nonvolatile register 0 */
+
+  uint8_t Even;									/*!< Non zero when addresses and sizes must be even */
+} TEST_ModeTypeDef;
+
+static const TEST_ModeTypeDef Test_Modes[] =
+{
+  { 1, MRAM_SPI_W_DS, 0 },
+  { 4, MRAM_QSPI_W_DS, 0 },
+  { 8, MRAM_OSPI_W_DS, 0 },
+  { EMXXLX_QUAD_DTR_MODE, MRAM_QDTR_W_DS, 0 },
+  { EMXXLX_OCTAL_DTR_MODE, MRAM_ODTR_W_DS, 1 },
+  { EMXXLX_DUALQUAD_MODE, MRAM_QSPI_W_DS, 1 },
+};
+
+/* FIFO empty, partial, full and wrapping several times */
+static const uint32_t Test_Sizes[] = { 1, 2, 3, 4, 5, 31, 32, 33, 64, 257, TEST_SIZE };
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[TEST_SIZE];
+static uint8_t Test_Check[TEST_SIZE + 1U];
+static uint32_t Test_Reads;
+static EMXXLX_SIM_OpTypeDef Test_LastRead;
+
+static void Test_Observer(const EMXXLX_SIM_OpTypeDef *Op, void *Context)
+{
+	if (!Op->Write && (Op->NbData != 0U) && (Op->Instruction == hmram.CmdSet.Read.Instruction))
+	{
+		Test_Reads++;
+		Test_LastRead = *Op;
+	}
+}
+
+/**
+ *  @brief Initialize the handle on hospi1, write the test data through the
+ * 		   HAL and trap the registers.
+ */
+static uint8_t Test_Setup(const TEST_ModeTypeDef *Mode)
+{
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, Mode->InterfaceMode);
+	if ((EMXXLX_Init(&hmram, Sim_Test_Config(Mode->SpiInterfaceMode), Mode->InterfaceMode) != HAL_OK)
+		|| (EMXXLX_WriteBuffer(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	return EMXXLX_Sim_Registers(1, 1);
+}
+
+/**
+ *  @brief Every size and offset is read in every interface mode, into an
+ * 		   unaligned buffer, with one command and the OCTOSPI left idle.
+ */
+static void Test_Read(void)
+{
+	for (uint32_t m = 0; m < sizeof(Test_Modes) / sizeof(Test_Modes[0]); m++)
+	{
+		const TEST_ModeTypeDef *mode = &Test_Modes[m];
+
+		EMXXLX_Sim_Reset();
+		MX_OCTOSPI1_Init();
+		SIM_CHECK_EQ(Test_Setup(mode), HAL_OK);
+		EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+
+		for (uint32_t s = 0; s < sizeof(Test_Sizes) / sizeof(Test_Sizes[0]); s++)
+		{
+			uint32_t size = Test_Sizes[s];
+			uint32_t offset = (size < TEST_SIZE) ? (s * 2U + 1U) : 0U;
+
+			if (mode->Even)
+			{
+				size = (size + 1U) & ~1U;
+				offset &= ~1U;
+			}
+
+			Test_Reads = 0;
+			memset(Test_Check, 0, sizeof(Test_Check));
+			SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS + offset, Test_Check + 1, size), HAL_OK);
+			SIM_CHECK(memcmp(Test_Check + 1, Test_Buffer + offset, size) == 0);
+			SIM_CHECK_EQ(Test_Check[0], 0);
+			SIM_CHECK_EQ(Test_Reads, 1);
+			SIM_CHECK_EQ(Test_LastRead.NbData, size);
+			SIM_CHECK_EQ(hospi1.Instance->SR & (OCTOSPI_SR_BUSY | OCTOSPI_SR_TCF | OCTOSPI_SR_FLEVEL), 0);
+		}
+
+		EMXXLX_Sim_SetObserver(NULL, NULL);
+		SIM_CHECK_EQ(EMXXLX_Sim_Registers(1, 0), HAL_OK);
+	}
+}
+
+/**
+ *  @brief The read is paced by the slower of the bus and the register
+ * 		   accesses, and a short one costs less than the HAL calls and the
+ * 		   byte copy of the blocking path.
+ */
+static void Test_Timing(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	uint64_t t0;
+
+	SIM_CHECK_EQ(Test_Setup(&Test_Modes[2]), HAL_OK);
+	EMXXLX_Sim_GetTiming(&timing);
+	EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+
+	t0 = EMXXLX_Sim_Now_ps();
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK(EMXXLX_Sim_Now_ps() - t0 >= Test_LastRead.BusPs);
+	/* One SR and one DR access per word */
+	SIM_CHECK(EMXXLX_Sim_Now_ps() - t0 < Test_LastRead.BusPs + (TEST_SIZE / 2U + 64U) * timing.RegNs * 1000ULL);
+
+	t0 = EMXXLX_Sim_Now_ps();
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, 16), HAL_OK);
+	SIM_CHECK(EMXXLX_Sim_Now_ps() - t0 >= Test_LastRead.BusPs);
+	SIM_CHECK(EMXXLX_Sim_Now_ps() - t0 < Test_LastRead.BusPs + (2ULL * timing.HalCallNs + 16U * timing.HalByteNs) * 1000ULL);
+	EMXXLX_Sim_SetObserver(NULL, NULL);
+}
+
+/**
+ *  @brief With register accesses slower than the bus the FIFO fills up and
+ * 		   stops the clock, no byte is lost.
+ */
+static void Test_Slow_Cpu(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	uint64_t t0;
+
+	SIM_CHECK_EQ(Test_Setup(&Test_Modes[2]), HAL_OK);
+	EMXXLX_Sim_GetTiming(&timing);
+	timing.RegNs = 500;
+	EMXXLX_Sim_SetTiming(&timing);
+
+	t0 = EMXXLX_Sim_Now_ns();
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK(memcmp(Test_Check, Test_Buffer, TEST_SIZE) == 0);
+	SIM_CHECK(EMXXLX_Sim_Now_ns() - t0 >= (TEST_SIZE / 4U) * timing.RegNs);
+}
+
+/**
+ *  @brief A read past the end of the device fails, the next one works.
+ */
+static void Test_Error(void)
+{
+	SIM_CHECK_EQ(Test_Setup(&Test_Modes[2]), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, EMXXLX_SIM_SIZE - 8U, Test_Check, 16), HAL_ERROR);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, 64), HAL_OK);
+	SIM_CHECK(memcmp(Test_Check, Test_Buffer, 64) == 0);
+}
+
+/**
+ *  @brief The HAL still owns the other commands between two low-level
+ * 		   reads.
+ */
+static void Test_Mixed(void)
+{
+	EMXXLX_ConfigurationTypeDef config = Sim_Test_Config(MRAM_OSPI_W_DS);
+
+	SIM_CHECK_EQ(Test_Setup(&Test_Modes[2]), HAL_OK);
+
+	Sim_Test_Pattern(Test_Buffer, 256, 7);
+	SIM_CHECK_EQ(EMXXLX_WriteBuffer(&hmram, TEST_ADDRESS, Test_Buffer, 256), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, 256), HAL_OK);
+	SIM_CHECK(memcmp(Test_Check, Test_Buffer, 256) == 0);
+
+	SIM_CHECK_EQ(EMXXLX_Erase_Range(&hmram, TEST_ADDRESS, EMXXLX_ERASE_4KB), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Polling_MemReady(&hmram, 1000), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, 256), HAL_OK);
+	for (uint32_t i = 0; i < 256; i++)
+	{
+		SIM_CHECK_EQ(Test_Check[i], (config.EraseBitValue == MRAM_ERASE_VALUE_1) ? 0xFF : 0x00);
+	}
+}
+
+int main(void)
+{
+	EMXXLX_Sim_Reset();
+	if (EMXXLX_Sim_Registers(1, 1) != HAL_OK)
+	{
+		printf("register level model not supported on this host, skipped\n");
+		return 0;
+	}
+
+	SIM_RUN(Test_Read);
+	SIM_RUN(Test_Timing);
+	SIM_RUN(Test_Slow_Cpu);
+	SIM_RUN(Test_Error);
+	SIM_RUN(Test_Mixed);
+	return Sim_Test_Report();
+}
@@ -0,0 +1,241 @@
+/*
+ * test_power.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the deep power-down manager, built with EMXXLX_USE_POWER:
+ *  entry after the idle timeout, wake-up on the next access with its exit
+ *  latency, and the standby state restored with its registers and idle
+ *  time.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_ADDRESS				0x020000U // Start of the transfers
+#define TEST_SIZE					256U
+#define TEST_IDLE_MS				10U // Idle timeout of the tests
+#define TEST_OPS					8U // Commands recorded by the observer
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[TEST_SIZE];
+static uint8_t Test_Check[TEST_SIZE];
+static EMXXLX_SIM_OpTypeDef Test_Ops[TEST_OPS];
+static uint32_t Test_Count;
+
+/**
+ *  @brief Record the commands sent to the device.
+ */
+static void Test_Observer(const EMXXLX_SIM_OpTypeDef *Op, void *Context)
+{
+	(void)Context;
+
+	if (Test_Count < TEST_OPS)
+	{
+		Test_Ops[Test_Count] = *Op;
+	}
+	Test_Count++;
+}
+
+/**
+ *  @brief Device initialized in the given mode with the pattern written at
+ * 		   TEST_ADDRESS, the power manager enabled.
+ */
+static uint8_t Test_Setup(uint8_t SpiInterfaceMode, uint8_t InterfaceMode, uint32_t IdleTimeout)
+{
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	if (EMXXLX_Init(&hmram, Sim_Test_Config(SpiInterfaceMode), InterfaceMode) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 1);
+	if ((EMXXLX_Write_Enable(&hmram) != HAL_OK)
+		|| (EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE) != HAL_OK)
+		|| (EMXXLX_Polling_MemReady(&hmram, 100) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_Power_Config(&hmram, IdleTimeout);
+	return HAL_OK;
+}
+
+/**
+ *  @brief Deep power-down state of the device.
+ */
+static uint8_t Test_Dpd(void)
+{
+	EMXXLX_SIM_RegsTypeDef regs;
+
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	return regs.Dpd;
+}
+
+/**
+ *  @brief The device enters deep power-down once idle for the timeout, an
+ * 		   access in between restarts the idle time.
+ */
+static void Test_Idle_Entry(void)
+{
+	SIM_CHECK_EQ(Test_Setup(MRAM_OSPI_W_DS, 8, TEST_IDLE_MS), HAL_OK);
+
+	HAL_Delay(TEST_IDLE_MS / 2U);
+	SIM_CHECK_EQ(EMXXLX_Power_Process(&hmram), HAL_OK);
+	SIM_CHECK_EQ(hmram.Power.State, EMXXLX_POWER_STANDBY);
+	SIM_CHECK_EQ(Test_Dpd(), 0);
+
+	/* Past the timeout since the configuration, not since the access */
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	HAL_Delay(TEST_IDLE_MS / 2U + 1U);
+	SIM_CHECK_EQ(EMXXLX_Power_Process(&hmram), HAL_OK);
+	SIM_CHECK_EQ(hmram.Power.State, EMXXLX_POWER_STANDBY);
+	SIM_CHECK_EQ(Test_Dpd(), 0);
+
+	HAL_Delay(TEST_IDLE_MS);
+	SIM_CHECK_EQ(EMXXLX_Power_Process(&hmram), HAL_OK);
+	SIM_CHECK_EQ(hmram.Power.State, EMXXLX_POWER_DPD);
+	SIM_CHECK_EQ(Test_Dpd(), 1);
+
+	/* Already down, nothing sent */
+	EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+	Test_Count = 0;
+	SIM_CHECK_EQ(EMXXLX_Power_Process(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Power_Down(&hmram), HAL_OK);
+	EMXXLX_Sim_SetObserver(NULL, NULL);
+	SIM_CHECK_EQ(Test_Count, 0);
+}
+
+/**
+ *  @brief Wake-up on access in one interface mode: the exit command comes
+ * 		   first and the next command waits EMXXLX_DPD_EXIT_US after it.
+ */
+static void Test_Wake_Mode(uint8_t SpiInterfaceMode, uint8_t InterfaceMode)
+{
+	EMXXLX_SIM_StatsTypeDef stats;
+	EMXXLX_PowerStatsTypeDef power;
+	uint64_t exit_end;
+	uint64_t t0;
+
+	SIM_CHECK_EQ(Test_Setup(SpiInterfaceMode, InterfaceMode, 0), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Power_Down(&hmram), HAL_OK);
+	SIM_CHECK_EQ(Test_Dpd(), 1);
+
+	EMXXLX_Sim_ResetStats();
+	EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+	Test_Count = 0;
+	memset(Test_Check, 0, TEST_SIZE);
+	t0 = EMXXLX_Sim_Now_ns();
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	EMXXLX_Sim_SetObserver(NULL, NULL);
+
+	SIM_CHECK(memcmp(Test_Check, Test_Buffer, TEST_SIZE) == 0);
+	SIM_CHECK_EQ(Test_Dpd(), 0);
+	SIM_CHECK_EQ(hmram.Power.State, EMXXLX_POWER_STANDBY);
+	EMXXLX_Sim_GetStats(1, &stats);
+	SIM_CHECK_EQ(stats.Ignored, 0);
+
+	/* Exit command then the read, the latency in between */
+	SIM_CHECK_EQ(Test_Count, 2);
+	SIM_CHECK_EQ(Test_Ops[0].Instruction, MRAM_DPD_EXIT_CMD);
+	SIM_CHECK_EQ(Test_Ops[0].Dtr, (InterfaceMode == EMXXLX_OCTAL_DTR_MODE) ? 1 : 0);
+	exit_end = Test_Ops[0].StartPs + Test_Ops[0].BusPs;
+	SIM_CHECK(Test_Ops[1].StartPs >= exit_end + EMXXLX_DPD_EXIT_US * 1000000ULL);
+
+	/* The busy wait ends within a microsecond of the latency */
+	SIM_CHECK(Test_Ops[1].StartPs < exit_end + (EMXXLX_DPD_EXIT_US + 2U) * 1000000ULL);
+	SIM_CHECK(EMXXLX_Sim_Now_ns() > t0 + EMXXLX_DPD_EXIT_US * 1000ULL);
+	EMXXLX_GetPower(&hmram, &power);
+	SIM_CHECK_EQ(power.Wakeups, 1);
+	SIM_CHECK(power.MaxWakeLatencyUs >= EMXXLX_DPD_EXIT_US);
+	SIM_CHECK(power.MaxWakeLatencyUs <= EMXXLX_DPD_EXIT_US + 1U);
+	SIM_CHECK_EQ(power.WakeLatencyUs, power.MaxWakeLatencyUs);
+}
+
+static void Test_Wake_On_Access(void)
+{
+	Test_Wake_Mode(MRAM_SPI_W_DS, 1);
+}
+
+static void Test_Wake_On_Access_Dtr(void)
+{
+	Test_Wake_Mode(MRAM_ODTR_W_DS, EMXXLX_OCTAL_DTR_MODE);
+}
+
+/**
+ *  @brief After the wake-up the device is back in standby with its volatile
+ * 		   registers, the idle time restarts and the time of each state is
+ * 		   accounted.
+ */
+static void Test_Idle_Restore(void)
+{
+	EMXXLX_SIM_RegsTypeDef before, after;
+	EMXXLX_PowerStatsTypeDef power;
+	uint32_t start;
+	uint8_t value[9];
+
+	SIM_CHECK_EQ(Test_Setup(MRAM_OSPI_W_DS, 8, TEST_IDLE_MS), HAL_OK);
+	start = HAL_GetTick();
+	EMXXLX_Sim_GetRegs(1, 0, &before);
+
+	SIM_CHECK_EQ(EMXXLX_Power_Down(&hmram), HAL_OK);
+	HAL_Delay(2U * TEST_IDLE_MS);
+
+	/* Woken up by a register read, the configuration is unchanged */
+	SIM_CHECK_EQ(EMXXLX_Read_Vol(&hmram, 0, value, 9), HAL_OK);
+	SIM_CHECK(memcmp(value, before.Vol, 9) == 0);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	SIM_CHECK(memcmp(before.Vol, after.Vol, sizeof(before.Vol)) == 0);
+	SIM_CHECK_EQ(after.Dpd, 0);
+	SIM_CHECK_EQ(hmram.Power.State, EMXXLX_POWER_STANDBY);
+
+	/* The idle time restarts from the wake-up */
+	HAL_Delay(TEST_IDLE_MS / 2U);
+	SIM_CHECK_EQ(EMXXLX_Power_Process(&hmram), HAL_OK);
+	SIM_CHECK_EQ(Test_Dpd(), 0);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK(memcmp(Test_Check, Test_Buffer, TEST_SIZE) == 0);
+	HAL_Delay(TEST_IDLE_MS);
+	SIM_CHECK_EQ(EMXXLX_Power_Process(&hmram), HAL_OK);
+	SIM_CHECK_EQ(Test_Dpd(), 1);
+
+	/* Both deep power-downs accounted, the current one included */
+	EMXXLX_GetPower(&hmram, &power);
+	SIM_CHECK_EQ(power.Wakeups, 1);
+	SIM_CHECK_EQ(power.TimeMs[EMXXLX_POWER_STANDBY] + power.TimeMs[EMXXLX_POWER_DPD], HAL_GetTick() - start);
+	SIM_CHECK(power.TimeMs[EMXXLX_POWER_DPD] >= 2U * TEST_IDLE_MS);
+	SIM_CHECK(power.TimeMs[EMXXLX_POWER_STANDBY] >= TEST_IDLE_MS);
+	SIM_CHECK_EQ(power.EnergyUj[EMXXLX_POWER_DPD],
+				 power.TimeMs[EMXXLX_POWER_DPD] * EMXXLX_POWER_DPD_UA * EMXXLX_POWER_VCC_MV / 1000000U);
+}
+
+/**
+ *  @brief No deep power-down while memory-mapped mode is on.
+ */
+static void Test_Busy(void)
+{
+	SIM_CHECK_EQ(Test_Setup(MRAM_OSPI_W_DS, 8, TEST_IDLE_MS), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_MemoryMapped_Config(&hmram), HAL_OK);
+
+	HAL_Delay(TEST_IDLE_MS);
+	SIM_CHECK_EQ(EMXXLX_Power_Process(&hmram), HAL_BUSY);
+	SIM_CHECK_EQ(EMXXLX_Power_Down(&hmram), HAL_BUSY);
+	SIM_CHECK_EQ(hmram.Power.State, EMXXLX_POWER_STANDBY);
+	SIM_CHECK_EQ(Test_Dpd(), 0);
+
+	SIM_CHECK_EQ(EMXXLX_MemoryMapped_Exit(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Power_Down(&hmram), HAL_OK);
+	SIM_CHECK_EQ(Test_Dpd(), 1);
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Idle_Entry);
+	SIM_RUN(Test_Wake_On_Access);
+	SIM_RUN(Test_Wake_On_Access_Dtr);
+	SIM_RUN(Test_Idle_Restore);
+	SIM_RUN(Test_Busy);
+	return Sim_Test_Report();
+}
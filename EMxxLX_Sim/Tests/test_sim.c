@@ -0,0 +1,447 @@
+/*
+ * test_sim.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the driver on the simulated device: initialization in
+ *  every interface mode, data integrity, configuration registers in SDR
+ *  and octal DTR, status, flags and write enable latch, erase value and
+ *  bus timing.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_ADDRESS				0x001000U // Data of the integrity tests
+#define TEST_SIZE					4096U
+
+typedef struct
+{
+  uint8_t InterfaceMode;						/*!< InterfaceMode given to EMXXLX_Init */
+
+  uint8_t SpiInterfaceMode;						/*!< Device interface mode, volatile and nonvolatile register 0 */
+
+  uint32_t DataLines;							/*!< Bits per cycle of the data phase, dies and DTR included */
+} TEST_ModeTypeDef;
+
+static const TEST_ModeTypeDef Test_Modes[] =
+{
+  { 1, MRAM_SPI_W_DS, 1 },
+  { 2, MRAM_DSPI_W_DS, 2 },
+  { 4, MRAM_QSPI_W_DS, 4 },
+  { 8, MRAM_OSPI_W_DS, 8 },
+  { EMXXLX_QUAD_DTR_MODE, MRAM_QDTR_W_DS, 8 },
+  { EMXXLX_OCTAL_DTR_MODE, MRAM_ODTR_W_DS, 16 },
+  { EMXXLX_DUALQUAD_MODE, MRAM_QSPI_W_DS, 8 },
+};
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[TEST_SIZE];
+static uint8_t Test_Check[TEST_SIZE];
+static EMXXLX_SIM_OpTypeDef Test_LastRead;
+
+/**
+ *  @brief Initialize the handle on hospi1.
+ */
+static uint8_t Test_Init(EMXXLX_ConfigurationTypeDef Config, uint8_t InterfaceMode)
+{
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	return EMXXLX_Init(&hmram, Config, InterfaceMode);
+}
+
+static void Test_Observer(const EMXXLX_SIM_OpTypeDef *Op, void *Context)
+{
+	if (!Op->Write && (Op->NbData == *(uint32_t *)Context))
+	{
+		Test_LastRead = *Op;
+	}
+}
+
+/**
+ *  @brief Every interface mode initializes from a factory device, programs
+ * 		   its registers and moves data unchanged.
+ */
+static void Test_Modes_Integrity(void)
+{
+	EMXXLX_SIM_RegsTypeDef regs;
+	uint8_t id[3];
+
+	for (uint32_t m = 0; m < sizeof(Test_Modes) / sizeof(Test_Modes[0]); m++)
+	{
+		const TEST_ModeTypeDef *mode = &Test_Modes[m];
+		uint32_t dies = (mode->InterfaceMode == EMXXLX_DUALQUAD_MODE) ? 2U : 1U;
+
+		EMXXLX_Sim_Reset();
+		MX_OCTOSPI1_Init();
+
+		SIM_CHECK_EQ(Test_Init(Sim_Test_Config(mode->SpiInterfaceMode), mode->InterfaceMode), HAL_OK);
+		for (uint32_t d = 0; d < dies; d++)
+		{
+			EMXXLX_Sim_GetRegs(1, d, &regs);
+			SIM_CHECK_EQ(regs.Vol[0], mode->SpiInterfaceMode);
+			SIM_CHECK_EQ(regs.Nonvol[0], mode->SpiInterfaceMode);
+			SIM_CHECK_EQ(regs.Vol[1], MRAM_DEFAULT_DC);
+			SIM_CHECK_EQ(regs.Nonvol[5], MRAM_ADDRESS_BYTES_4);
+		}
+
+		SIM_CHECK_EQ(EMXXLX_Read_ID(&hmram, id), HAL_OK);
+		SIM_CHECK_EQ(id[0], MRAM_MANUFACTURER_ID);
+
+		Sim_Test_Pattern(Test_Buffer, TEST_SIZE, m);
+		SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+		memset(Test_Check, 0, TEST_SIZE);
+		SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+		SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+
+		/* A dual-quad pair holds the even bytes on the first device, the odd ones on the second */
+		for (uint32_t d = 0; d < dies; d++)
+		{
+			EMXXLX_Sim_Peek(1, d, TEST_ADDRESS / dies, Test_Check, TEST_SIZE / dies);
+			for (uint32_t i = 0; i < TEST_SIZE / dies; i++)
+			{
+				SIM_CHECK_EQ(Test_Check[i], Test_Buffer[i * dies + d]);
+			}
+		}
+	}
+}
+
+/**
+ *  @brief A warm start in the same mode keeps the device contents and does
+ * 		   not rewrite the nonvolatile registers.
+ */
+static void Test_Warm_Start(void)
+{
+	EMXXLX_SIM_StatsTypeDef stats;
+
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 7);
+	SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+
+	EMXXLX_Sim_PowerCycle(1);
+	MX_OCTOSPI1_Init();
+	EMXXLX_Sim_ResetStats();
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+	EMXXLX_Sim_GetStats(1, &stats);
+	SIM_CHECK_EQ(stats.Ignored, 0);
+
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+}
+
+/**
+ *  @brief Volatile and nonvolatile registers, status register, flags and
+ * 		   write enable latch as seen by the driver and by the device.
+ */
+static void Test_Registers(void)
+{
+	EMXXLX_SIM_RegsTypeDef regs;
+	uint8_t value[9], status, flags;
+
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+
+	/* Write enable latch, bit 1 of the status register */
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Wel, 1);
+	SIM_CHECK_EQ(EMXXLX_Read_Status(&hmram, &status), HAL_OK);
+	SIM_CHECK_EQ(status & 0x02U, 0x02U);
+	SIM_CHECK_EQ(EMXXLX_Write_Disable(&hmram), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Wel, 0);
+
+	/* A volatile write only lasts until the next power cycle */
+	SIM_CHECK_EQ(EMXXLX_Read_Vol(&hmram, 0, value, 9), HAL_OK);
+	SIM_CHECK_EQ(value[0], MRAM_OSPI_W_DS);
+	value[3] = MRAM_25_DRIVER_STR;
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write_Vol(&hmram, 3, &value[3], 1), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Vol[3], MRAM_25_DRIVER_STR);
+	SIM_CHECK_EQ(regs.Nonvol[3], MRAM_50_DRIVER_STR);
+	SIM_CHECK_EQ(EMXXLX_Read_Nonvol(&hmram, 3, value, 1), HAL_OK);
+	SIM_CHECK_EQ(value[0], MRAM_50_DRIVER_STR);
+	EMXXLX_Sim_PowerCycle(1);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Vol[3], MRAM_50_DRIVER_STR);
+
+	/* Block protection: the write is refused and reported in the flags */
+	status = 0x7C;
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write_Status(&hmram, &status), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Status, 0x7C);
+	Sim_Test_Pattern(Test_Buffer, 16, 3);
+	EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, 16);
+	SIM_CHECK_EQ(EMXXLX_Read_Flags(&hmram, &flags), HAL_OK);
+	SIM_CHECK_EQ(flags & (EMXXLX_SIM_FLAG_PROGRAM_ERROR | EMXXLX_SIM_FLAG_PROTECTION),
+				 EMXXLX_SIM_FLAG_PROGRAM_ERROR | EMXXLX_SIM_FLAG_PROTECTION);
+	EMXXLX_Sim_Peek(1, 0, TEST_ADDRESS, Test_Check, 16);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, 16) != 0);
+	SIM_CHECK_EQ(EMXXLX_Clear_flags(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read_Flags(&hmram, &flags), HAL_OK);
+	SIM_CHECK_EQ(flags, EMXXLX_SIM_FLAG_READY);
+}
+
+/**
+ *  @brief In octal DTR mode a register write moves whole words: the bytes
+ * 		   added to an odd access keep the value of their register.
+ */
+static void Test_Dtr_Registers(void)
+{
+	EMXXLX_SIM_RegsTypeDef before, after;
+	uint8_t value[3] = { MRAM_25_DRIVER_STR, MRAM_300_ADDED_DELAY, MRAM_ADDRESS_BYTES_4 };
+	uint8_t check[9];
+
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_ODTR_W_DS), EMXXLX_OCTAL_DTR_MODE), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &before);
+
+	/* One byte at an even address, the address mode in register 5 is kept */
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write_Vol(&hmram, 4, &value[1], 1), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	before.Vol[4] = MRAM_300_ADDED_DELAY;
+	SIM_CHECK(memcmp(before.Vol, after.Vol, sizeof(before.Vol)) == 0);
+
+	/* Odd address and size, register 2 before them is kept */
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write_Vol(&hmram, 3, value, 3), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	before.Vol[3] = MRAM_25_DRIVER_STR;
+	SIM_CHECK(memcmp(before.Vol, after.Vol, sizeof(before.Vol)) == 0);
+
+	/* Nonvolatile registers */
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write_Nonvol(&hmram, 4, &value[1], 1), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Polling_MemReady(&hmram, 100), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	before.Nonvol[4] = MRAM_300_ADDED_DELAY;
+	SIM_CHECK(memcmp(before.Nonvol, after.Nonvol, sizeof(before.Nonvol)) == 0);
+
+	/* The driver reads back what the device holds and still moves data */
+	SIM_CHECK_EQ(EMXXLX_Read_Vol(&hmram, 0, check, 9), HAL_OK);
+	SIM_CHECK(memcmp(check, after.Vol, 9) == 0);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 13);
+	SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+}
+
+/**
+ *  @brief In octal DTR mode the wrap set for the memory-mapped mode only
+ * 		   changes volatile register 7, register 8 next to it is kept.
+ */
+static void Test_Dtr_Wrap(void)
+{
+	EMXXLX_ConfigurationTypeDef config = Sim_Test_Config(MRAM_ODTR_W_DS);
+	EMXXLX_SIM_RegsTypeDef before, after;
+
+	config.WrapConfiguration = MRAM_32BYTE_WRAP;
+	SIM_CHECK_EQ(Test_Init(config, EMXXLX_OCTAL_DTR_MODE), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &before);
+	SIM_CHECK_EQ(before.Vol[7], MRAM_CONTINUOUS_WRAP);
+
+	SIM_CHECK_EQ(EMXXLX_MemoryMapped_Continuous(&hmram), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	SIM_CHECK_EQ(after.Vol[7], MRAM_32BYTE_WRAP);
+	SIM_CHECK_EQ(after.Vol[6], before.Vol[6]);
+	SIM_CHECK_EQ(after.Vol[8], before.Vol[8]);
+
+	SIM_CHECK_EQ(EMXXLX_MemoryMapped_Exit(&hmram), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	SIM_CHECK(memcmp(before.Vol, after.Vol, sizeof(before.Vol)) == 0);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, 16), HAL_OK);
+}
+
+/**
+ *  @brief In octal DTR mode the dummy cycles of volatile register 1 are set
+ * 		   and tuned without changing register 2 next to it.
+ */
+static void Test_Dtr_Dummy(void)
+{
+	EMXXLX_SIM_RegsTypeDef before, after;
+	uint8_t value[2];
+
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_ODTR_W_DS), EMXXLX_OCTAL_DTR_MODE), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &before);
+
+	SIM_CHECK_EQ(EMXXLX_Set_Dummy(&hmram, MRAM_12_DC), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read_Vol(&hmram, 1, value, 2), HAL_OK);
+	SIM_CHECK_EQ(value[0], MRAM_12_DC);
+	SIM_CHECK_EQ(value[1], before.Vol[2]);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	before.Vol[1] = MRAM_12_DC;
+	SIM_CHECK(memcmp(before.Vol, after.Vol, sizeof(before.Vol)) == 0);
+
+	/* The tuning goes through settings which do not read back */
+	SIM_CHECK_EQ(EMXXLX_AutoTune(&hmram, 1, TEST_ADDRESS), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	SIM_CHECK_EQ(after.Vol[1], hmram.DC);
+	before.Vol[1] = (uint8_t)hmram.DC;
+	SIM_CHECK(memcmp(before.Vol, after.Vol, sizeof(before.Vol)) == 0);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 17);
+	SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+}
+
+/**
+ *  @brief A warm start in octal DTR writes the one changed register byte of
+ * 		   each kind without changing the registers next to it.
+ */
+static void Test_Dtr_Warm_Changed(void)
+{
+	EMXXLX_ConfigurationTypeDef config = Sim_Test_Config(MRAM_ODTR_W_DS);
+	EMXXLX_SIM_RegsTypeDef before, after;
+	EMXXLX_SIM_StatsTypeDef stats;
+
+	SIM_CHECK_EQ(Test_Init(config, EMXXLX_OCTAL_DTR_MODE), HAL_OK);
+	EMXXLX_Sim_GetRegs(1, 0, &before);
+
+	config.AddedDsDelay = MRAM_300_ADDED_DELAY;
+	EMXXLX_Sim_ResetStats();
+	SIM_CHECK_EQ(Test_Init(config, EMXXLX_OCTAL_DTR_MODE), HAL_OK);
+	EMXXLX_Sim_GetStats(1, &stats);
+	SIM_CHECK_EQ(stats.Ignored, 0);
+
+	EMXXLX_Sim_GetRegs(1, 0, &after);
+	before.Vol[4] = MRAM_300_ADDED_DELAY;
+	before.Nonvol[4] = MRAM_300_ADDED_DELAY;
+	SIM_CHECK(memcmp(before.Vol, after.Vol, sizeof(before.Vol)) == 0);
+	SIM_CHECK(memcmp(before.Nonvol, after.Nonvol, sizeof(before.Nonvol)) == 0);
+}
+
+/**
+ *  @brief Once the device switched to another interface mode, the commands
+ * 		   of the driver are ignored and read back the idle bus level.
+ */
+static void Test_Interface_Mismatch(void)
+{
+	EMXXLX_SIM_StatsTypeDef stats;
+	uint8_t value = MRAM_SPI_W_DS, id[3];
+
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write_Vol(&hmram, 0, &value, 1), HAL_OK);
+
+	EMXXLX_Sim_ResetStats();
+	EMXXLX_Read_ID(&hmram, id);
+	SIM_CHECK_EQ(id[0], 0xFF);
+	EMXXLX_Sim_GetStats(1, &stats);
+	SIM_CHECK_EQ(stats.Ignored, stats.Commands);
+
+	/* A power cycle brings the nonvolatile interface mode back */
+	EMXXLX_Sim_PowerCycle(1);
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read_ID(&hmram, id), HAL_OK);
+	SIM_CHECK_EQ(id[0], MRAM_MANUFACTURER_ID);
+}
+
+/**
+ *  @brief The erase sets the erase value of volatile register 8.
+ */
+static void Test_Erase_Value(void)
+{
+	EMXXLX_ConfigurationTypeDef config = Sim_Test_Config(MRAM_OSPI_W_DS);
+	EMXXLX_SIM_RegsTypeDef regs;
+
+	for (uint8_t value = 0; value < 2U; value++)
+	{
+		config.EraseBitValue = (value != 0U) ? MRAM_ERASE_VALUE_1 : MRAM_ERASE_VALUE_0;
+		SIM_CHECK_EQ(Test_Init(config, 8), HAL_OK);
+		EMXXLX_Sim_GetRegs(1, 0, &regs);
+		SIM_CHECK_EQ(regs.Vol[8] >> 7, value);
+
+		Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 11);
+		SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+		SIM_CHECK_EQ(EMXXLX_Erase_Range(&hmram, TEST_ADDRESS, EMXXLX_ERASE_4KB), HAL_OK);
+		SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, TEST_SIZE), HAL_OK);
+		memset(Test_Buffer, (value != 0U) ? 0xFF : 0x00, TEST_SIZE);
+		SIM_CHECK(memcmp(Test_Buffer, Test_Check, TEST_SIZE) == 0);
+	}
+}
+
+/**
+ *  @brief The bus time of each read matches the cycle estimate of the driver
+ * 		   and scales with the lines and the transfer rate.
+ */
+static void Test_Timing(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	uint32_t size = TEST_SIZE, cycles, data;
+	uint64_t tclk, t0;
+
+	EMXXLX_Sim_GetTiming(&timing);
+
+	for (uint32_t m = 0; m < sizeof(Test_Modes) / sizeof(Test_Modes[0]); m++)
+	{
+		const TEST_ModeTypeDef *mode = &Test_Modes[m];
+
+		EMXXLX_Sim_Reset();
+		MX_OCTOSPI1_Init();
+		SIM_CHECK_EQ(Test_Init(Sim_Test_Config(mode->SpiInterfaceMode), mode->InterfaceMode), HAL_OK);
+		tclk = hospi1.Init.ClockPrescaler * 1000000000000ULL / timing.KernelClockHz;
+
+		memset(&Test_LastRead, 0, sizeof(Test_LastRead));
+		EMXXLX_Sim_SetObserver(Test_Observer, &size);
+		SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, size), HAL_OK);
+		EMXXLX_Sim_SetObserver(NULL, NULL);
+
+		cycles = EMXXLX_Xfer_Cycles(&hmram, 0, size);
+		SIM_CHECK_EQ(Test_LastRead.NbData, size);
+		SIM_CHECK_EQ(Test_LastRead.Ignored, 0);
+		SIM_CHECK_EQ(Test_LastRead.Cycles, cycles);
+		SIM_CHECK_EQ(Test_LastRead.BusPs, cycles * tclk);
+
+		/* The data phase takes 8 cycles per byte and line */
+		data = size * 8U / mode->DataLines;
+		SIM_CHECK(Test_LastRead.Cycles > data);
+		SIM_CHECK(Test_LastRead.Cycles < data + 64U);
+
+		/* A blocking call does not return before the bus is done */
+		t0 = EMXXLX_Sim_Now_ps();
+		SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Check, size), HAL_OK);
+		SIM_CHECK(EMXXLX_Sim_Now_ps() - t0 >= Test_LastRead.BusPs);
+	}
+}
+
+/**
+ *  @brief A write keeps the device busy for its internal time, the driver
+ * 		   waits for it before the next command.
+ */
+static void Test_Busy(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	EMXXLX_SIM_RegsTypeDef regs;
+	uint64_t t0;
+
+	SIM_CHECK_EQ(Test_Init(Sim_Test_Config(MRAM_OSPI_W_DS), 8), HAL_OK);
+	EMXXLX_Sim_GetTiming(&timing);
+	timing.WriteNs = 20000;
+	EMXXLX_Sim_SetTiming(&timing);
+
+	Sim_Test_Pattern(Test_Buffer, 256, 5);
+	t0 = EMXXLX_Sim_Now_ns();
+	SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, 256), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Polling_MemReady(&hmram, 100), HAL_OK);
+	SIM_CHECK(EMXXLX_Sim_Now_ns() - t0 >= timing.WriteNs);
+	EMXXLX_Sim_GetRegs(1, 0, &regs);
+	SIM_CHECK_EQ(regs.Busy, 0);
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Modes_Integrity);
+	SIM_RUN(Test_Warm_Start);
+	SIM_RUN(Test_Registers);
+	SIM_RUN(Test_Dtr_Registers);
+	SIM_RUN(Test_Dtr_Wrap);
+	SIM_RUN(Test_Dtr_Dummy);
+	SIM_RUN(Test_Dtr_Warm_Changed);
+	SIM_RUN(Test_Interface_Mismatch);
+	SIM_RUN(Test_Erase_Value);
+	SIM_RUN(Test_Timing);
+	SIM_RUN(Test_Busy);
+	return Sim_Test_Report();
+}
@@ -0,0 +1,188 @@
+/*
+ * test_stats.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the statistics of the blocking operations, built with
+ *  EMXXLX_USE_STATS: calls, errors, bytes, DWT cycles and latency
+ *  histogram after a known sequence of reads, writes and erases.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_ADDRESS				0x020000U // Start of the transfers
+#define TEST_SIZE					1024U
+#define TEST_READS					4U
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[TEST_SIZE];
+static EMXXLX_StatsTypeDef Test_Stats;
+
+/**
+ *  @brief Device in octal mode, the statistics cleared.
+ */
+static uint8_t Test_Setup(void)
+{
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	if (EMXXLX_Init(&hmram, Sim_Test_Config(MRAM_OSPI_W_DS), 8) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_ResetStats(&hmram);
+	return HAL_OK;
+}
+
+/**
+ *  @brief Sum of the histogram buckets of an operation.
+ */
+static uint32_t Test_Histogram(const EMXXLX_OpStatsTypeDef *pStats)
+{
+	uint32_t calls = 0;
+
+	for (uint32_t i = 0; i < EMXXLX_STATS_BUCKETS; i++)
+	{
+		calls += pStats->Histogram[i];
+	}
+	return calls;
+}
+
+/**
+ *  @brief Each operation counts its calls and bytes once, the cycles follow
+ * 		   the simulated time and every call lands in one bucket.
+ */
+static void Test_Counters(void)
+{
+	const EMXXLX_OpStatsTypeDef *op;
+	uint64_t t0, elapsed;
+	uint8_t value[9];
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 1);
+	t0 = EMXXLX_Sim_Now_ns();
+
+	/* One page write and its ready wait */
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, 256), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Polling_MemReady(&hmram, 100), HAL_OK);
+
+	for (uint32_t i = 0; i < TEST_READS; i++)
+	{
+		SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+	}
+
+	/* One 4kB erase command and its ready wait */
+	SIM_CHECK_EQ(EMXXLX_Erase_Range(&hmram, TEST_ADDRESS, EMXXLX_ERASE_4KB), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read_Vol(&hmram, 0, value, 9), HAL_OK);
+	elapsed = (EMXXLX_Sim_Now_ns() - t0) * (SystemCoreClock / 1000000U) / 1000U;
+
+	EMXXLX_GetStats(&hmram, &Test_Stats);
+	op = &Test_Stats.Op[EMXXLX_STAT_WRITE];
+	SIM_CHECK_EQ(op->Calls, 1);
+	SIM_CHECK_EQ(op->Bytes, 256);
+	op = &Test_Stats.Op[EMXXLX_STAT_READ];
+	SIM_CHECK_EQ(op->Calls, TEST_READS);
+	SIM_CHECK_EQ(op->Bytes, TEST_READS * TEST_SIZE);
+	op = &Test_Stats.Op[EMXXLX_STAT_MEMREADY];
+	SIM_CHECK_EQ(op->Calls, 2);
+	SIM_CHECK_EQ(op->Bytes, 0);
+	op = &Test_Stats.Op[EMXXLX_STAT_REGISTER];
+	SIM_CHECK_EQ(op->Calls, 1);
+	SIM_CHECK_EQ(op->Bytes, 9);
+
+	for (uint32_t i = 0; i < EMXXLX_STAT_COUNT; i++)
+	{
+		op = &Test_Stats.Op[i];
+		SIM_CHECK_EQ(op->Errors, 0);
+		SIM_CHECK_EQ(Test_Histogram(op), op->Calls);
+		SIM_CHECK(op->Cycles > 0U);
+		SIM_CHECK(op->MaxCycles <= op->Cycles);
+		SIM_CHECK((uint64_t)op->MaxCycles * op->Calls >= op->Cycles);
+	}
+
+	/* The operations take part of the simulated time, the reads of
+	   1kB at least their bytes on 8 lines at the full clock */
+	SIM_CHECK(Test_Stats.Op[EMXXLX_STAT_READ].Cycles + Test_Stats.Op[EMXXLX_STAT_WRITE].Cycles
+			  + Test_Stats.Op[EMXXLX_STAT_MEMREADY].Cycles + Test_Stats.Op[EMXXLX_STAT_REGISTER].Cycles
+			  <= elapsed);
+	SIM_CHECK(Test_Stats.Op[EMXXLX_STAT_READ].Cycles >= TEST_READS * TEST_SIZE);
+}
+
+/**
+ *  @brief A failed call is counted as an error without bytes, and a reset
+ * 		   clears every counter.
+ */
+static void Test_Errors(void)
+{
+	const EMXXLX_OpStatsTypeDef *op = &Test_Stats.Op[EMXXLX_STAT_READ];
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+
+	/* No indirect command while the memory-mapped mode holds the port */
+	SIM_CHECK_EQ(EMXXLX_MemoryMapped_Config(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_ERROR);
+	SIM_CHECK_EQ(EMXXLX_MemoryMapped_Exit(&hmram), HAL_OK);
+
+	EMXXLX_GetStats(&hmram, &Test_Stats);
+	SIM_CHECK_EQ(op->Calls, 2);
+	SIM_CHECK_EQ(op->Errors, 1);
+	SIM_CHECK_EQ(op->Bytes, TEST_SIZE);
+
+	EMXXLX_ResetStats(&hmram);
+	EMXXLX_GetStats(&hmram, &Test_Stats);
+	for (uint32_t i = 0; i < EMXXLX_STAT_COUNT; i++)
+	{
+		SIM_CHECK_EQ(Test_Stats.Op[i].Calls, 0);
+		SIM_CHECK_EQ(Test_Stats.Op[i].Cycles, 0);
+		SIM_CHECK_EQ(Test_Histogram(&Test_Stats.Op[i]), 0);
+	}
+}
+
+/**
+ *  @brief Calls land in the bucket of their duration: a read of a few bytes
+ * 		   in the first ones, a write waiting for the device much further.
+ */
+static void Test_Histogram_Buckets(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	const EMXXLX_OpStatsTypeDef *op;
+	uint32_t bucket;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	EMXXLX_Sim_GetTiming(&timing);
+	timing.WriteNs = 100000;
+	EMXXLX_Sim_SetTiming(&timing);
+
+	SIM_CHECK_EQ(EMXXLX_Write_Enable(&hmram), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Write(&hmram, TEST_ADDRESS, Test_Buffer, 16), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Polling_MemReady(&hmram, 100), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Buffer, 4), HAL_OK);
+	EMXXLX_GetStats(&hmram, &Test_Stats);
+
+	/* 100 us at 160 MHz are 16000 cycles, from 2^13 on, the wait starts
+	   once the write command was sent */
+	op = &Test_Stats.Op[EMXXLX_STAT_MEMREADY];
+	SIM_CHECK(op->MaxCycles + Test_Stats.Op[EMXXLX_STAT_WRITE].Cycles
+			  >= timing.WriteNs * (SystemCoreClock / 1000000U) / 1000U);
+	bucket = 31U - __CLZ(op->MaxCycles) - EMXXLX_STATS_FIRST_BUCKET;
+	SIM_CHECK_EQ(op->Histogram[bucket], 1);
+
+	op = &Test_Stats.Op[EMXXLX_STAT_READ];
+	for (bucket = 0; (bucket < EMXXLX_STATS_BUCKETS) && (op->Histogram[bucket] == 0U); bucket++)
+	{
+	}
+	SIM_CHECK(bucket < 4U);
+	SIM_CHECK(op->MaxCycles < (1U << (bucket + EMXXLX_STATS_FIRST_BUCKET + 1U)));
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Counters);
+	SIM_RUN(Test_Errors);
+	SIM_RUN(Test_Histogram_Buckets);
+	return Sim_Test_Report();
+}
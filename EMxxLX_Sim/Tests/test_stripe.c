@@ -0,0 +1,207 @@
+/*
+ * test_stripe.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the striped volume on two simulated devices, one on each
+ *  OCTOSPI instance: stripe placement, data integrity for unaligned
+ *  transfers, both buses running at the same time and busy or invalid
+ *  requests.
+ */
+
+#include "sim_test.h"
+
+#include <string.h>
+
+#define TEST_STRIPE					0x1000U // Stripe size of the volume
+#define TEST_ADDRESS				0x020000U // Volume address of the transfers
+#define TEST_SIZE					0x10000U
+
+static EMXXLX_HandleTypeDef hmram1;
+static EMXXLX_HandleTypeDef hmram2;
+static EMXXLX_StripeTypeDef hstripe;
+static uint8_t Test_Buffer[TEST_SIZE];
+static uint8_t Test_Check[TEST_SIZE];
+static uint32_t Test_Calls;
+static uint8_t Test_Status;
+static void *Test_Context;
+
+static void Test_Callback(EMXXLX_StripeTypeDef *hstripe, uint8_t Status, void *Context)
+{
+	Test_Calls++;
+	Test_Status = Status;
+	Test_Context = Context;
+}
+
+/**
+ *  @brief Wait for the completion callback of the volume.
+ *  @retval HAL status, HAL_TIMEOUT if the callback was not called in time
+ */
+static uint8_t Test_Wait(uint32_t Timeout)
+{
+	uint32_t tickstart = HAL_GetTick();
+
+	while (Test_Calls == 0U)
+	{
+		if ((HAL_GetTick() - tickstart) > Timeout)
+		{
+			return HAL_TIMEOUT;
+		}
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Both devices in octal mode, forming a volume.
+ */
+static uint8_t Test_Setup(void)
+{
+	EMXXLX_ConfigurationTypeDef config = Sim_Test_Config(MRAM_OSPI_W_DS);
+
+	memset(&hmram1, 0, sizeof(hmram1));
+	memset(&hmram2, 0, sizeof(hmram2));
+	memset(&hstripe, 0, sizeof(hstripe));
+	hmram1.hospi = &hospi1;
+	hmram2.hospi = &hospi2;
+	if ((EMXXLX_Init(&hmram1, config, 8) != HAL_OK) || (EMXXLX_Init(&hmram2, config, 8) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	hstripe.Dev[0] = &hmram1;
+	hstripe.Dev[1] = &hmram2;
+	hstripe.StripeSize = TEST_STRIPE;
+	Test_Calls = 0;
+	Test_Status = HAL_ERROR;
+	Test_Context = NULL;
+	return HAL_OK;
+}
+
+/**
+ *  @brief Compare the devices with the volume data: stripe n is on device
+ * 		   n % 2, at the same place of its stripe n / 2.
+ */
+static uint8_t Test_Placement(uint32_t Address, const uint8_t *pData, uint32_t Size)
+{
+	uint8_t byte;
+
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		uint32_t stripe = (Address + i) / TEST_STRIPE;
+		uint32_t within = (Address + i) % TEST_STRIPE;
+
+		EMXXLX_Sim_Peek((stripe % 2U) + 1U, 0, (stripe / 2U) * TEST_STRIPE + within, &byte, 1);
+		if (byte != pData[i])
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ *  @brief A write lands on both devices stripe by stripe and reads back
+ * 		   unchanged, from unaligned addresses and sizes.
+ */
+static void Test_Write_Read(void)
+{
+	static const uint32_t offsets[] = { 0, 1, TEST_STRIPE - 3U, TEST_STRIPE + 5U };
+	static const uint32_t sizes[] = { 1, TEST_STRIPE, TEST_STRIPE + 7U, 5U * TEST_STRIPE - 9U };
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	for (uint32_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++)
+	{
+		for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+		{
+			uint32_t address = TEST_ADDRESS + offsets[o];
+
+			Sim_Test_Pattern(Test_Buffer, sizes[s], o * 8U + s);
+			Test_Calls = 0;
+			SIM_CHECK_EQ(EMXXLX_Stripe_Write(&hstripe, address, Test_Buffer, sizes[s], Test_Callback, &hstripe),
+						 HAL_OK);
+			SIM_CHECK_EQ(Test_Wait(1000), HAL_OK);
+			SIM_CHECK_EQ(Test_Calls, 1);
+			SIM_CHECK_EQ(Test_Status, HAL_OK);
+			SIM_CHECK(Test_Context == &hstripe);
+			SIM_CHECK(Test_Placement(address, Test_Buffer, sizes[s]));
+
+			memset(Test_Check, 0, sizes[s] + 1U);
+			Test_Calls = 0;
+			SIM_CHECK_EQ(EMXXLX_Stripe_Read(&hstripe, address, Test_Check, sizes[s], Test_Callback, NULL), HAL_OK);
+			SIM_CHECK_EQ(Test_Wait(1000), HAL_OK);
+			SIM_CHECK_EQ(Test_Calls, 1);
+			SIM_CHECK_EQ(Test_Status, HAL_OK);
+			SIM_CHECK(memcmp(Test_Check, Test_Buffer, sizes[s]) == 0);
+			SIM_CHECK_EQ(Test_Check[sizes[s]], 0);
+		}
+	}
+}
+
+/**
+ *  @brief Both buses run at the same time: a volume read takes little more
+ * 		   than half the time of the same read from one device.
+ */
+static void Test_Bandwidth(void)
+{
+	EMXXLX_SIM_StatsTypeDef stats1, stats2;
+	uint64_t single, striped;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 3);
+	SIM_CHECK_EQ(EMXXLX_Stripe_Write(&hstripe, TEST_ADDRESS, Test_Buffer, TEST_SIZE, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(Test_Wait(1000), HAL_OK);
+
+	single = EMXXLX_Sim_Now_ps();
+	SIM_CHECK_EQ(EMXXLX_Read_DMA(&hmram1, 0, Test_Check, TEST_SIZE), HAL_OK);
+	SIM_CHECK_EQ(Sim_Test_Wait(&hmram1, 1000), HAL_OK);
+	single = EMXXLX_Sim_Now_ps() - single;
+
+	EMXXLX_Sim_ResetStats();
+	Test_Calls = 0;
+	striped = EMXXLX_Sim_Now_ps();
+	SIM_CHECK_EQ(EMXXLX_Stripe_Read(&hstripe, TEST_ADDRESS, Test_Check, TEST_SIZE, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(Test_Wait(1000), HAL_OK);
+	striped = EMXXLX_Sim_Now_ps() - striped;
+	SIM_CHECK(memcmp(Test_Check, Test_Buffer, TEST_SIZE) == 0);
+
+	/* Each device moved half of the data */
+	EMXXLX_Sim_GetStats(1, &stats1);
+	EMXXLX_Sim_GetStats(2, &stats2);
+	SIM_CHECK_EQ(stats1.BytesRead, TEST_SIZE / 2U);
+	SIM_CHECK_EQ(stats2.BytesRead, TEST_SIZE / 2U);
+	SIM_CHECK(striped * 10U < single * 6U);
+	printf("  %u bytes: one device %llu ns, striped %llu ns\n", (unsigned)TEST_SIZE,
+		   (unsigned long long)(single / 1000U), (unsigned long long)(striped / 1000U));
+}
+
+/**
+ *  @brief A volume transfer is refused while one is ongoing, and outside
+ * 		   the volume.
+ */
+static void Test_Busy_Invalid(void)
+{
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	SIM_CHECK_EQ(EMXXLX_Stripe_Read(&hstripe, TEST_ADDRESS, Test_Check, TEST_SIZE, Test_Callback, NULL), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Stripe_Read(&hstripe, TEST_ADDRESS, Test_Check, 16, Test_Callback, NULL), HAL_BUSY);
+	SIM_CHECK_EQ(Test_Wait(1000), HAL_OK);
+	SIM_CHECK_EQ(Test_Calls, 1);
+
+	SIM_CHECK_EQ(EMXXLX_Stripe_Read(&hstripe, 2U * EMXXLX_SIM_SIZE - 8U, Test_Check, 16, Test_Callback, NULL),
+				 HAL_ERROR);
+	SIM_CHECK_EQ(EMXXLX_Stripe_Read(&hstripe, TEST_ADDRESS, Test_Check, 0, Test_Callback, NULL), HAL_ERROR);
+	hstripe.Dev[1] = NULL;
+	SIM_CHECK_EQ(EMXXLX_Stripe_Read(&hstripe, TEST_ADDRESS, Test_Check, 16, Test_Callback, NULL), HAL_ERROR);
+	SIM_CHECK_EQ(Test_Calls, 1);
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Write_Read);
+	SIM_RUN(Test_Bandwidth);
+	SIM_RUN(Test_Busy_Invalid);
+	return Sim_Test_Report();
+}
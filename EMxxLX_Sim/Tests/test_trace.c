@@ -0,0 +1,252 @@
+/*
+ * test_trace.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Host tests of the command trace, built with EMXXLX_USE_TRACE: the
+ *  recorder against the commands seen by the simulated device, the ring
+ *  buffer wrap, and the decoder on dumps of the trace.
+ */
+
+#include "sim_test.h"
+#include "mram_trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_ADDRESS				0x030000U // Start of the transfers
+#define TEST_SIZE					4096U
+#define TEST_OPS					64U
+
+static EMXXLX_HandleTypeDef hmram;
+static uint8_t Test_Buffer[TEST_SIZE];
+static EMXXLX_SIM_OpTypeDef Test_Ops[TEST_OPS];
+static uint32_t Test_Count;
+static EMXXLX_TRACE_EventTypeDef Test_Events[EMXXLX_TRACE_ENTRIES];
+static EMXXLX_TRACE_SummaryTypeDef Test_Summary;
+
+static void Test_Observer(const EMXXLX_SIM_OpTypeDef *Op, void *Context)
+{
+	if (Test_Count < TEST_OPS)
+	{
+		Test_Ops[Test_Count] = *Op;
+	}
+	Test_Count++;
+}
+
+/**
+ *  @brief Device in octal mode, the trace cleared.
+ */
+static uint8_t Test_Setup(void)
+{
+	memset(&hmram, 0, sizeof(hmram));
+	hmram.hospi = &hospi1;
+	if (EMXXLX_Init(&hmram, Sim_Test_Config(MRAM_OSPI_W_DS), 8) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	EMXXLX_Trace_Reset();
+	Test_Count = 0;
+	return HAL_OK;
+}
+
+/**
+ *  @brief Every command reaching the device is logged once, in order, with
+ * 		   its opcode, address, length, port and modes, and the timestamps
+ * 		   follow the simulated time.
+ */
+static void Test_Record(void)
+{
+	uint64_t start, slack = SystemCoreClock / 1000000U;
+	uint32_t op = 0;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	Sim_Test_Pattern(Test_Buffer, TEST_SIZE, 1);
+
+	EMXXLX_Sim_SetObserver(Test_Observer, NULL);
+	SIM_CHECK_EQ(EMXXLX_WriteBuffer(&hmram, TEST_ADDRESS, Test_Buffer, 300), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+	SIM_CHECK_EQ(EMXXLX_Erase_Range(&hmram, TEST_ADDRESS, EMXXLX_ERASE_4KB), HAL_OK);
+	EMXXLX_Sim_SetObserver(NULL, NULL);
+
+	SIM_CHECK(Test_Count <= TEST_OPS);
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(&EMXXLX_Trace, sizeof(EMXXLX_Trace), Test_Events, EMXXLX_TRACE_ENTRIES,
+									 &Test_Summary), HAL_OK);
+	SIM_CHECK_EQ(Test_Summary.Logged, EMXXLX_Trace.Head);
+	SIM_CHECK_EQ(Test_Summary.Lost, 0);
+
+	/* The device sees the traced commands in order, each one issued after
+	   the previous one ran, an automatic polling only once it matched */
+	for (uint32_t i = 0; i < Test_Summary.Count; i++)
+	{
+		const EMXXLX_TRACE_EventTypeDef *event = &Test_Events[i];
+
+		while ((op < Test_Count) && (Test_Ops[op].Instruction != event->Instruction))
+		{
+			SIM_CHECK_EQ(Test_Ops[op].Instruction, MRAM_READ_FLAGS_CMD);
+			op++;
+		}
+		SIM_CHECK(op < Test_Count);
+		SIM_CHECK_EQ(event->Port, 1);
+		SIM_CHECK_EQ(event->NbData, Test_Ops[op].NbData);
+		if (event->NbData > 1U)
+		{
+			SIM_CHECK_EQ(event->Address, Test_Ops[op].Address);
+			SIM_CHECK_EQ((event->Mode >> EMXXLX_TRACE_DMODE_Pos) & 0x7U, 4);
+		}
+		start = (Test_Ops[op].StartPs - Test_Ops[0].StartPs) * (SystemCoreClock / 1000000U) / 1000000U;
+		SIM_CHECK(event->Cycle <= start + slack);
+		if (i != 0U)
+		{
+			SIM_CHECK(event->Cycle + slack >= (Test_Ops[op - 1U].StartPs - Test_Ops[0].StartPs)
+					  * (SystemCoreClock / 1000000U) / 1000000U);
+			SIM_CHECK(event->Cycle >= Test_Events[i - 1U].Cycle);
+		}
+		op++;
+	}
+
+	/* Data bytes per direction */
+	SIM_CHECK_EQ(Test_Summary.Port[0].BytesWritten, 300);
+	SIM_CHECK_EQ(Test_Summary.Port[0].BytesRead, TEST_SIZE + Test_Summary.OpBytes[MRAM_READ_FLAGS_CMD]
+				 + Test_Summary.OpBytes[MRAM_READ_STATUS_REG_CMD]);
+	SIM_CHECK_EQ(Test_Summary.OpCommands[MRAM_4BADD_ERASE_SECTOR_4kB_CMD], 1);
+	SIM_CHECK_EQ(Test_Summary.Port[1].Commands, 0);
+}
+
+/**
+ *  @brief Once full the ring buffer keeps the newest entries, the decoder
+ * 		   returns them oldest first and counts the lost ones.
+ */
+static void Test_Wrap(void)
+{
+	uint32_t reads = EMXXLX_TRACE_ENTRIES + 100U;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+
+	for (uint32_t i = 0; i < reads; i++)
+	{
+		SIM_CHECK_EQ(EMXXLX_Read(&hmram, i * 4U, Test_Buffer, 4), HAL_OK);
+	}
+
+	SIM_CHECK_EQ(EMXXLX_Trace.Head, reads);
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(&EMXXLX_Trace, sizeof(EMXXLX_Trace), Test_Events, EMXXLX_TRACE_ENTRIES,
+									 &Test_Summary), HAL_OK);
+	SIM_CHECK_EQ(Test_Summary.Count, EMXXLX_TRACE_ENTRIES);
+	SIM_CHECK_EQ(Test_Summary.Lost, 100);
+	for (uint32_t i = 0; i < Test_Summary.Count; i++)
+	{
+		SIM_CHECK_EQ(Test_Events[i].Address, (100U + i) * 4U);
+	}
+	SIM_CHECK_EQ(Test_Events[0].Cycle, 0);
+	SIM_CHECK_EQ(Test_Summary.Cycles, Test_Events[EMXXLX_TRACE_ENTRIES - 1U].Cycle);
+
+	/* A shorter destination keeps the newest entries */
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(&EMXXLX_Trace, sizeof(EMXXLX_Trace), Test_Events, 10, &Test_Summary),
+				 HAL_OK);
+	SIM_CHECK_EQ(Test_Summary.Count, 10);
+	SIM_CHECK_EQ(Test_Events[9].Address, (reads - 1U) * 4U);
+}
+
+/**
+ *  @brief The decoder removes the wraps of the cycle counter and rejects
+ * 		   what is not an initialized trace.
+ */
+static void Test_Decode(void)
+{
+	static const uint32_t stamps[] = { 0xFFFFFF00U, 0xFFFFFFF0U, 0x00000010U, 0x00000100U };
+	EMXXLX_TraceTypeDef *dump = calloc(1, sizeof(*dump));
+
+	SIM_CHECK(dump != NULL);
+	dump->Magic = EMXXLX_TRACE_MAGIC;
+	dump->EntrySize = sizeof(EMXXLX_TraceEntryTypeDef);
+	dump->Entries = EMXXLX_TRACE_ENTRIES;
+	dump->Head = 4;
+	for (uint32_t i = 0; i < 4U; i++)
+	{
+		dump->Entry[i].Timestamp = stamps[i];
+		dump->Entry[i].Instruction = (i & 1U) ? MRAM_WRITE_OCTO_E_CMD : MRAM_READ_OCTO_O_CMD;
+		dump->Entry[i].NbData = 1000;
+		dump->Entry[i].Port = 2;
+	}
+
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(dump, sizeof(*dump), Test_Events, EMXXLX_TRACE_ENTRIES, &Test_Summary),
+				 HAL_OK);
+	SIM_CHECK_EQ(Test_Summary.Count, 4);
+	SIM_CHECK_EQ(Test_Events[1].Cycle, 0xF0);
+	SIM_CHECK_EQ(Test_Events[2].Cycle, 0x110);
+	SIM_CHECK_EQ(Test_Events[3].Cycle, 0x200);
+	SIM_CHECK_EQ(Test_Summary.Port[1].BytesRead, 2000);
+	SIM_CHECK_EQ(Test_Summary.Port[1].BytesWritten, 2000);
+	SIM_CHECK_EQ(Test_Summary.Port[1].LastCycle - Test_Summary.Port[1].FirstCycle, 0x200);
+
+	/* Truncated, not initialized, other entry layout */
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(dump, sizeof(*dump) - 1U, NULL, 0, &Test_Summary), HAL_ERROR);
+	dump->EntrySize = 12;
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(dump, sizeof(*dump), NULL, 0, &Test_Summary), HAL_ERROR);
+	dump->EntrySize = sizeof(EMXXLX_TraceEntryTypeDef);
+	dump->Magic = 0;
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(dump, sizeof(*dump), NULL, 0, &Test_Summary), HAL_ERROR);
+	free(dump);
+}
+
+/**
+ *  @brief The printed timeline has one line per entry, and the summary the
+ * 		   bandwidth of the port.
+ */
+static void Test_Print(void)
+{
+	EMXXLX_SIM_TimingTypeDef timing;
+	char *text = NULL, *line;
+	size_t length = 0;
+	uint32_t lines = 0;
+	double mbps = 0;
+	FILE *out;
+
+	SIM_CHECK_EQ(Test_Setup(), HAL_OK);
+	for (uint32_t i = 0; i < 8U; i++)
+	{
+		SIM_CHECK_EQ(EMXXLX_Read(&hmram, TEST_ADDRESS, Test_Buffer, TEST_SIZE), HAL_OK);
+	}
+	SIM_CHECK_EQ(EMXXLX_Trace_Decode(&EMXXLX_Trace, sizeof(EMXXLX_Trace), Test_Events, EMXXLX_TRACE_ENTRIES,
+									 &Test_Summary), HAL_OK);
+
+	out = open_memstream(&text, &length);
+	SIM_CHECK(out != NULL);
+	EMXXLX_Trace_Print(out, Test_Events, &Test_Summary, SystemCoreClock);
+	fclose(out);
+
+	for (line = strtok(text, "\n"); line != NULL; line = strtok(NULL, "\n"))
+	{
+		unsigned port, commands;
+		unsigned long long read, written;
+		double span;
+
+		if (strstr(line, " READ      0x") != NULL)
+		{
+			SIM_CHECK(strstr(line, "0x00030000     4096 8-8-8") != NULL);
+			lines++;
+		}
+		if (sscanf(line, "%u %u %llu %llu %lf %lf", &port, &commands, &read, &written, &span, &mbps) == 6)
+		{
+			SIM_CHECK_EQ(port, 1);
+			SIM_CHECK_EQ(read, 8U * TEST_SIZE);
+		}
+	}
+	free(text);
+
+	/* Bytes over the span of the reads, at most one byte per clock */
+	EMXXLX_Sim_GetTiming(&timing);
+	SIM_CHECK_EQ(lines, 8);
+	SIM_CHECK(mbps > 0.0);
+	SIM_CHECK(mbps * 1e6 * hospi1.Init.ClockPrescaler < timing.KernelClockHz * 8.0 / 7.0);
+}
+
+int main(void)
+{
+	SIM_RUN(Test_Record);
+	SIM_RUN(Test_Wrap);
+	SIM_RUN(Test_Decode);
+	SIM_RUN(Test_Print);
+	return Sim_Test_Report();
+}
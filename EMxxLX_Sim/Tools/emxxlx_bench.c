@@ -0,0 +1,218 @@
+/*
+ * emxxlx_bench.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Run the benchmark sweeps of the example, see mram_bench.h, on the
+ *  simulated device and print MB/s and the p50 and p99 latencies from the
+ *  timing model, in the order of main.c. The DWT cycle counter follows
+ *  the simulated time at SystemCoreClock. Memory-mapped reads are not
+ *  modelled, MRAM_Bench_Mapped is not run.
+ *
+ *    emxxlx_bench [sweep] [kv] [chunked] [polling] [templates] [journal]
+ *
+ *  Without argument every sweep is run.
+ */
+
+#include "mram_sim.h"
+#include "mram_bench.h"
+#include "mram_mmap.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_KV_ADDRESS			0x600000U // Store address, as in main.c
+#define BENCH_JOURNAL_ADDRESS		0x400000U // Journal address, as in main.c
+
+static EMXXLX_HandleTypeDef hmram;
+static MRAM_KV_HandleTypeDef hkv;
+static MRAM_JOURNAL_HandleTypeDef hjournal;
+static MRAM_BenchResultTypeDef Results[MRAM_BENCH_MAX_RESULTS];
+
+/* The memory-mapped mode is not modelled */
+uint8_t MRAM_MMAP_Start(EMXXLX_HandleTypeDef *hmram)
+{
+	return HAL_ERROR;
+}
+
+uint8_t MRAM_MMAP_Stop(EMXXLX_HandleTypeDef *hmram)
+{
+	return HAL_ERROR;
+}
+
+uint8_t MRAM_MMAP_Cache(EMXXLX_HandleTypeDef *hmram, uint8_t Enable)
+{
+	return HAL_ERROR;
+}
+
+/**
+ *  @brief Configuration of the example in main.c.
+ */
+static EMXXLX_ConfigurationTypeDef Bench_Config(void)
+{
+	EMXXLX_ConfigurationTypeDef config = { 0 };
+
+	config.SpiInterfaceMode = MRAM_OSPI_W_DS;
+	config.DummyCycles = MRAM_DEFAULT_DC;
+	config.DriverStrenght = MRAM_50_DRIVER_STR;
+	config.AddedDsDelay = MRAM_0_ADDED_DELAY;
+	config.AddressMode = MRAM_ADDRESS_BYTES_4;
+	config.XIPConfiguration = MRAM_XIP_DISABLE;
+	config.WrapConfiguration = MRAM_CONTINUOUS_WRAP;
+	config.EraseBitValue = MRAM_ERASE_VALUE_1;
+	config.ResetPinEnable = MRAM_RESET_ENABLE;
+	config.WriteMode = MRAM_NONVOLATILE;
+	config.OtpLockEnable = MRAM_OTPLOCK_ENABLE;
+	return config;
+}
+
+/**
+ *  @brief Name of an interface mode.
+ */
+static const char *Bench_Mode(uint8_t InterfaceMode)
+{
+	switch (InterfaceMode)
+	{
+	case 1:
+		return "1-1-1";
+	case 2:
+		return "2-2-2";
+	case 4:
+		return "4-4-4";
+	case 8:
+		return "8-8-8";
+	case EMXXLX_QUAD_DTR_MODE:
+		return "4D-4D-4D";
+	case EMXXLX_OCTAL_DTR_MODE:
+		return "8D-8D-8D";
+	default:
+		return "-";
+	}
+}
+
+/**
+ *  @brief Print the results of a sweep, one line each.
+ */
+static void Bench_Print(const char *Name, const MRAM_BenchResultTypeDef *pResults, uint32_t Count)
+{
+	static const char *patterns[] = { "seq", "random", "strided" };
+	static const char *access[] = { "command", "mapped", "cached", "kv", "chunked", "journal", "autopoll",
+									"flagloop", "built" };
+	double ns = 1e9 / SystemCoreClock;
+
+	printf("# %s\n", Name);
+	printf("%-8s %-9s %3s %3s %-8s %-5s %6s %9s %10s %10s %10s %s\n", "access", "mode", "dc", "div", "pattern",
+		   "dir", "size", "MB/s", "p50 ns", "p99 ns", "bus ns", "status");
+
+	for (uint32_t i = 0; i < Count; i++)
+	{
+		const MRAM_BenchResultTypeDef *r = &pResults[i];
+
+		printf("%-8s %-9s %3u %3u %-8s %-5s %6lu %9.2f %10.0f %10.0f %10lu %s\n",
+			   (r->Access < sizeof(access) / sizeof(access[0])) ? access[r->Access] : "-",
+			   Bench_Mode(r->InterfaceMode), (unsigned)r->DummyCycles, (unsigned)r->ClockPrescaler,
+			   (r->Pattern <= MRAM_BENCH_STRIDED) ? patterns[r->Pattern] : "-", r->Write ? "write" : "read",
+			   (unsigned long)r->Size, r->Throughput / 1000.0, r->P50 * ns, r->P99 * ns,
+			   (unsigned long)r->Estimate, (r->Status == HAL_OK) ? "ok" : "error");
+	}
+}
+
+/**
+ *  @brief Non zero when the sweep is selected on the command line.
+ */
+static int Bench_Selected(int argc, char **argv, const char *Name)
+{
+	if (argc < 2)
+	{
+		return 1;
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], Name) == 0)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	static const char *names[] = { "sweep", "kv", "chunked", "polling", "templates", "journal" };
+	EMXXLX_ConfigurationTypeDef config = Bench_Config();
+	uint32_t count;
+
+	for (int i = 1; i < argc; i++)
+	{
+		uint32_t n = 0;
+
+		while ((n < sizeof(names) / sizeof(names[0])) && (strcmp(argv[i], names[n]) != 0))
+		{
+			n++;
+		}
+		if (n == sizeof(names) / sizeof(names[0]))
+		{
+			fprintf(stderr, "usage: %s [sweep] [kv] [chunked] [polling] [templates] [journal]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	EMXXLX_Sim_Reset();
+	MX_OCTOSPI1_Init();
+	hmram.hospi = &hospi1;
+	if ((EMXXLX_Init(&hmram, config, 8) != HAL_OK)
+			|| (MRAM_KV_Format(&hkv, &hmram, BENCH_KV_ADDRESS) != HAL_OK))
+	{
+		fprintf(stderr, "%s: device initialization failed\n", argv[0]);
+		return 1;
+	}
+
+	if (Bench_Selected(argc, argv, "sweep"))
+	{
+		count = MRAM_Bench_Sweep(&hmram, config, Results, MRAM_BENCH_MAX_RESULTS);
+		Bench_Print("sweep", Results, count);
+		if (EMXXLX_Init(&hmram, config, 8) != HAL_OK)
+		{
+			fprintf(stderr, "%s: device initialization failed\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (Bench_Selected(argc, argv, "kv"))
+	{
+		count = MRAM_Bench_KV(&hkv, Results, MRAM_BENCH_KV_RESULTS);
+		Bench_Print("kv", Results, count);
+	}
+
+	if (Bench_Selected(argc, argv, "chunked"))
+	{
+		count = MRAM_Bench_Chunked(&hmram, Results, MRAM_BENCH_CHUNKED_RESULTS);
+		Bench_Print("chunked", Results, count);
+	}
+
+	if (Bench_Selected(argc, argv, "polling"))
+	{
+		count = MRAM_Bench_Polling(&hmram, Results, MRAM_BENCH_POLLING_RESULTS);
+		Bench_Print("polling", Results, count);
+	}
+
+	if (Bench_Selected(argc, argv, "templates"))
+	{
+		count = MRAM_Bench_Templates(&hmram, Results, MRAM_BENCH_TEMPLATE_RESULTS);
+		Bench_Print("templates", Results, count);
+	}
+
+	if (Bench_Selected(argc, argv, "journal"))
+	{
+		count = 0;
+		if (MRAM_Journal_Open(&hjournal, &hmram, BENCH_JOURNAL_ADDRESS, MRAM_BENCH_JOURNAL_SIZE) == HAL_OK)
+		{
+			count = MRAM_Bench_Journal(&hjournal, Results, MRAM_BENCH_JOURNAL_RESULTS);
+		}
+		Bench_Print("journal", Results, count);
+	}
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * emxxlx_trace.c
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Print the timeline and the bandwidth summary of a command trace dump,
+ *  see Inc/mram_trace.h.
+ *
+ *    emxxlx_trace trace.bin [cpu_hz]
+ */
+
+#include "mram_trace.h"
+
+#include <stdlib.h>
+
+#define TRACE_CPU_HZ				160000000UL // DWT counter frequency when not given
+#define TRACE_MAX_SIZE				(1UL << 24) // Largest dump accepted
+#define TRACE_MAX_EVENTS			(TRACE_MAX_SIZE / 16U) // Entries of 16 bytes in the largest dump
+
+int main(int argc, char **argv)
+{
+	EMXXLX_TRACE_SummaryTypeDef *summary;
+	EMXXLX_TRACE_EventTypeDef *events;
+	unsigned long hz = TRACE_CPU_HZ;
+	uint8_t *dump;
+	size_t size;
+	FILE *file;
+
+	if ((argc < 2) || (argc > 3) || ((argc == 3) && ((hz = strtoul(argv[2], NULL, 0)) == 0UL)))
+	{
+		fprintf(stderr, "usage: %s trace.bin [cpu_hz]\n", argv[0]);
+		return 2;
+	}
+
+	file = fopen(argv[1], "rb");
+	if (file == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+
+	dump = malloc(TRACE_MAX_SIZE);
+	events = malloc(TRACE_MAX_EVENTS * sizeof(*events));
+	summary = malloc(sizeof(*summary));
+	if ((dump == NULL) || (events == NULL) || (summary == NULL))
+	{
+		fprintf(stderr, "%s: out of memory\n", argv[0]);
+		return 1;
+	}
+
+	size = fread(dump, 1, TRACE_MAX_SIZE, file);
+	fclose(file);
+
+	if (EMXXLX_Trace_Decode(dump, size, events, TRACE_MAX_EVENTS, summary) != 0U)
+	{
+		fprintf(stderr, "%s: not an initialized EMXXLX_Trace dump\n", argv[1]);
+		return 1;
+	}
+
+	EMXXLX_Trace_Print(stdout, events, summary, (uint32_t)hz);
+	return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * mram_bench.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "main.h"
+#include "mram.h"
+#include "mram_kv.h"
+#include "mram_journal.h"
+
+#ifndef INC_MRAM_BENCH_H_
+#define INC_MRAM_BENCH_H_
+
+/* Uncomment to run the benchmark sweep after the MRAM initialization, the
+   results are left in BenchResults for the debugger. The sweep overwrites
+   the first MRAM_BENCH_SPAN bytes of the memory */
+/* #define MRAM_BENCHMARK */
+
+typedef struct
+{
+  uint8_t InterfaceMode;						/*!< InterfaceMode given to EMXXLX_Init */
+
+  uint8_t DummyCycles;							/*!< Dummy cycles, a value of @ref EMXXLX_Dummy_Cycles */
+
+  uint8_t ClockPrescaler;						/*!< OCTOSPI clock prescaler */
+
+  uint8_t Pattern;								/*!< Access pattern, a value of @ref MRAM_Bench_Pattern */
+
+  uint8_t Write;								/*!< 0 for EMXXLX_Read or MRAM_KV_Get, 1 for EMXXLX_WriteBuffer, MRAM_KV_Put or chunked writes */
+
+  uint8_t Access;								/*!< Access path, a value of @ref MRAM_Bench_Access */
+
+  uint32_t Size;								/*!< Bytes per access */
+
+  uint32_t Throughput;							/*!< Measured throughput in kB/s */
+
+  uint32_t P50;									/*!< Median latency in CPU cycles, of a batch buffer of frames for the journal */
+
+  uint32_t P99;									/*!< 99th percentile latency in CPU cycles */
+
+  uint32_t Estimate;							/*!< Bus time from EMXXLX_Xfer_Time_ns, in ns */
+
+  uint8_t Status;								/*!< HAL status of the measure */
+} MRAM_BenchResultTypeDef;
+
+/* Functions */
+uint32_t MRAM_Bench_Sweep(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+		MRAM_BenchResultTypeDef *Results, uint32_t MaxResults);
+uint32_t MRAM_Bench_Mapped(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+		uint8_t InterfaceMode, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults);
+uint32_t MRAM_Bench_KV(MRAM_KV_HandleTypeDef *hkv, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults);
+uint32_t MRAM_Bench_Journal(MRAM_JOURNAL_HandleTypeDef *hj, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults);
+uint32_t MRAM_Bench_Templates(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults);
+uint32_t MRAM_Bench_Polling(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults);
+uint32_t MRAM_Bench_Chunked(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults);
+uint8_t MRAM_Bench_Measure(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Result);
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup MRAM_Bench_Constants MRAM Bench Constants
+  * @{
+  */
+#define MRAM_BENCH_SAMPLES			64 // Accesses measured per result
+#define MRAM_BENCH_MAX_SIZE			0x10000U // Largest access of the sweep
+#define MRAM_BENCH_SPAN				0x400000U // Memory range used by the sweep
+#define MRAM_BENCH_STRIDE			0x1000U // Gap between two strided accesses
+#define MRAM_BENCH_MAX_RESULTS		1908 // Results of a full sweep, odd sizes skipped in octal DTR
+#define MRAM_BENCH_MAPPED_RESULTS	54 // Results of a memory-mapped sweep
+#define MRAM_BENCH_KV_RESULTS		8 // Results of a key-value store sweep
+#define MRAM_BENCH_CHUNKED_RESULTS	18 // Results of a chunked write sweep
+#define MRAM_BENCH_JOURNAL_RESULTS	4 // Results of a journal sweep
+#define MRAM_BENCH_POLLING_RESULTS	6 // Results of a ready wait sweep
+#define MRAM_BENCH_TEMPLATE_RESULTS	16 // Results of a command template sweep
+#define MRAM_BENCH_JOURNAL_SIZE		0x100000U // Journal bytes used by the journal sweep
+#define MRAM_BENCH_KV_KEY			0xB0000000U // First key used by the key-value store sweep
+
+/** @defgroup MRAM_Bench_Pattern MRAM Bench Pattern
+  * @{
+  */
+#define MRAM_BENCH_SEQUENTIAL					0x00U // Each access follows the previous one
+#define MRAM_BENCH_RANDOM						0x01U // Pseudo random addresses in the span
+#define MRAM_BENCH_STRIDED						0x02U // Accesses MRAM_BENCH_STRIDE apart
+/**
+  * @}
+  */
+
+/** @defgroup MRAM_Bench_Access MRAM Bench Access
+  * @{
+  */
+#define MRAM_BENCH_COMMAND						0x00U // Driver read and write commands
+#define MRAM_BENCH_MAPPED						0x01U // Memory-mapped reads, DCACHE1 disabled
+#define MRAM_BENCH_MAPPED_CACHED				0x02U // Memory-mapped reads through DCACHE1
+#define MRAM_BENCH_KV							0x03U // MRAM_KV_Get and MRAM_KV_Put, one key per access
+#define MRAM_BENCH_CHUNKED						0x04U // Writes split by the caller in OSPI_PAGE_SIZE commands
+#define MRAM_BENCH_JOURNAL						0x05U // MRAM_Journal_Append, Size is the frame size
+#define MRAM_BENCH_AUTOPOLL						0x06U // Ready wait of EMXXLX_Polling_MemReady after a write
+#define MRAM_BENCH_FLAG_LOOP					0x07U // Ready wait of a software flag read loop after a write
+#define MRAM_BENCH_BUILT						0x08U // Reads and writes with the command built on each call
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* INC_MRAM_BENCH_H_ */
@@ -0,0 +1,24 @@
+/*
+ * mram_crc.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "main.h"
+
+#ifndef INC_MRAM_CRC_H_
+#define INC_MRAM_CRC_H_
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup MRAM_CRC_Constants MRAM CRC Constants
+  * @{
+  */
+#define MRAM_CRC_INIT				0xFFFFFFFFU // Starting value of a CRC, the result is inverted
+/**
+  * @}
+  */
+
+/* Functions */
+uint32_t MRAM_Crc(uint32_t Crc, const void *pData, uint32_t Size);
+
+#endif /* INC_MRAM_CRC_H_ */
@@ -0,0 +1,118 @@
+/*
+ * mram_journal.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "main.h"
+#include "mram.h"
+
+#ifndef INC_MRAM_JOURNAL_H_
+#define INC_MRAM_JOURNAL_H_
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup MRAM_Journal_Constants MRAM Journal Constants
+  * @{
+  */
+#define MRAM_JOURNAL_BUFFER_SIZE	0x2000U // Bytes of each SRAM batch buffer, up to EMXXLX_DMA_MAX_XFER
+#define MRAM_JOURNAL_MAGIC			0x4A4D4D45U // "EMMJ", marks the journal header
+#define MRAM_JOURNAL_BLOCK_MAGIC	0x4B4C424AU // "JBLK", marks a block commit record
+#define MRAM_JOURNAL_VERSION		2U // Layout version of the journal
+#define MRAM_JOURNAL_FIRST_BLOCK	(2U * sizeof(MRAM_JOURNAL_HeaderTypeDef)) // Offset of the first block, after the two header copies
+#define MRAM_JOURNAL_NONE			0xFFU // No batch buffer being written
+/**
+  * @}
+  */
+
+/** @defgroup MRAM_Journal_Stage MRAM Journal Stage
+  * @{
+  */
+#define MRAM_JOURNAL_IDLE						0x00U // No block being written
+#define MRAM_JOURNAL_PAYLOAD					0x01U // Frames of the block being written
+#define MRAM_JOURNAL_COMMIT						0x02U // Commit record of the block being written
+/**
+  * @}
+  */
+
+/* On-device layout: two copies of the journal header, then the blocks one
+   after the other. The header of an epoch goes to copy Epoch & 1, the valid
+   copy with the highest epoch is current. A block is its commit record
+   followed by its frames, each frame prefixed by its uint16_t length. The
+   commit record is written once the frames are, recovery stops at the
+   first block without a valid one */
+typedef struct
+{
+  uint32_t Magic;								/*!< MRAM_JOURNAL_MAGIC */
+
+  uint32_t Version;								/*!< MRAM_JOURNAL_VERSION */
+
+  uint32_t Epoch;								/*!< Incremented by MRAM_Journal_Clear, older blocks are ignored */
+
+  uint32_t Crc;									/*!< CRC32 of the fields above */
+} MRAM_JOURNAL_HeaderTypeDef;
+
+typedef struct
+{
+  uint32_t Magic;								/*!< MRAM_JOURNAL_BLOCK_MAGIC */
+
+  uint32_t Epoch;								/*!< Epoch of the journal header */
+
+  uint32_t Seq;									/*!< Block number, 0 for the first block */
+
+  uint32_t Length;								/*!< Bytes of frames, a multiple of 4 */
+
+  uint32_t Frames;								/*!< Frames of the block */
+
+  uint32_t Crc;									/*!< CRC32 of the fields above, commits the block */
+} MRAM_JOURNAL_BlockTypeDef;
+
+typedef struct
+{
+  EMXXLX_HandleTypeDef *hmram;					/*!< Initialized device holding the journal */
+
+  uint32_t Base;								/*!< Device address of the journal, a multiple of 4 */
+
+  uint32_t Size;								/*!< Device bytes of the journal */
+
+  uint32_t Epoch;								/*!< Epoch of the journal header */
+
+  uint32_t Next;								/*!< Offset of the next block to be written */
+
+  uint32_t NextSeq;								/*!< Number of the next block to be written */
+
+  volatile uint32_t Tail;						/*!< Offset following the last committed block */
+
+  volatile uint32_t Blocks;						/*!< Committed blocks */
+
+  volatile uint32_t Frames;						/*!< Committed frames */
+
+  uint32_t Dropped;								/*!< Frames refused while both buffers were busy */
+
+  uint8_t Fill;									/*!< Buffer receiving the frames */
+
+  uint32_t Used[2];								/*!< Bytes of frames in each buffer */
+
+  uint32_t Count[2];							/*!< Frames in each buffer */
+
+  volatile uint8_t Pending;						/*!< Buffer being written, MRAM_JOURNAL_NONE otherwise */
+
+  volatile uint8_t Stage;						/*!< Step of the block being written, a value of @ref MRAM_Journal_Stage */
+
+  volatile uint8_t Status;						/*!< HAL_ERROR once a write failed, until MRAM_Journal_Open */
+
+  MRAM_JOURNAL_BlockTypeDef Commit;				/*!< Commit record of the block being written */
+
+  uint32_t Buffer[2][MRAM_JOURNAL_BUFFER_SIZE / 4];	/*!< Batch buffers, one filled while the other is written */
+} MRAM_JOURNAL_HandleTypeDef;
+
+/* Functions */
+uint8_t MRAM_Journal_Open(MRAM_JOURNAL_HandleTypeDef *hj, EMXXLX_HandleTypeDef *hmram, uint32_t Base,
+		uint32_t Size);
+uint8_t MRAM_Journal_Clear(MRAM_JOURNAL_HandleTypeDef *hj);
+uint8_t MRAM_Journal_Append(MRAM_JOURNAL_HandleTypeDef *hj, const uint8_t *pFrame, uint16_t Length);
+uint8_t MRAM_Journal_Flush(MRAM_JOURNAL_HandleTypeDef *hj);
+uint8_t MRAM_Journal_Sync(MRAM_JOURNAL_HandleTypeDef *hj, uint32_t Timeout);
+uint8_t MRAM_Journal_ReadBlock(MRAM_JOURNAL_HandleTypeDef *hj, uint32_t *Offset, MRAM_JOURNAL_BlockTypeDef *Block,
+		uint8_t *pFrames, uint32_t Size);
+
+#endif /* INC_MRAM_JOURNAL_H_ */
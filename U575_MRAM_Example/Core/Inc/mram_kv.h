@@ -0,0 +1,97 @@
+/*
+ * mram_kv.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "main.h"
+#include "mram.h"
+
+#ifndef INC_MRAM_KV_H_
+#define INC_MRAM_KV_H_
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup MRAM_KV_Constants MRAM KV Constants
+  * @{
+  */
+#define MRAM_KV_SLOTS				512U // Keys held by the store
+#define MRAM_KV_VALUE_SIZE			32U // Largest value, a multiple of 4 up to 252
+#define MRAM_KV_INDEX_BITS			10U // RAM index of 2^10 entries, at least twice MRAM_KV_SLOTS
+#define MRAM_KV_INDEX_SIZE			(1UL << MRAM_KV_INDEX_BITS)
+#define MRAM_KV_MAGIC				0x564B4D45U // "EMKV", marks a formatted store
+#define MRAM_KV_VERSION				1U // Layout version of the store
+#define MRAM_KV_EMPTY_KEY			0xFFFFFFFFU // Key of a free slot, not usable
+#define MRAM_KV_NO_SLOT				0xFFFFU // Free entry of the RAM index
+#define MRAM_KV_NO_STORE			0x04U // Status of MRAM_KV_Mount when no store header is found
+#define MRAM_KV_SIZE				(sizeof(MRAM_KV_HeaderTypeDef) + MRAM_KV_SLOTS * sizeof(MRAM_KV_SlotTypeDef)) // Device bytes of the store
+/**
+  * @}
+  */
+
+/* On-device layout: the header, then MRAM_KV_SLOTS slots. A slot holds its
+   key and two copies of the value, an update writes the copy which is not
+   current and commits it with its Seq and Crc fields */
+typedef struct
+{
+  uint32_t Magic;								/*!< MRAM_KV_MAGIC */
+
+  uint32_t Version;								/*!< MRAM_KV_VERSION */
+
+  uint32_t Slots;								/*!< MRAM_KV_SLOTS */
+
+  uint32_t ValueSize;							/*!< MRAM_KV_VALUE_SIZE */
+
+  uint32_t Crc;									/*!< CRC32 of the fields above */
+
+  uint32_t Reserved[3];
+} MRAM_KV_HeaderTypeDef;
+
+typedef struct
+{
+  uint32_t Seq;									/*!< Sequence number of the copy, the copy index is Seq & 1 */
+
+  uint32_t Crc;									/*!< CRC32 of the key, Seq, Length and Value, commits the copy */
+
+  uint32_t Length;								/*!< Bytes of Value */
+
+  uint8_t Value[MRAM_KV_VALUE_SIZE];			/*!< Value, padded to an even size */
+} MRAM_KV_CopyTypeDef;
+
+typedef struct
+{
+  uint32_t Key;									/*!< Key, MRAM_KV_EMPTY_KEY for a free slot */
+
+  uint32_t Reserved;
+
+  MRAM_KV_CopyTypeDef Copy[2];					/*!< The copy with the highest valid Seq is current */
+} MRAM_KV_SlotTypeDef;
+
+typedef struct
+{
+  EMXXLX_HandleTypeDef *hmram;					/*!< Initialized device holding the store */
+
+  uint32_t Base;								/*!< Device address of the store, a multiple of 4 */
+
+  uint32_t Count;								/*!< Keys stored */
+
+  uint32_t NextFree;							/*!< Slot where the search for a free slot starts */
+
+  uint32_t Key[MRAM_KV_SLOTS];					/*!< Key of each slot, MRAM_KV_EMPTY_KEY when free */
+
+  uint32_t Seq[MRAM_KV_SLOTS];					/*!< Sequence number of the current copy of each slot */
+
+  uint8_t Length[MRAM_KV_SLOTS];				/*!< Value length of each slot */
+
+  uint16_t Index[MRAM_KV_INDEX_SIZE];			/*!< Key hash to slot, linear probing, MRAM_KV_NO_SLOT when free */
+
+  MRAM_KV_CopyTypeDef Buffer;					/*!< Copy being read or written */
+} MRAM_KV_HandleTypeDef;
+
+/* Functions */
+uint8_t MRAM_KV_Format(MRAM_KV_HandleTypeDef *hkv, EMXXLX_HandleTypeDef *hmram, uint32_t Base);
+uint8_t MRAM_KV_Mount(MRAM_KV_HandleTypeDef *hkv, EMXXLX_HandleTypeDef *hmram, uint32_t Base);
+uint8_t MRAM_KV_Get(MRAM_KV_HandleTypeDef *hkv, uint32_t Key, uint8_t *pValue, uint32_t *Length);
+uint8_t MRAM_KV_Put(MRAM_KV_HandleTypeDef *hkv, uint32_t Key, const uint8_t *pValue, uint32_t Length);
+uint8_t MRAM_KV_Delete(MRAM_KV_HandleTypeDef *hkv, uint32_t Key);
+
+#endif /* INC_MRAM_KV_H_ */
@@ -0,0 +1,37 @@
+/*
+ * mram_mmap.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "main.h"
+#include "mram.h"
+
+#ifndef INC_MRAM_MMAP_H_
+#define INC_MRAM_MMAP_H_
+
+/* Place a function or a constant in the device, see STM32U575AIIXQ_FLASH_XIP.ld.
+   It must not be used before MRAM_MMAP_Start */
+#define MRAM_MMAP_TEXT				__attribute__((section(".mram_text")))
+#define MRAM_MMAP_RODATA			__attribute__((section(".mram_rodata")))
+
+/* Functions */
+uint8_t MRAM_MMAP_Start(EMXXLX_HandleTypeDef *hmram);
+uint8_t MRAM_MMAP_Stop(EMXXLX_HandleTypeDef *hmram);
+uint8_t MRAM_MMAP_Cache(EMXXLX_HandleTypeDef *hmram, uint8_t Enable);
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup MRAM_MMAP_Constants MRAM MMAP Constants
+  * @{
+  */
+#define MRAM_MMAP_BASE				OCTOSPI1_BASE // Address of the memory-mapped device
+#define MRAM_MMAP_MPU_REGION		MPU_REGION_NUMBER0 // MPU region covering the device
+#define MRAM_MMAP_MPU_ATTRIBUTES	MPU_ATTRIBUTES_NUMBER0 // MPU attributes of the region
+#define MRAM_MMAP_ALIAS				0x10000000U // Code alias of the device, fetched through ICACHE
+#define MRAM_MMAP_ICACHE_REGION		ICACHE_REGION_0 // ICACHE remap region of the alias
+#define MRAM_MMAP_ALIAS_SIZE		ICACHE_REGIONSIZE_8MB // Size of the alias, MRAM_ALIAS in the XIP linker script
+/**
+  * @}
+  */
+
+#endif /* INC_MRAM_MMAP_H_ */
@@ -35,6 +35,7 @@ extern "C" {
 extern OSPI_HandleTypeDef hospi1;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef handle_GPDMA1_Channel0;
 
 /* USER CODE END Private defines */
 
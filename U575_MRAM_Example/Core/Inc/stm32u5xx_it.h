@@ -57,6 +57,7 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 void OCTOSPI1_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void GPDMA1_Channel0_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -26,6 +26,9 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "mram.h"
+#include "mram_bench.h"
+#include "mram_mmap.h"
+#include "mram_kv.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -35,6 +38,20 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* Uncomment to tune the dummy cycles on this boot. The setting found is kept
+   in the key-value store and applied on the next boots */
+/* #define MRAM_AUTOTUNE */
+
+/* Memory map of the example on a 64 Mbit device:
+   0x000000 - 0x3FFFFF  overwritten by the benchmark (MRAM_BENCH_SPAN)
+   0x400000 - 0x4FFFFF  journal of the benchmark (MRAM_BENCH_JOURNAL_SIZE)
+   0x600000 - 0x60FFFF  key-value store (MRAM_KV_SIZE)
+   0x7FF000 - 0x7FFFFF  scratch, reserved for the tuning patterns */
+#define MRAM_JOURNAL_ADDRESS 0x400000U
+#define MRAM_KV_ADDRESS 0x600000U
+#define MRAM_SCRATCH_ADDRESS 0x7FF000U
+/* Key of the tuning result in the store: clock prescaler, dummy cycles */
+#define MRAM_TUNE_KEY 0x00000001U
 
 /* USER CODE END PD */
 
@@ -48,6 +65,28 @@
 /* USER CODE BEGIN PV */
 uint8_t ID[3];
 EMXXLX_ConfigurationTypeDef MemConfig = { 0 };
+EMXXLX_HandleTypeDef hmram1 = { 0 };
+MRAM_KV_HandleTypeDef hkv1;
+uint8_t KvStatus;
+uint8_t Tune[2];
+uint32_t TuneLength;
+#ifdef MRAM_BENCHMARK
+MRAM_BenchResultTypeDef BenchResults[MRAM_BENCH_MAX_RESULTS];
+uint32_t BenchCount;
+MRAM_BenchResultTypeDef MappedResults[MRAM_BENCH_MAPPED_RESULTS];
+uint32_t MappedCount;
+MRAM_BenchResultTypeDef KvResults[MRAM_BENCH_KV_RESULTS];
+uint32_t KvCount;
+MRAM_BenchResultTypeDef ChunkedResults[MRAM_BENCH_CHUNKED_RESULTS];
+uint32_t ChunkedCount;
+MRAM_BenchResultTypeDef TemplateResults[MRAM_BENCH_TEMPLATE_RESULTS];
+uint32_t TemplateCount;
+MRAM_BenchResultTypeDef PollingResults[MRAM_BENCH_POLLING_RESULTS];
+uint32_t PollingCount;
+MRAM_JOURNAL_HandleTypeDef hjournal1;
+MRAM_BenchResultTypeDef JournalResults[MRAM_BENCH_JOURNAL_RESULTS];
+uint32_t JournalCount;
+#endif
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -108,9 +147,46 @@ int main(void)
   MemConfig.ResetPinEnable = MRAM_RESET_ENABLE;
   MemConfig.WriteMode = MRAM_NONVOLATILE;
   MemConfig.OtpLockEnable = MRAM_OTPLOCK_ENABLE;
-  if (EMXXLX_Init(&hospi1, MemConfig, 8) != HAL_OK)
+  hmram1.hospi = &hospi1;
+  if (EMXXLX_Init(&hmram1, MemConfig, 8) != HAL_OK)
   Error_Handler();
-  EMXXLX_Read_ID(&hospi1, ID);
+  EMXXLX_Read_ID(&hmram1, ID);
+  /* Only a device without store is formatted, a read error or a damaged
+     store is reported with its status in KvStatus */
+  KvStatus = MRAM_KV_Mount(&hkv1, &hmram1, MRAM_KV_ADDRESS);
+  if (KvStatus == MRAM_KV_NO_STORE)
+  KvStatus = MRAM_KV_Format(&hkv1, &hmram1, MRAM_KV_ADDRESS);
+  if (KvStatus != HAL_OK)
+  Error_Handler();
+#ifdef MRAM_AUTOTUNE
+  /* A failed tuning leaves the previous settings in place */
+  if (EMXXLX_AutoTune(&hmram1, hospi1.Init.ClockPrescaler, MRAM_SCRATCH_ADDRESS) == HAL_OK)
+  {
+    Tune[0] = (uint8_t)hospi1.Init.ClockPrescaler;
+    Tune[1] = (uint8_t)hmram1.DC;
+    MRAM_KV_Put(&hkv1, MRAM_TUNE_KEY, Tune, sizeof(Tune));
+  }
+#else
+  /* Setting of a previous tuning, volatile only, at the same prescaler */
+  TuneLength = sizeof(Tune);
+  if (MRAM_KV_Get(&hkv1, MRAM_TUNE_KEY, Tune, &TuneLength) == HAL_OK && TuneLength == sizeof(Tune)
+      && Tune[0] == hospi1.Init.ClockPrescaler)
+  {
+    EMXXLX_Set_Dummy(&hmram1, Tune[1]);
+  }
+#endif
+#ifdef MRAM_BENCHMARK
+  BenchCount = MRAM_Bench_Sweep(&hmram1, MemConfig, BenchResults, MRAM_BENCH_MAX_RESULTS);
+  if (EMXXLX_Init(&hmram1, MemConfig, 8) != HAL_OK)
+  Error_Handler();
+  MappedCount = MRAM_Bench_Mapped(&hmram1, MemConfig, 8, MappedResults, MRAM_BENCH_MAPPED_RESULTS);
+  KvCount = MRAM_Bench_KV(&hkv1, KvResults, MRAM_BENCH_KV_RESULTS);
+  ChunkedCount = MRAM_Bench_Chunked(&hmram1, ChunkedResults, MRAM_BENCH_CHUNKED_RESULTS);
+  PollingCount = MRAM_Bench_Polling(&hmram1, PollingResults, MRAM_BENCH_POLLING_RESULTS);
+  TemplateCount = MRAM_Bench_Templates(&hmram1, TemplateResults, MRAM_BENCH_TEMPLATE_RESULTS);
+  if (MRAM_Journal_Open(&hjournal1, &hmram1, MRAM_JOURNAL_ADDRESS, MRAM_BENCH_JOURNAL_SIZE) == HAL_OK)
+  JournalCount = MRAM_Bench_Journal(&hjournal1, JournalResults, MRAM_BENCH_JOURNAL_RESULTS);
+#endif
 
   /* USER CODE END 2 */
 
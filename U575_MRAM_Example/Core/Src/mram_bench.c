@@ -0,0 +1,814 @@
+/*
+ * mram_bench.c
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "mram_bench.h"
+#include "mram_mmap.h"
+#include "octospi.h"
+#include <string.h>
+
+// Interface modes of the sweep with the matching device interface mode
+
+static const uint8_t BenchModes[][2] = {
+	{ 1, MRAM_SPI_W_DS },
+	{ 2, MRAM_DSPI_W_DS },
+	{ 4, MRAM_QSPI_W_DS },
+	{ 8, MRAM_OSPI_W_DS },
+	{ EMXXLX_QUAD_DTR_MODE, MRAM_QDTR_W_DS },
+	{ EMXXLX_OCTAL_DTR_MODE, MRAM_ODTR_W_DS },
+};
+
+static const uint8_t BenchDummyCycles[] = { MRAM_DEFAULT_DC, MRAM_8_DC };
+static const uint8_t BenchPrescalers[] = { 1, 2, 4 };
+static const uint32_t BenchSizes[] = { 1, 4, 16, 64, 256, 1024, 4096, 16384, MRAM_BENCH_MAX_SIZE };
+static const uint32_t BenchKvSizes[] = { 1, 4, 16, MRAM_KV_VALUE_SIZE };
+static const uint8_t BenchChunkedAccess[] = { MRAM_BENCH_COMMAND, MRAM_BENCH_CHUNKED };
+static const uint32_t BenchJournalSizes[] = { 16, 64, 256, 1024 };
+static const uint32_t BenchPollingSizes[] = { 4, 256, 4096 };
+static const uint8_t BenchPollingAccess[] = { MRAM_BENCH_AUTOPOLL, MRAM_BENCH_FLAG_LOOP };
+static const uint32_t BenchTemplateSizes[] = { 8, 16, 32, 64 };
+static const uint8_t BenchTemplateAccess[] = { MRAM_BENCH_COMMAND, MRAM_BENCH_BUILT };
+
+// Transfer buffer and latency samples of the ongoing measure
+
+static uint8_t BenchBuffer[MRAM_BENCH_MAX_SIZE];
+static uint32_t BenchSamples[MRAM_BENCH_SAMPLES];
+
+// Store measured by MRAM_Bench_KV
+
+static MRAM_KV_HandleTypeDef *BenchKv;
+
+static uint8_t MRAM_Bench_Value(uint32_t address);
+static uint8_t MRAM_Bench_Fill(EMXXLX_HandleTypeDef *hmram);
+static uint8_t MRAM_Bench_Check(uint32_t address, uint32_t size);
+static uint32_t MRAM_Bench_Address(MRAM_BenchResultTypeDef *Result, uint32_t Index, uint32_t *Seed);
+static uint8_t MRAM_Bench_Chunked_Write(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
+		uint32_t size);
+static uint8_t MRAM_Bench_Flag_Loop(EMXXLX_HandleTypeDef *hmram);
+static uint8_t MRAM_Bench_Built(EMXXLX_HandleTypeDef *hmram, uint8_t Write, uint32_t address, uint8_t *pData,
+		uint32_t size);
+static void MRAM_Bench_Summary(MRAM_BenchResultTypeDef *Result, uint64_t Bytes, uint64_t Total);
+static void MRAM_Bench_Sort(uint32_t *Samples, uint32_t Count);
+
+/**
+ *  @brief Measure every combination of interface mode, dummy cycles, clock
+ * 		   prescaler, access pattern, direction and size. The modes are
+ * 		   switched with EMXXLX_Set_Mode, the nonvolatile registers are not
+ * 		   written. The device is left in the last mode, EMXXLX_Init brings
+ * 		   it back to Config. Odd sizes are skipped in octal DTR.
+ *  @note  The first MRAM_BENCH_SPAN bytes of the memory are overwritten.
+ * 	@param hmram			MRAM device handle, initialized with Config.
+ *  @param Config			Device configuration, interface mode and dummy cycles are swept.
+ *  @param Results			Destination of the results.
+ *  @param MaxResults		Size of Results, MRAM_BENCH_MAX_RESULTS for a full sweep.
+ *  @retval Amount of results written
+ */
+uint32_t MRAM_Bench_Sweep(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+		MRAM_BenchResultTypeDef *Results, uint32_t MaxResults)
+{
+	uint32_t count = 0;
+	uint8_t fill, status;
+
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* The reads are checked against the pattern */
+	fill = MRAM_Bench_Fill(hmram);
+
+	for (uint32_t m = 0; m < sizeof(BenchModes) / sizeof(BenchModes[0]); m++)
+	{
+		for (uint32_t d = 0; d < sizeof(BenchDummyCycles); d++)
+		{
+			Config.SpiInterfaceMode = BenchModes[m][1];
+			Config.DummyCycles = BenchDummyCycles[d];
+			status = fill;
+			if (status == HAL_OK)
+			{
+				status = EMXXLX_Set_Mode(hmram, Config, BenchModes[m][0]);
+			}
+
+			for (uint32_t p = 0; p < sizeof(BenchPrescalers); p++)
+			{
+				if (status == HAL_OK)
+				{
+					hmram->hospi->Init.ClockPrescaler = BenchPrescalers[p];
+					status = HAL_OSPI_Init(hmram->hospi);
+				}
+
+				for (uint8_t pattern = MRAM_BENCH_SEQUENTIAL; pattern <= MRAM_BENCH_STRIDED; pattern++)
+				{
+					for (uint8_t write = 0; write < 2; write++)
+					{
+						for (uint32_t s = 0; s < sizeof(BenchSizes) / sizeof(BenchSizes[0]); s++)
+						{
+							/* Octal DTR transfers move bytes by pairs */
+							if ((BenchModes[m][0] == EMXXLX_OCTAL_DTR_MODE) && ((BenchSizes[s] & 1U) != 0U))
+							{
+								continue;
+							}
+
+							if (count >= MaxResults)
+							{
+								return count;
+							}
+
+							memset(&Results[count], 0, sizeof(Results[count]));
+							Results[count].InterfaceMode = BenchModes[m][0];
+							Results[count].DummyCycles = BenchDummyCycles[d];
+							Results[count].ClockPrescaler = BenchPrescalers[p];
+							Results[count].Pattern = pattern;
+							Results[count].Write = write;
+							Results[count].Size = BenchSizes[s];
+							Results[count].Status = status;
+
+							if (status == HAL_OK)
+							{
+								MRAM_Bench_Measure(hmram, &Results[count]);
+							}
+							count++;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+/**
+ *  @brief Measure the memory-mapped reads of every access pattern and size,
+ * 		   with DCACHE1 disabled then enabled. The device is left in
+ * 		   indirect mode with DCACHE1 enabled.
+ *  @note  The first MRAM_BENCH_SPAN bytes of the memory are overwritten.
+ * 	@param hmram			MRAM device handle, the device must be initialized.
+ *  @param Config			Device configuration given to EMXXLX_Init.
+ *  @param InterfaceMode	InterfaceMode given to EMXXLX_Init.
+ *  @param Results			Destination of the results.
+ *  @param MaxResults		Size of Results, MRAM_BENCH_MAPPED_RESULTS for a full sweep.
+ *  @retval Amount of results written
+ */
+uint32_t MRAM_Bench_Mapped(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+		uint8_t InterfaceMode, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults)
+{
+	uint32_t count = 0;
+	uint8_t start, status;
+
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* The reads are checked against the pattern */
+	start = MRAM_Bench_Fill(hmram);
+	if (start == HAL_OK)
+	{
+		start = MRAM_MMAP_Start(hmram);
+	}
+
+	for (uint8_t access = MRAM_BENCH_MAPPED; access <= MRAM_BENCH_MAPPED_CACHED; access++)
+	{
+		/* Each pass has its own status, a failed pass does not fail the next one */
+		status = start;
+		if (status == HAL_OK)
+		{
+			status = MRAM_MMAP_Cache(hmram, access == MRAM_BENCH_MAPPED_CACHED);
+		}
+
+		for (uint8_t pattern = MRAM_BENCH_SEQUENTIAL; pattern <= MRAM_BENCH_STRIDED; pattern++)
+		{
+			for (uint32_t s = 0; s < sizeof(BenchSizes) / sizeof(BenchSizes[0]); s++)
+			{
+				if (count >= MaxResults)
+				{
+					MRAM_MMAP_Stop(hmram);
+					return count;
+				}
+
+				memset(&Results[count], 0, sizeof(Results[count]));
+				Results[count].InterfaceMode = InterfaceMode;
+				Results[count].DummyCycles = Config.DummyCycles;
+				Results[count].ClockPrescaler = hmram->hospi->Init.ClockPrescaler;
+				Results[count].Pattern = pattern;
+				Results[count].Access = access;
+				Results[count].Size = BenchSizes[s];
+				Results[count].Status = status;
+
+				if (status == HAL_OK)
+				{
+					MRAM_Bench_Measure(hmram, &Results[count]);
+				}
+				count++;
+			}
+		}
+	}
+
+	MRAM_MMAP_Stop(hmram);
+
+	return count;
+}
+
+/**
+ *  @brief Measure the puts then the gets of the key-value store for each
+ * 		   value size, each access on its own key. The keys are deleted
+ * 		   at the end.
+ * 	@param hkv				Mounted store with MRAM_BENCH_SAMPLES free slots.
+ *  @param Results			Destination of the results.
+ *  @param MaxResults		Size of Results, MRAM_BENCH_KV_RESULTS for a full sweep.
+ *  @retval Amount of results written
+ */
+uint32_t MRAM_Bench_KV(MRAM_KV_HandleTypeDef *hkv, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults)
+{
+	uint32_t count = 0;
+
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	BenchKv = hkv;
+
+	for (uint32_t s = 0; s < sizeof(BenchKvSizes) / sizeof(BenchKvSizes[0]); s++)
+	{
+		/* Puts first, the gets read the keys they stored */
+		for (uint8_t get = 0; get < 2; get++)
+		{
+			if (count >= MaxResults)
+			{
+				break;
+			}
+
+			memset(&Results[count], 0, sizeof(Results[count]));
+			Results[count].ClockPrescaler = hkv->hmram->hospi->Init.ClockPrescaler;
+			Results[count].Access = MRAM_BENCH_KV;
+			Results[count].Write = (get == 0);
+			Results[count].Size = BenchKvSizes[s];
+
+			MRAM_Bench_Measure(hkv->hmram, &Results[count]);
+			count++;
+		}
+	}
+
+	for (uint32_t i = 0; i < MRAM_BENCH_SAMPLES; i++)
+	{
+		MRAM_KV_Delete(hkv, MRAM_BENCH_KV_KEY + i);
+	}
+
+	return count;
+}
+
+/**
+ *  @brief Measure the append rate of the journal for each frame size. Each
+ * 		   sample appends a batch buffer worth of frames, waiting whenever
+ * 		   both buffers are being written, the throughput includes the
+ * 		   final MRAM_Journal_Sync. The journal is cleared before each size.
+ * 	@param hj				Open journal of at least MRAM_BENCH_JOURNAL_SIZE bytes.
+ *  @param Results			Destination of the results.
+ *  @param MaxResults		Size of Results, MRAM_BENCH_JOURNAL_RESULTS for a full sweep.
+ *  @retval Amount of results written
+ */
+uint32_t MRAM_Bench_Journal(MRAM_JOURNAL_HandleTypeDef *hj, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults)
+{
+	uint32_t count = 0, frames, start, begin;
+	uint8_t status;
+
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	for (uint32_t i = 0; i < MRAM_JOURNAL_BUFFER_SIZE; i++)
+	{
+		BenchBuffer[i] = (uint8_t)i;
+	}
+
+	for (uint32_t s = 0; (s < sizeof(BenchJournalSizes) / sizeof(BenchJournalSizes[0])) && (count < MaxResults); s++)
+	{
+		memset(&Results[count], 0, sizeof(Results[count]));
+		Results[count].ClockPrescaler = hj->hmram->hospi->Init.ClockPrescaler;
+		Results[count].Access = MRAM_BENCH_JOURNAL;
+		Results[count].Write = 1;
+		Results[count].Size = BenchJournalSizes[s];
+
+		/* Frames filling one batch buffer, with their length prefix */
+		frames = MRAM_JOURNAL_BUFFER_SIZE / (BenchJournalSizes[s] + sizeof(uint16_t));
+
+		status = MRAM_Journal_Clear(hj);
+		begin = DWT->CYCCNT;
+		for (uint32_t i = 0; (i < MRAM_BENCH_SAMPLES) && (status == HAL_OK); i++)
+		{
+			start = DWT->CYCCNT;
+			for (uint32_t f = 0; (f < frames) && (status == HAL_OK); f++)
+			{
+				do
+				{
+					status = MRAM_Journal_Append(hj, BenchBuffer, (uint16_t)BenchJournalSizes[s]);
+				} while (status == HAL_BUSY);
+			}
+			BenchSamples[i] = DWT->CYCCNT - start;
+		}
+
+		if (status == HAL_OK)
+		{
+			status = MRAM_Journal_Sync(hj, HAL_OSPI_TIMEOUT_DEFAULT_VALUE);
+		}
+
+		Results[count].Status = status;
+		if (status == HAL_OK)
+		{
+			MRAM_Bench_Summary(&Results[count], (uint64_t)BenchJournalSizes[s] * frames * MRAM_BENCH_SAMPLES,
+					DWT->CYCCNT - begin);
+			Results[count].Estimate = EMXXLX_Xfer_Time_ns(hj->hmram, 1, MRAM_JOURNAL_BUFFER_SIZE);
+		}
+		count++;
+	}
+
+	return count;
+}
+
+/**
+ *  @brief Compare the command templates of the driver with commands built on
+ * 		   each call, for small reads then writes. Both writes use the
+ * 		   same write enable and ready wait, only the command of the data
+ * 		   differs. For each size, the template result is followed by the
+ * 		   per-call build one, both sequential.
+ *  @note  The first MRAM_BENCH_SPAN bytes of the memory are overwritten.
+ * 	@param hmram			MRAM device handle, the device must be initialized.
+ *  @param Results			Destination of the results.
+ *  @param MaxResults		Size of Results, MRAM_BENCH_TEMPLATE_RESULTS for a full sweep.
+ *  @retval Amount of results written
+ */
+uint32_t MRAM_Bench_Templates(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults)
+{
+	uint32_t count = 0;
+
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* Writes first, the reads are checked against them */
+	for (uint8_t write = 2; write-- > 0;)
+	{
+		for (uint32_t s = 0; s < sizeof(BenchTemplateSizes) / sizeof(BenchTemplateSizes[0]); s++)
+		{
+			for (uint32_t a = 0; a < sizeof(BenchTemplateAccess); a++)
+			{
+				if (count >= MaxResults)
+				{
+					return count;
+				}
+
+				memset(&Results[count], 0, sizeof(Results[count]));
+				Results[count].ClockPrescaler = hmram->hospi->Init.ClockPrescaler;
+				Results[count].Pattern = MRAM_BENCH_SEQUENTIAL;
+				Results[count].Write = write;
+				Results[count].Access = BenchTemplateAccess[a];
+				Results[count].Size = BenchTemplateSizes[s];
+
+				MRAM_Bench_Measure(hmram, &Results[count]);
+				count++;
+			}
+		}
+	}
+
+	return count;
+}
+
+/**
+ *  @brief Compare the ready wait after a write through the OCTOSPI automatic
+ * 		   polling, EMXXLX_Polling_MemReady, with a software loop reading
+ * 		   the flag status register. Only the wait is timed, the write
+ * 		   before it is not. For each size, the automatic polling result
+ * 		   is followed by the software loop one, both sequential.
+ *  @note  The first MRAM_BENCH_SPAN bytes of the memory are overwritten. The
+ * 		   throughput is not measured.
+ * 	@param hmram			MRAM device handle, the device must be initialized.
+ *  @param Results			Destination of the results.
+ *  @param MaxResults		Size of Results, MRAM_BENCH_POLLING_RESULTS for a full sweep.
+ *  @retval Amount of results written
+ */
+uint32_t MRAM_Bench_Polling(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults)
+{
+	uint32_t count = 0, seed = 1, address, start;
+	uint64_t total;
+	MRAM_BenchResultTypeDef *result;
+
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	for (uint32_t s = 0; s < sizeof(BenchPollingSizes) / sizeof(BenchPollingSizes[0]); s++)
+	{
+		for (uint32_t a = 0; a < sizeof(BenchPollingAccess); a++)
+		{
+			if (count >= MaxResults)
+			{
+				return count;
+			}
+
+			result = &Results[count++];
+			memset(result, 0, sizeof(*result));
+			result->ClockPrescaler = hmram->hospi->Init.ClockPrescaler;
+			result->Pattern = MRAM_BENCH_SEQUENTIAL;
+			result->Write = 1;
+			result->Access = BenchPollingAccess[a];
+			result->Size = BenchPollingSizes[s];
+			total = 0;
+
+			for (uint32_t i = 0; (i < MRAM_BENCH_SAMPLES) && (result->Status == HAL_OK); i++)
+			{
+				address = MRAM_Bench_Address(result, i, &seed);
+				for (uint32_t j = 0; j < result->Size; j++)
+				{
+					BenchBuffer[j] = MRAM_Bench_Value(address + j);
+				}
+
+				if (EMXXLX_Write_Enable(hmram) != HAL_OK
+					|| EMXXLX_Write(hmram, address, BenchBuffer, result->Size) != HAL_OK)
+				{
+					result->Status = HAL_ERROR;
+					break;
+				}
+
+				start = DWT->CYCCNT;
+				result->Status = (result->Access == MRAM_BENCH_AUTOPOLL)
+						? EMXXLX_Polling_MemReady(hmram, HAL_OSPI_TIMEOUT_DEFAULT_VALUE)
+						: MRAM_Bench_Flag_Loop(hmram);
+				BenchSamples[i] = DWT->CYCCNT - start;
+				total += BenchSamples[i];
+			}
+
+			if (result->Status == HAL_OK)
+			{
+				MRAM_Bench_Summary(result, 0, total);
+			}
+		}
+	}
+
+	return count;
+}
+
+/**
+ *  @brief Compare EMXXLX_WriteBuffer with a caller that splits its writes in
+ * 		   OSPI_PAGE_SIZE commands, each with its own write enable and
+ * 		   ready wait. For each size, the EMXXLX_WriteBuffer result is
+ * 		   followed by the chunked one, both sequential.
+ *  @note  The first MRAM_BENCH_SPAN bytes of the memory are overwritten,
+ * 		   sizes must be even in octal DTR and dual-quad modes.
+ * 	@param hmram			MRAM device handle, the device must be initialized.
+ *  @param Results			Destination of the results.
+ *  @param MaxResults		Size of Results, MRAM_BENCH_CHUNKED_RESULTS for a full sweep.
+ *  @retval Amount of results written
+ */
+uint32_t MRAM_Bench_Chunked(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Results, uint32_t MaxResults)
+{
+	uint32_t count = 0;
+
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	for (uint32_t s = 0; s < sizeof(BenchSizes) / sizeof(BenchSizes[0]); s++)
+	{
+		for (uint32_t a = 0; a < sizeof(BenchChunkedAccess); a++)
+		{
+			if (count >= MaxResults)
+			{
+				return count;
+			}
+
+			memset(&Results[count], 0, sizeof(Results[count]));
+			Results[count].ClockPrescaler = hmram->hospi->Init.ClockPrescaler;
+			Results[count].Pattern = MRAM_BENCH_SEQUENTIAL;
+			Results[count].Write = 1;
+			Results[count].Access = BenchChunkedAccess[a];
+			Results[count].Size = BenchSizes[s];
+
+			MRAM_Bench_Measure(hmram, &Results[count]);
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/**
+ *  @brief Time MRAM_BENCH_SAMPLES accesses with the current device settings.
+ * 		   The DWT cycle counter must be running. Writes store the
+ * 		   MRAM_Bench_Value pattern and are read back, reads are checked
+ * 		   against it, outside of the timed accesses.
+ *  @note  Sizes in octal DTR and dual-quad modes must be even. Memory-mapped
+ * 		   accesses only read and need the device in memory-mapped mode.
+ * 		   Device reads need the pattern written first, see MRAM_Bench_Fill.
+ * 		   Key-value accesses use the store given to MRAM_Bench_KV.
+ * 	@param hmram			MRAM device handle.
+ *  @param Result			Pattern, Write, Access and Size set, the measures are filled.
+ *  @retval HAL status
+ */
+uint8_t MRAM_Bench_Measure(EMXXLX_HandleTypeDef *hmram, MRAM_BenchResultTypeDef *Result)
+{
+	uint32_t seed = 1, address, start, length;
+	uint64_t total = 0;
+
+	if ((Result->Size == 0) || (Result->Size > MRAM_BENCH_MAX_SIZE))
+	{
+		Result->Status = HAL_ERROR;
+		return HAL_ERROR;
+	}
+
+	for (uint32_t i = 0; i < Result->Size; i++)
+	{
+		BenchBuffer[i] = (uint8_t)i;
+	}
+
+	for (uint32_t i = 0; i < MRAM_BENCH_SAMPLES; i++)
+	{
+		address = MRAM_Bench_Address(Result, i, &seed);
+
+		if ((Result->Access != MRAM_BENCH_KV) && (Result->Write != 0))
+		{
+			for (uint32_t j = 0; j < Result->Size; j++)
+			{
+				BenchBuffer[j] = MRAM_Bench_Value(address + j);
+			}
+		}
+
+		start = DWT->CYCCNT;
+		if ((Result->Access == MRAM_BENCH_KV) && (Result->Write != 0))
+		{
+			Result->Status = MRAM_KV_Put(BenchKv, MRAM_BENCH_KV_KEY + i, BenchBuffer, Result->Size);
+		}
+		else if (Result->Access == MRAM_BENCH_KV)
+		{
+			length = MRAM_BENCH_MAX_SIZE;
+			Result->Status = MRAM_KV_Get(BenchKv, MRAM_BENCH_KV_KEY + i, BenchBuffer, &length);
+		}
+		else if (Result->Access == MRAM_BENCH_BUILT)
+		{
+			Result->Status = MRAM_Bench_Built(hmram, Result->Write, address, BenchBuffer, Result->Size);
+		}
+		else if (Result->Access == MRAM_BENCH_CHUNKED)
+		{
+			Result->Status = MRAM_Bench_Chunked_Write(hmram, address, BenchBuffer, Result->Size);
+		}
+		else if (Result->Access != MRAM_BENCH_COMMAND)
+		{
+			memcpy(BenchBuffer, (const void *)(MRAM_MMAP_BASE + address), Result->Size);
+			Result->Status = HAL_OK;
+		}
+		else if (Result->Write != 0)
+		{
+			Result->Status = EMXXLX_WriteBuffer(hmram, address, BenchBuffer, Result->Size);
+		}
+		else
+		{
+			Result->Status = EMXXLX_Read(hmram, address, BenchBuffer, Result->Size);
+		}
+		BenchSamples[i] = DWT->CYCCNT - start;
+
+		/* The data written is read back */
+		if ((Result->Status == HAL_OK) && (Result->Access != MRAM_BENCH_KV) && (Result->Write != 0))
+		{
+			Result->Status = EMXXLX_Read(hmram, address, BenchBuffer, Result->Size);
+		}
+
+		if ((Result->Status == HAL_OK) && (Result->Access != MRAM_BENCH_KV))
+		{
+			Result->Status = MRAM_Bench_Check(address, Result->Size);
+		}
+
+		if (Result->Status != HAL_OK)
+		{
+			return Result->Status;
+		}
+		total += BenchSamples[i];
+	}
+
+	MRAM_Bench_Summary(Result, (uint64_t)Result->Size * MRAM_BENCH_SAMPLES, total);
+	Result->Estimate = EMXXLX_Xfer_Time_ns(hmram, Result->Write, Result->Size);
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Byte stored at a memory address by the benchmark writes, the
+ * 		   reads are checked against it.
+ */
+static uint8_t MRAM_Bench_Value(uint32_t address)
+{
+	return (uint8_t)(address ^ (address >> 8) ^ (address >> 16));
+}
+
+/**
+ *  @brief Write the MRAM_Bench_Value pattern over MRAM_BENCH_SPAN.
+ * 	@param hmram			MRAM device handle, in indirect mode.
+ *  @retval HAL status
+ */
+static uint8_t MRAM_Bench_Fill(EMXXLX_HandleTypeDef *hmram)
+{
+	for (uint32_t address = 0; address < MRAM_BENCH_SPAN; address += MRAM_BENCH_MAX_SIZE)
+	{
+		for (uint32_t i = 0; i < MRAM_BENCH_MAX_SIZE; i++)
+		{
+			BenchBuffer[i] = MRAM_Bench_Value(address + i);
+		}
+
+		if (EMXXLX_WriteBuffer(hmram, address, BenchBuffer, MRAM_BENCH_MAX_SIZE) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Compare the transfer buffer with the pattern of a span.
+ *  @param address			Memory address of the first byte.
+ *  @param size				Bytes in BenchBuffer.
+ *  @retval HAL status, HAL_ERROR on the first mismatch
+ */
+static uint8_t MRAM_Bench_Check(uint32_t address, uint32_t size)
+{
+	for (uint32_t i = 0; i < size; i++)
+	{
+		if (BenchBuffer[i] != MRAM_Bench_Value(address + i))
+		{
+			return HAL_ERROR;
+		}
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Address of an access of the measure, kept inside MRAM_BENCH_SPAN
+ * 		   and aligned on 4 bytes.
+ *  @param Result			Measure settings.
+ *  @param Index			Index of the access.
+ *  @param Seed				State of the pseudo random generator.
+ *  @retval Memory address
+ */
+static uint32_t MRAM_Bench_Address(MRAM_BenchResultTypeDef *Result, uint32_t Index, uint32_t *Seed)
+{
+	uint32_t range = MRAM_BENCH_SPAN - Result->Size + 1U;
+
+	switch (Result->Pattern) {
+	case MRAM_BENCH_RANDOM:
+		*Seed = *Seed * 1664525U + 1013904223U;
+		return (*Seed % range) & ~3U;
+
+	case MRAM_BENCH_STRIDED:
+		return ((Index * ((Result->Size + 3U) & ~3U) + Index * MRAM_BENCH_STRIDE) % range) & ~3U;
+
+	default:
+		return ((Index * ((Result->Size + 3U) & ~3U)) % range) & ~3U;
+	}
+}
+
+/**
+ *  @brief Write the way a caller unaware of EMXXLX_WriteBuffer would: one
+ * 		   command per OSPI_PAGE_SIZE bytes, each with a write enable and
+ * 		   a ready wait.
+ */
+static uint8_t MRAM_Bench_Chunked_Write(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData,
+		uint32_t size)
+{
+	uint32_t chunk;
+
+	while (size > 0)
+	{
+		chunk = (size > OSPI_PAGE_SIZE) ? OSPI_PAGE_SIZE : size;
+
+		if (EMXXLX_Write_Enable(hmram) != HAL_OK
+			|| EMXXLX_Write(hmram, address, pData, chunk) != HAL_OK
+			|| EMXXLX_Polling_MemReady(hmram, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		address += chunk;
+		pData += chunk;
+		size -= chunk;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Fill the latencies and the throughput of a result from the
+ * 		   MRAM_BENCH_SAMPLES samples, which are sorted.
+ *  @param Result			Measure to be completed.
+ *  @param Bytes			Bytes moved during the measure.
+ *  @param Total			CPU cycles of the measure.
+ */
+static void MRAM_Bench_Summary(MRAM_BenchResultTypeDef *Result, uint64_t Bytes, uint64_t Total)
+{
+	MRAM_Bench_Sort(BenchSamples, MRAM_BENCH_SAMPLES);
+	Result->P50 = BenchSamples[MRAM_BENCH_SAMPLES / 2];
+	Result->P99 = BenchSamples[(MRAM_BENCH_SAMPLES * 99) / 100];
+	Result->Throughput = (uint32_t)((Bytes * SystemCoreClock) / (Total * 1000U));
+}
+
+/**
+ *  @brief Read or write the way the driver did before its command templates:
+ * 		   the command is cleared and filled from the interface settings of
+ * 		   the handle on each call. A write is preceded by a write enable
+ * 		   and followed by a ready wait, as in EMXXLX_WriteBuffer.
+ */
+static uint8_t MRAM_Bench_Built(EMXXLX_HandleTypeDef *hmram, uint8_t Write, uint32_t address, uint8_t *pData,
+		uint32_t size)
+{
+	OSPI_RegularCmdTypeDef sCommand = {0};
+
+	if ((Write != 0) && (EMXXLX_Write_Enable(hmram) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	sCommand.OperationType = HAL_OSPI_OPTYPE_COMMON_CFG;
+	sCommand.FlashId = HAL_OSPI_FLASH_ID_1;
+	sCommand.Instruction = (Write != 0) ? hmram->Write : hmram->Read;
+	sCommand.InstructionMode = hmram->InstMode;
+	sCommand.InstructionSize = HAL_OSPI_INSTRUCTION_8_BITS;
+	sCommand.Address = address;
+	sCommand.AddressMode = hmram->AddMode;
+	sCommand.AddressSize = hmram->AddSize;
+	sCommand.AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE;
+	sCommand.DataMode = hmram->DatMode;
+	sCommand.NbData = size;
+	sCommand.DummyCycles = (Write != 0) ? 0U : hmram->DC;
+	sCommand.DQSMode = (Write != 0) ? HAL_OSPI_DQS_DISABLE : hmram->DQSMode;
+	sCommand.SIOOMode = HAL_OSPI_SIOO_INST_EVERY_CMD;
+	if (hmram->Dtr != 0)
+	{
+		sCommand.InstructionDtrMode = HAL_OSPI_INSTRUCTION_DTR_ENABLE;
+		sCommand.AddressDtrMode = HAL_OSPI_ADDRESS_DTR_ENABLE;
+		sCommand.DataDtrMode = HAL_OSPI_DATA_DTR_ENABLE;
+	}
+
+	if (HAL_OSPI_Command(hmram->hospi, &sCommand, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	if (Write == 0)
+	{
+		return HAL_OSPI_Receive(hmram->hospi, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE);
+	}
+
+	if (HAL_OSPI_Transmit(hmram->hospi, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return EMXXLX_Polling_MemReady(hmram, HAL_OSPI_TIMEOUT_DEFAULT_VALUE);
+}
+
+/**
+ *  @brief Wait for the device to be ready by reading the flag status
+ * 		   register in a loop, one command per read.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+static uint8_t MRAM_Bench_Flag_Loop(EMXXLX_HandleTypeDef *hmram)
+{
+	uint32_t tickstart = HAL_GetTick();
+	uint8_t flags[2];
+
+	do
+	{
+		if ((EMXXLX_Read_Flags(hmram, flags) != HAL_OK)
+			|| ((HAL_GetTick() - tickstart) > HAL_OSPI_TIMEOUT_DEFAULT_VALUE))
+		{
+			return HAL_ERROR;
+		}
+	} while ((flags[0] & MRAM_FLAG_READY) == 0U);
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Sort the latency samples in ascending order.
+ */
+static void MRAM_Bench_Sort(uint32_t *Samples, uint32_t Count)
+{
+	uint32_t value, j;
+
+	for (uint32_t i = 1; i < Count; i++)
+	{
+		value = Samples[i];
+		for (j = i; (j > 0) && (Samples[j - 1] > value); j--)
+		{
+			Samples[j] = Samples[j - 1];
+		}
+		Samples[j] = value;
+	}
+}
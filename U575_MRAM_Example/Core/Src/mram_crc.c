@@ -0,0 +1,37 @@
+/*
+ * mram_crc.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "mram_crc.h"
+
+// CRC32 (reflected 0xEDB88320) of one nibble
+
+static const uint32_t CrcTable[16] = {
+	0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+	0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU,
+};
+
+/**
+ *  @brief Update a CRC32 with Size bytes, a nibble at a time. Start from
+ * 		   MRAM_CRC_INIT and invert the result. Shared by the key-value
+ * 		   store and the journal.
+ *  @param Crc				CRC of the previous bytes.
+ *  @param pData			Bytes to be added.
+ *  @param Size				Amount of bytes.
+ *  @retval Updated CRC
+ */
+uint32_t MRAM_Crc(uint32_t Crc, const void *pData, uint32_t Size)
+{
+	const uint8_t *pByte = pData;
+
+	while (Size-- > 0)
+	{
+		Crc ^= *pByte++;
+		Crc = (Crc >> 4) ^ CrcTable[Crc & 0x0FU];
+		Crc = (Crc >> 4) ^ CrcTable[Crc & 0x0FU];
+	}
+
+	return Crc;
+}
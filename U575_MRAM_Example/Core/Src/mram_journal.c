@@ -0,0 +1,412 @@
+/*
+ * mram_journal.c
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "mram_journal.h"
+#include "mram_crc.h"
+#include <stddef.h>
+#include <string.h>
+
+static uint8_t MRAM_Journal_Write_Header(MRAM_JOURNAL_HandleTypeDef *hj);
+static uint8_t MRAM_Journal_Check_Header(MRAM_JOURNAL_HeaderTypeDef *Header);
+static uint8_t MRAM_Journal_Check(MRAM_JOURNAL_HandleTypeDef *hj, MRAM_JOURNAL_BlockTypeDef *Block,
+		uint32_t Offset);
+static uint8_t MRAM_Journal_Start(MRAM_JOURNAL_HandleTypeDef *hj);
+static void MRAM_Journal_Callback(EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context);
+
+/**
+ *  @brief Open the journal at Base and find the end of its committed
+ * 		   blocks, only the commit records are read. An empty journal is
+ * 		   written when no header copy is valid, with an epoch above the
+ * 		   one of any block left on the device.
+ * 	@param hj				Journal handle.
+ *  @param hmram			MRAM device handle, the device must be initialized.
+ *  @param Base				Device address of the journal, a multiple of 4.
+ *  @param Size				Device bytes of the journal.
+ *  @retval HAL status
+ */
+uint8_t MRAM_Journal_Open(MRAM_JOURNAL_HandleTypeDef *hj, EMXXLX_HandleTypeDef *hmram, uint32_t Base,
+		uint32_t Size)
+{
+	MRAM_JOURNAL_HeaderTypeDef header[2];
+	MRAM_JOURNAL_BlockTypeDef block;
+	uint32_t offset = MRAM_JOURNAL_FIRST_BLOCK;
+	uint8_t valid = 0;
+
+	if (((Base & 3U) != 0U) || (Size < MRAM_JOURNAL_FIRST_BLOCK + sizeof(block)))
+	{
+		return HAL_ERROR;
+	}
+
+	hj->hmram = hmram;
+	hj->Base = Base;
+	hj->Size = Size;
+	hj->Dropped = 0;
+	hj->Fill = 0;
+	hj->Used[0] = hj->Used[1] = 0;
+	hj->Count[0] = hj->Count[1] = 0;
+	hj->Pending = MRAM_JOURNAL_NONE;
+	hj->Stage = MRAM_JOURNAL_IDLE;
+	hj->Status = HAL_OK;
+	hj->Blocks = 0;
+	hj->Frames = 0;
+
+	if (EMXXLX_Read(hmram, Base, (uint8_t *)header, sizeof(header)) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	/* A torn header write leaves the other copy, with the previous epoch */
+	for (uint8_t c = 0; c < 2; c++)
+	{
+		if ((MRAM_Journal_Check_Header(&header[c]) == HAL_OK) && ((valid == 0) || (header[c].Epoch > hj->Epoch)))
+		{
+			hj->Epoch = header[c].Epoch;
+			valid = 1;
+		}
+	}
+
+	if (valid == 0)
+	{
+		/* Every epoch starts writing at the first block, its record holds the latest epoch
+		   of the device. Restarting from a fixed epoch would bring stale blocks back */
+		if (EMXXLX_Read(hmram, Base + offset, (uint8_t *)&block, sizeof(block)) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		hj->Epoch = block.Epoch;
+		hj->Epoch = (MRAM_Journal_Check(hj, &block, offset) == HAL_OK) ? block.Epoch + 1U : 1U;
+		hj->Tail = hj->Next = offset;
+		hj->NextSeq = 0;
+
+		return MRAM_Journal_Write_Header(hj);
+	}
+
+	/* Walk the commit records up to the first invalid one */
+	while (offset + sizeof(block) <= Size)
+	{
+		if (EMXXLX_Read(hmram, Base + offset, (uint8_t *)&block, sizeof(block)) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		if (MRAM_Journal_Check(hj, &block, offset) != HAL_OK || (block.Seq != hj->Blocks))
+		{
+			break;
+		}
+
+		offset += sizeof(block) + block.Length;
+		hj->Blocks++;
+		hj->Frames += block.Frames;
+	}
+
+	hj->Tail = hj->Next = offset;
+	hj->NextSeq = hj->Blocks;
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Drop every block, a single header write starts a new epoch. The
+ * 		   other header copy keeps the previous epoch until it is done.
+ * 	@param hj				Journal handle.
+ *  @retval HAL status, HAL_BUSY while a block is being written
+ */
+uint8_t MRAM_Journal_Clear(MRAM_JOURNAL_HandleTypeDef *hj)
+{
+	if (hj->Pending != MRAM_JOURNAL_NONE)
+	{
+		return HAL_BUSY;
+	}
+
+	hj->Epoch++;
+	hj->Tail = hj->Next = MRAM_JOURNAL_FIRST_BLOCK;
+	hj->NextSeq = 0;
+	hj->Blocks = 0;
+	hj->Frames = 0;
+	hj->Used[hj->Fill] = 0;
+	hj->Count[hj->Fill] = 0;
+	hj->Status = HAL_OK;
+
+	return MRAM_Journal_Write_Header(hj);
+}
+
+/**
+ *  @brief Add a frame to the batch buffer. A full buffer is written to the
+ * 		   device in the background with one DMA transfer while the frames
+ * 		   go to the other one.
+ * 	@param hj				Journal handle.
+ *  @param pFrame			Frame.
+ *  @param Length			Bytes of the frame.
+ *  @retval HAL status, HAL_BUSY when both buffers are busy and the frame is
+ * 			dropped, HAL_ERROR when the journal is full or a write failed
+ */
+uint8_t MRAM_Journal_Append(MRAM_JOURNAL_HandleTypeDef *hj, const uint8_t *pFrame, uint16_t Length)
+{
+	uint32_t record = sizeof(Length) + Length;
+	uint8_t *pBuffer;
+	uint8_t status;
+
+	if ((hj->Status != HAL_OK) || (record > MRAM_JOURNAL_BUFFER_SIZE))
+	{
+		return HAL_ERROR;
+	}
+
+	if (hj->Used[hj->Fill] + record > MRAM_JOURNAL_BUFFER_SIZE)
+	{
+		status = MRAM_Journal_Start(hj);
+		if (status == HAL_BUSY)
+		{
+			hj->Dropped++;
+		}
+		if (status != HAL_OK)
+		{
+			return status;
+		}
+	}
+
+	/* The block of this buffer must fit in the journal */
+	if (hj->Next + sizeof(MRAM_JOURNAL_BlockTypeDef) + ((hj->Used[hj->Fill] + record + 3U) & ~3U) > hj->Size)
+	{
+		return HAL_ERROR;
+	}
+
+	pBuffer = (uint8_t *)hj->Buffer[hj->Fill] + hj->Used[hj->Fill];
+	memcpy(pBuffer, &Length, sizeof(Length));
+	memcpy(pBuffer + sizeof(Length), pFrame, Length);
+	hj->Used[hj->Fill] += record;
+	hj->Count[hj->Fill]++;
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Start writing the frames of the batch buffer without waiting for
+ * 		   it to be full.
+ * 	@param hj				Journal handle.
+ *  @retval HAL status, HAL_BUSY while the other buffer is being written
+ */
+uint8_t MRAM_Journal_Flush(MRAM_JOURNAL_HandleTypeDef *hj)
+{
+	if (hj->Status != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return MRAM_Journal_Start(hj);
+}
+
+/**
+ *  @brief Write every appended frame and wait for its commit.
+ * 	@param hj				Journal handle.
+ *  @param Timeout			Timeout duration in ms.
+ *  @retval HAL status
+ */
+uint8_t MRAM_Journal_Sync(MRAM_JOURNAL_HandleTypeDef *hj, uint32_t Timeout)
+{
+	uint32_t tickstart = HAL_GetTick();
+
+	while ((hj->Status == HAL_OK) && ((hj->Used[hj->Fill] != 0U) || (hj->Pending != MRAM_JOURNAL_NONE)))
+	{
+		if (hj->Pending == MRAM_JOURNAL_NONE)
+		{
+			MRAM_Journal_Start(hj);
+		}
+
+		if ((HAL_GetTick() - tickstart) > Timeout)
+		{
+			return HAL_TIMEOUT;
+		}
+	}
+
+	return hj->Status;
+}
+
+/**
+ *  @brief Read a committed block and its frames, each frame is prefixed by
+ * 		   its uint16_t length.
+ * 	@param hj				Journal handle.
+ *  @param Offset			0 for the first block, advanced to the next one.
+ *  @param Block			Destination of the commit record.
+ *  @param pFrames			Destination of the frames.
+ *  @param Size				Size of pFrames, MRAM_JOURNAL_BUFFER_SIZE holds any block.
+ *  @retval HAL status, HAL_ERROR after the last committed block
+ */
+uint8_t MRAM_Journal_ReadBlock(MRAM_JOURNAL_HandleTypeDef *hj, uint32_t *Offset, MRAM_JOURNAL_BlockTypeDef *Block,
+		uint8_t *pFrames, uint32_t Size)
+{
+	uint32_t offset = (*Offset < MRAM_JOURNAL_FIRST_BLOCK) ? MRAM_JOURNAL_FIRST_BLOCK : *Offset;
+
+	/* The device cannot be read during the background writes */
+	if (hj->Pending != MRAM_JOURNAL_NONE)
+	{
+		return HAL_BUSY;
+	}
+
+	if ((offset + sizeof(*Block) > hj->Tail)
+		|| (EMXXLX_Read(hj->hmram, hj->Base + offset, (uint8_t *)Block, sizeof(*Block)) != HAL_OK)
+		|| (MRAM_Journal_Check(hj, Block, offset) != HAL_OK) || (Block->Length > Size))
+	{
+		return HAL_ERROR;
+	}
+
+	if ((Block->Length != 0U) && (EMXXLX_Read(hj->hmram, hj->Base + offset + sizeof(*Block), pFrames,
+			Block->Length) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	*Offset = offset + sizeof(*Block) + Block->Length;
+	return HAL_OK;
+}
+
+/**
+ *  @brief Write the header copy of the current epoch.
+ * 	@param hj				Journal handle.
+ *  @retval HAL status
+ */
+static uint8_t MRAM_Journal_Write_Header(MRAM_JOURNAL_HandleTypeDef *hj)
+{
+	MRAM_JOURNAL_HeaderTypeDef header = {0};
+
+	header.Magic = MRAM_JOURNAL_MAGIC;
+	header.Version = MRAM_JOURNAL_VERSION;
+	header.Epoch = hj->Epoch;
+	header.Crc = ~MRAM_Crc(MRAM_CRC_INIT, &header, offsetof(MRAM_JOURNAL_HeaderTypeDef, Crc));
+
+	return EMXXLX_WriteBuffer(hj->hmram, hj->Base + (hj->Epoch & 1U) * sizeof(header), (uint8_t *)&header,
+			sizeof(header));
+}
+
+/**
+ *  @brief Check a header copy.
+ *  @param Header			Header copy read from the device.
+ *  @retval HAL status
+ */
+static uint8_t MRAM_Journal_Check_Header(MRAM_JOURNAL_HeaderTypeDef *Header)
+{
+	if ((Header->Magic != MRAM_JOURNAL_MAGIC) || (Header->Version != MRAM_JOURNAL_VERSION)
+		|| (Header->Crc != ~MRAM_Crc(MRAM_CRC_INIT, Header, offsetof(MRAM_JOURNAL_HeaderTypeDef, Crc))))
+	{
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Check a commit record of the current epoch read at Offset.
+ * 	@param hj				Journal handle.
+ *  @param Block			Commit record.
+ *  @param Offset			Offset of the block in the journal.
+ *  @retval HAL status
+ */
+static uint8_t MRAM_Journal_Check(MRAM_JOURNAL_HandleTypeDef *hj, MRAM_JOURNAL_BlockTypeDef *Block,
+		uint32_t Offset)
+{
+	if ((Block->Magic != MRAM_JOURNAL_BLOCK_MAGIC) || (Block->Epoch != hj->Epoch)
+		|| (Block->Length > MRAM_JOURNAL_BUFFER_SIZE) || ((Block->Length & 3U) != 0U)
+		|| (Offset + sizeof(*Block) + Block->Length > hj->Size)
+		|| (Block->Crc != ~MRAM_Crc(MRAM_CRC_INIT, Block, offsetof(MRAM_JOURNAL_BlockTypeDef, Crc))))
+	{
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Start writing the batch buffer as the next block, its frames
+ * 		   first. The commit record is written from MRAM_Journal_Callback
+ * 		   once they are on the device.
+ * 	@param hj				Journal handle.
+ *  @retval HAL status, HAL_BUSY while the other buffer is being written
+ */
+static uint8_t MRAM_Journal_Start(MRAM_JOURNAL_HandleTypeDef *hj)
+{
+	uint8_t fill = hj->Fill;
+	uint32_t length = (hj->Used[fill] + 3U) & ~3U;
+
+	if (hj->Used[fill] == 0U)
+	{
+		return HAL_OK;
+	}
+
+	if (hj->Pending != MRAM_JOURNAL_NONE)
+	{
+		return HAL_BUSY;
+	}
+
+	memset((uint8_t *)hj->Buffer[fill] + hj->Used[fill], 0, length - hj->Used[fill]);
+
+	hj->Commit.Magic = MRAM_JOURNAL_BLOCK_MAGIC;
+	hj->Commit.Epoch = hj->Epoch;
+	hj->Commit.Seq = hj->NextSeq;
+	hj->Commit.Length = length;
+	hj->Commit.Frames = hj->Count[fill];
+	hj->Commit.Crc = ~MRAM_Crc(MRAM_CRC_INIT, &hj->Commit, offsetof(MRAM_JOURNAL_BlockTypeDef, Crc));
+
+	/* Only one block is written at a time, it starts at Tail */
+	hj->Pending = fill;
+	hj->Stage = MRAM_JOURNAL_PAYLOAD;
+	hj->Next += sizeof(MRAM_JOURNAL_BlockTypeDef) + length;
+	hj->NextSeq++;
+
+	hj->Fill = fill ^ 1U;
+	hj->Used[hj->Fill] = 0;
+	hj->Count[hj->Fill] = 0;
+
+	if (EMXXLX_WriteAsync_DMA(hj->hmram, hj->Base + hj->Tail + sizeof(MRAM_JOURNAL_BlockTypeDef),
+			(uint8_t *)hj->Buffer[fill], length, MRAM_Journal_Callback, hj) != HAL_OK)
+	{
+		hj->Status = HAL_ERROR;
+		hj->Stage = MRAM_JOURNAL_IDLE;
+		hj->Pending = MRAM_JOURNAL_NONE;
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Completion of the background writes, called from the OSPI
+ * 		   interrupt. The frames of a block are followed by its commit
+ * 		   record, the block is then committed and its buffer released.
+ *  @note  The commit record write is only started here: EMXXLX_WriteAsync_DMA
+ * 		   sends its write enable with HAL_OSPI_Command_IT and returns, the
+ * 		   rest of the write is chained from the next interrupts.
+ *  @note  After a failed write no more frames are accepted, MRAM_Journal_Open
+ * 		   recovers the committed blocks.
+ */
+static void MRAM_Journal_Callback(EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context)
+{
+	MRAM_JOURNAL_HandleTypeDef *hj = (MRAM_JOURNAL_HandleTypeDef *)Context;
+
+	if ((Status == HAL_OK) && (hj->Stage == MRAM_JOURNAL_PAYLOAD))
+	{
+		hj->Stage = MRAM_JOURNAL_COMMIT;
+		Status = EMXXLX_WriteAsync_DMA(hmram, hj->Base + hj->Tail, (uint8_t *)&hj->Commit,
+				sizeof(hj->Commit), MRAM_Journal_Callback, hj);
+		if (Status == HAL_OK)
+		{
+			return;
+		}
+	}
+
+	if (Status == HAL_OK)
+	{
+		hj->Tail += sizeof(MRAM_JOURNAL_BlockTypeDef) + hj->Commit.Length;
+		hj->Blocks++;
+		hj->Frames += hj->Commit.Frames;
+	}
+	else
+	{
+		hj->Status = HAL_ERROR;
+	}
+
+	hj->Stage = MRAM_JOURNAL_IDLE;
+	hj->Pending = MRAM_JOURNAL_NONE;
+}
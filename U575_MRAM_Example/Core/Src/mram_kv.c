@@ -0,0 +1,418 @@
+/*
+ * mram_kv.c
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "mram_kv.h"
+#include "mram_crc.h"
+#include <stddef.h>
+#include <string.h>
+
+/* The RAM index keeps the value lengths in uint8_t */
+_Static_assert(MRAM_KV_VALUE_SIZE <= 255U, "MRAM_KV_VALUE_SIZE does not fit MRAM_KV_HandleTypeDef.Length");
+
+static uint32_t MRAM_KV_Copy_Crc(uint32_t Key, MRAM_KV_CopyTypeDef *Copy);
+static uint32_t MRAM_KV_Address(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot);
+static uint32_t MRAM_KV_Copy_Address(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot, uint32_t Seq);
+static uint32_t MRAM_KV_Hash(uint32_t Key);
+static uint32_t MRAM_KV_Find(MRAM_KV_HandleTypeDef *hkv, uint32_t Key);
+static void MRAM_KV_Index_Insert(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot);
+static void MRAM_KV_Index_Remove(MRAM_KV_HandleTypeDef *hkv, uint32_t Position);
+static uint8_t MRAM_KV_Write_Copy(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot, uint32_t Seq,
+		const uint8_t *pValue, uint32_t Length);
+
+/**
+ *  @brief Write an empty store at Base and mount it.
+ * 	@param hkv				Store handle.
+ *  @param hmram			MRAM device handle, the device must be initialized.
+ *  @param Base				Device address of the store, a multiple of 4, MRAM_KV_SIZE bytes are used.
+ *  @retval HAL status
+ */
+uint8_t MRAM_KV_Format(MRAM_KV_HandleTypeDef *hkv, EMXXLX_HandleTypeDef *hmram, uint32_t Base)
+{
+	MRAM_KV_HeaderTypeDef header = {0};
+	uint32_t key = MRAM_KV_EMPTY_KEY;
+
+	hkv->hmram = hmram;
+	hkv->Base = Base;
+
+	/* Free slots first, the header makes the store valid */
+	for (uint32_t i = 0; i < MRAM_KV_SLOTS; i++)
+	{
+		if (EMXXLX_WriteBuffer(hmram, MRAM_KV_Address(hkv, i), (uint8_t *)&key, sizeof(key)) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+	}
+
+	header.Magic = MRAM_KV_MAGIC;
+	header.Version = MRAM_KV_VERSION;
+	header.Slots = MRAM_KV_SLOTS;
+	header.ValueSize = MRAM_KV_VALUE_SIZE;
+	header.Crc = ~MRAM_Crc(MRAM_CRC_INIT, &header, offsetof(MRAM_KV_HeaderTypeDef, Crc));
+
+	if (EMXXLX_WriteBuffer(hmram, Base, (uint8_t *)&header, sizeof(header)) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return MRAM_KV_Mount(hkv, hmram, Base);
+}
+
+/**
+ *  @brief Check the store at Base and rebuild the RAM index from its slots.
+ * 		   The current copy of each slot is the valid one with the highest
+ * 		   sequence number, an interrupted update keeps the previous value.
+ * 	@param hkv				Store handle.
+ *  @param hmram			MRAM device handle, the device must be initialized.
+ *  @param Base				Device address of the store.
+ *  @retval HAL status, MRAM_KV_NO_STORE when the header does not have the
+ * 			store magic, HAL_ERROR on a read error or a damaged header
+ * 			or a store of another layout, which must not be formatted
+ * 			blindly
+ */
+uint8_t MRAM_KV_Mount(MRAM_KV_HandleTypeDef *hkv, EMXXLX_HandleTypeDef *hmram, uint32_t Base)
+{
+	MRAM_KV_HeaderTypeDef header;
+	MRAM_KV_SlotTypeDef slot;
+	int8_t current;
+
+	hkv->hmram = hmram;
+	hkv->Base = Base;
+	hkv->Count = 0;
+	hkv->NextFree = 0;
+	memset(hkv->Index, 0xFF, sizeof(hkv->Index));
+
+	if (EMXXLX_Read(hmram, Base, (uint8_t *)&header, sizeof(header)) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	if (header.Magic != MRAM_KV_MAGIC)
+	{
+		return MRAM_KV_NO_STORE;
+	}
+
+	if ((header.Version != MRAM_KV_VERSION)
+		|| (header.Slots != MRAM_KV_SLOTS) || (header.ValueSize != MRAM_KV_VALUE_SIZE)
+		|| (header.Crc != ~MRAM_Crc(MRAM_CRC_INIT, &header, offsetof(MRAM_KV_HeaderTypeDef, Crc))))
+	{
+		return HAL_ERROR;
+	}
+
+	for (uint32_t i = 0; i < MRAM_KV_SLOTS; i++)
+	{
+		hkv->Key[i] = MRAM_KV_EMPTY_KEY;
+
+		if (EMXXLX_Read(hmram, MRAM_KV_Address(hkv, i), (uint8_t *)&slot, sizeof(slot)) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		if (slot.Key == MRAM_KV_EMPTY_KEY)
+		{
+			continue;
+		}
+
+		current = -1;
+		for (uint8_t c = 0; c < 2; c++)
+		{
+			if (((slot.Copy[c].Seq & 1U) != c) || (slot.Copy[c].Length > MRAM_KV_VALUE_SIZE)
+				|| (slot.Copy[c].Crc != MRAM_KV_Copy_Crc(slot.Key, &slot.Copy[c])))
+			{
+				continue;
+			}
+
+			if ((current < 0) || ((int32_t)(slot.Copy[c].Seq - slot.Copy[current].Seq) > 0))
+			{
+				current = c;
+			}
+		}
+
+		/* A slot without committed copy or a duplicate key is free */
+		if ((current < 0) || (MRAM_KV_Find(hkv, slot.Key) != MRAM_KV_INDEX_SIZE))
+		{
+			continue;
+		}
+
+		hkv->Key[i] = slot.Key;
+		hkv->Seq[i] = slot.Copy[current].Seq;
+		hkv->Length[i] = slot.Copy[current].Length;
+		MRAM_KV_Index_Insert(hkv, i);
+		hkv->Count++;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Read the value of a key, one device read.
+ * 	@param hkv				Store handle.
+ *  @param Key				Key, any value but MRAM_KV_EMPTY_KEY.
+ *  @param pValue			Destination of the value.
+ *  @param Length			Size of pValue, set to the length of the value.
+ *  @retval HAL status, HAL_ERROR when the key is not stored or pValue is too small
+ */
+uint8_t MRAM_KV_Get(MRAM_KV_HandleTypeDef *hkv, uint32_t Key, uint8_t *pValue, uint32_t *Length)
+{
+	uint32_t position = MRAM_KV_Find(hkv, Key);
+	uint32_t slot, size;
+
+	if (position == MRAM_KV_INDEX_SIZE)
+	{
+		return HAL_ERROR;
+	}
+
+	slot = hkv->Index[position];
+	if (hkv->Length[slot] > *Length)
+	{
+		return HAL_ERROR;
+	}
+
+	/* Even sizes for the octal DTR and dual-quad modes */
+	size = (hkv->Length[slot] + 1U) & ~1U;
+	if ((size != 0U) && (EMXXLX_Read(hkv->hmram, MRAM_KV_Copy_Address(hkv, slot, hkv->Seq[slot])
+			+ offsetof(MRAM_KV_CopyTypeDef, Value), hkv->Buffer.Value, size) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	memcpy(pValue, hkv->Buffer.Value, hkv->Length[slot]);
+	*Length = hkv->Length[slot];
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Store the value of a key in place, no erase is needed. The copy
+ * 		   which is not current is written then committed, a power loss
+ * 		   keeps either the previous or the new value.
+ * 	@param hkv				Store handle.
+ *  @param Key				Key, any value but MRAM_KV_EMPTY_KEY.
+ *  @param pValue			Value.
+ *  @param Length			Bytes of the value, up to MRAM_KV_VALUE_SIZE.
+ *  @retval HAL status, HAL_ERROR when the store is full
+ */
+uint8_t MRAM_KV_Put(MRAM_KV_HandleTypeDef *hkv, uint32_t Key, const uint8_t *pValue, uint32_t Length)
+{
+	uint32_t position = MRAM_KV_Find(hkv, Key);
+	uint32_t invalid[2] = {0};
+	uint32_t slot;
+
+	if ((Key == MRAM_KV_EMPTY_KEY) || (Length > MRAM_KV_VALUE_SIZE))
+	{
+		return HAL_ERROR;
+	}
+
+	if (position != MRAM_KV_INDEX_SIZE)
+	{
+		slot = hkv->Index[position];
+		if (MRAM_KV_Write_Copy(hkv, slot, hkv->Seq[slot] + 1U, pValue, Length) != HAL_OK)
+		{
+			return HAL_ERROR;
+		}
+
+		hkv->Seq[slot]++;
+		hkv->Length[slot] = Length;
+		return HAL_OK;
+	}
+
+	if (hkv->Count >= MRAM_KV_SLOTS)
+	{
+		return HAL_ERROR;
+	}
+
+	for (slot = hkv->NextFree; hkv->Key[slot] != MRAM_KV_EMPTY_KEY; slot = (slot + 1U) % MRAM_KV_SLOTS)
+	{
+	}
+
+	/* Copy 0 is invalidated, copy 1 written, the key write commits the slot */
+	hkv->Key[slot] = Key;
+	if (EMXXLX_WriteBuffer(hkv->hmram, MRAM_KV_Copy_Address(hkv, slot, 0U), (uint8_t *)invalid,
+			sizeof(invalid)) != HAL_OK
+		|| MRAM_KV_Write_Copy(hkv, slot, 1U, pValue, Length) != HAL_OK
+		|| EMXXLX_WriteBuffer(hkv->hmram, MRAM_KV_Address(hkv, slot), (uint8_t *)&Key, sizeof(Key)) != HAL_OK)
+	{
+		hkv->Key[slot] = MRAM_KV_EMPTY_KEY;
+		return HAL_ERROR;
+	}
+
+	hkv->Seq[slot] = 1U;
+	hkv->Length[slot] = Length;
+	hkv->NextFree = (slot + 1U) % MRAM_KV_SLOTS;
+	MRAM_KV_Index_Insert(hkv, slot);
+	hkv->Count++;
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Remove a key, its slot is freed by a single key write.
+ * 	@param hkv				Store handle.
+ *  @param Key				Key.
+ *  @retval HAL status, HAL_ERROR when the key is not stored
+ */
+uint8_t MRAM_KV_Delete(MRAM_KV_HandleTypeDef *hkv, uint32_t Key)
+{
+	uint32_t position = MRAM_KV_Find(hkv, Key);
+	uint32_t empty = MRAM_KV_EMPTY_KEY;
+	uint32_t slot;
+
+	if (position == MRAM_KV_INDEX_SIZE)
+	{
+		return HAL_ERROR;
+	}
+
+	slot = hkv->Index[position];
+	if (EMXXLX_WriteBuffer(hkv->hmram, MRAM_KV_Address(hkv, slot), (uint8_t *)&empty, sizeof(empty)) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	hkv->Key[slot] = MRAM_KV_EMPTY_KEY;
+	MRAM_KV_Index_Remove(hkv, position);
+	hkv->Count--;
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Write the copy Seq & 1 of a slot, the value first and then its
+ * 		   commit record, Seq and Crc.
+ * 	@param hkv				Store handle.
+ *  @param Slot				Slot, its key already set in hkv->Key.
+ *  @param Seq				Sequence number of the new copy.
+ *  @param pValue			Value.
+ *  @param Length			Bytes of the value.
+ *  @retval HAL status
+ */
+static uint8_t MRAM_KV_Write_Copy(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot, uint32_t Seq,
+		const uint8_t *pValue, uint32_t Length)
+{
+	MRAM_KV_CopyTypeDef *copy = &hkv->Buffer;
+	uint32_t address = MRAM_KV_Copy_Address(hkv, Slot, Seq);
+	uint32_t size = (Length + 1U) & ~1U;
+
+	copy->Seq = Seq;
+	copy->Length = Length;
+	memcpy(copy->Value, pValue, Length);
+	if (size != Length)
+	{
+		copy->Value[Length] = 0;
+	}
+	copy->Crc = MRAM_KV_Copy_Crc(hkv->Key[Slot], copy);
+
+	if (EMXXLX_WriteBuffer(hkv->hmram, address + offsetof(MRAM_KV_CopyTypeDef, Length),
+			(uint8_t *)&copy->Length, sizeof(copy->Length) + size) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	return EMXXLX_WriteBuffer(hkv->hmram, address, (uint8_t *)copy, offsetof(MRAM_KV_CopyTypeDef, Length));
+}
+
+/**
+ *  @brief Commit CRC of a copy, over the key, Seq, Length and the value.
+ */
+static uint32_t MRAM_KV_Copy_Crc(uint32_t Key, MRAM_KV_CopyTypeDef *Copy)
+{
+	uint32_t crc = MRAM_Crc(MRAM_CRC_INIT, &Key, sizeof(Key));
+
+	crc = MRAM_Crc(crc, &Copy->Seq, sizeof(Copy->Seq));
+	crc = MRAM_Crc(crc, &Copy->Length, sizeof(Copy->Length));
+
+	return ~MRAM_Crc(crc, Copy->Value, Copy->Length);
+}
+
+/**
+ *  @brief Device address of a slot.
+ */
+static uint32_t MRAM_KV_Address(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot)
+{
+	return hkv->Base + sizeof(MRAM_KV_HeaderTypeDef) + Slot * sizeof(MRAM_KV_SlotTypeDef);
+}
+
+/**
+ *  @brief Device address of the copy Seq & 1 of a slot.
+ */
+static uint32_t MRAM_KV_Copy_Address(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot, uint32_t Seq)
+{
+	return MRAM_KV_Address(hkv, Slot) + offsetof(MRAM_KV_SlotTypeDef, Copy)
+			+ (Seq & 1U) * sizeof(MRAM_KV_CopyTypeDef);
+}
+
+/**
+ *  @brief Home position of a key in the RAM index, Fibonacci hashing.
+ */
+static uint32_t MRAM_KV_Hash(uint32_t Key)
+{
+	return (Key * 2654435769U) >> (32U - MRAM_KV_INDEX_BITS);
+}
+
+/**
+ *  @brief Position of a key in the RAM index.
+ *  @retval Position, MRAM_KV_INDEX_SIZE when the key is not stored
+ */
+static uint32_t MRAM_KV_Find(MRAM_KV_HandleTypeDef *hkv, uint32_t Key)
+{
+	uint32_t position = MRAM_KV_Hash(Key);
+
+	/* The index is never full, a free entry ends the probe */
+	while (hkv->Index[position] != MRAM_KV_NO_SLOT)
+	{
+		if (hkv->Key[hkv->Index[position]] == Key)
+		{
+			return position;
+		}
+		position = (position + 1U) & (MRAM_KV_INDEX_SIZE - 1U);
+	}
+
+	return MRAM_KV_INDEX_SIZE;
+}
+
+/**
+ *  @brief Add a slot to the RAM index, at the first free entry from the
+ * 		   home position of its key.
+ */
+static void MRAM_KV_Index_Insert(MRAM_KV_HandleTypeDef *hkv, uint32_t Slot)
+{
+	uint32_t position = MRAM_KV_Hash(hkv->Key[Slot]);
+
+	while (hkv->Index[position] != MRAM_KV_NO_SLOT)
+	{
+		position = (position + 1U) & (MRAM_KV_INDEX_SIZE - 1U);
+	}
+
+	hkv->Index[position] = Slot;
+}
+
+/**
+ *  @brief Remove an entry of the RAM index. The following entries of the
+ * 		   probe sequence are shifted back, so that no tombstone is needed.
+ */
+static void MRAM_KV_Index_Remove(MRAM_KV_HandleTypeDef *hkv, uint32_t Position)
+{
+	uint32_t mask = MRAM_KV_INDEX_SIZE - 1U;
+	uint32_t next = Position;
+	uint32_t home;
+
+	while (1)
+	{
+		next = (next + 1U) & mask;
+		if (hkv->Index[next] == MRAM_KV_NO_SLOT)
+		{
+			break;
+		}
+
+		/* The entry may move back unless its home lies in (Position, next] */
+		home = MRAM_KV_Hash(hkv->Key[hkv->Index[next]]);
+		if (((next - home) & mask) >= ((next - Position) & mask))
+		{
+			hkv->Index[Position] = hkv->Index[next];
+			Position = next;
+		}
+	}
+
+	hkv->Index[Position] = MRAM_KV_NO_SLOT;
+}
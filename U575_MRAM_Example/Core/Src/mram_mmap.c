@@ -0,0 +1,141 @@
+/*
+ * mram_mmap.c
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "mram_mmap.h"
+
+static uint8_t MRAM_MMAP_MPU_Config(EMXXLX_HandleTypeDef *hmram);
+
+/**
+ *  @brief Memory-mapped read profile: memory-mapped mode with nCS held low
+ * 		   between sequential accesses, ICACHE in 2-ways with the device
+ * 		   remapped at MRAM_MMAP_ALIAS, MPU region and DCACHE1 over the
+ * 		   OCTOSPI window. The reads skip the opcode when the device was
+ * 		   initialized with MRAM_XIP_ENABLE or MRAM_XIP_BOOT, otherwise the
+ * 		   cache line refills wrap as set by Config.WrapConfiguration.
+ * 	@param hmram			MRAM device handle, the device must be initialized.
+ *  @retval HAL status
+ */
+uint8_t MRAM_MMAP_Start(EMXXLX_HandleTypeDef *hmram)
+{
+	ICACHE_RegionConfigTypeDef Region = {0};
+
+	/* Sets the OCTOSPI wrap size the cache bursts must follow */
+	if ((MRAM_MMAP_MPU_Config(hmram) != HAL_OK) || (EMXXLX_MemoryMapped_Continuous(hmram) != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	/* Code fetched from the alias goes through ICACHE on the fast bus */
+	Region.BaseAddress = MRAM_MMAP_ALIAS;
+	Region.RemapAddress = MRAM_MMAP_BASE;
+	Region.Size = MRAM_MMAP_ALIAS_SIZE;
+	Region.TrafficRoute = ICACHE_MASTER2_PORT;
+	Region.OutputBurstType = (hmram->hospi->Init.WrapSize != HAL_OSPI_WRAP_NOT_SUPPORTED) ?
+			ICACHE_OUTPUT_BURST_WRAP : ICACHE_OUTPUT_BURST_INCR;
+
+	/* The associativity and the remap regions can only be changed while the cache is disabled */
+	if ((HAL_ICACHE_Disable() != HAL_OK) || (HAL_ICACHE_ConfigAssociativityMode(ICACHE_2WAYS) != HAL_OK)
+			|| (HAL_ICACHE_DisableRemapRegion(MRAM_MMAP_ICACHE_REGION) != HAL_OK)
+			|| (HAL_ICACHE_EnableRemapRegion(MRAM_MMAP_ICACHE_REGION, &Region) != HAL_OK)
+			|| (HAL_ICACHE_Enable() != HAL_OK))
+	{
+		return HAL_ERROR;
+	}
+
+	return MRAM_MMAP_Cache(hmram, 1);
+}
+
+/**
+ *  @brief Leave the memory-mapped mode so that the driver commands can be
+ * 		   used again. DCACHE1 stays enabled, the region is write-through.
+ *  @note  No code or constant placed with MRAM_MMAP_TEXT or MRAM_MMAP_RODATA
+ * 		   may be used until the next MRAM_MMAP_Start.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+uint8_t MRAM_MMAP_Stop(EMXXLX_HandleTypeDef *hmram)
+{
+	return EMXXLX_MemoryMapped_Exit(hmram);
+}
+
+/**
+ *  @brief Enable or disable DCACHE1. The HAL DCACHE module is not part of the
+ * 		   project, the cache is driven through its registers.
+ *  @note  Wrapped reads are only issued for the line refills of the cache,
+ * 		   with the cache disabled the CPU accesses use incrementing reads.
+ * 	@param hmram			MRAM device handle, in memory-mapped mode.
+ *  @param Enable			1 to invalidate and enable the cache, 0 to disable it.
+ *  @retval HAL status
+ */
+uint8_t MRAM_MMAP_Cache(EMXXLX_HandleTypeDef *hmram, uint8_t Enable)
+{
+	uint32_t tickstart = HAL_GetTick();
+	uint8_t wrap = (hmram->hospi->Init.WrapSize != HAL_OSPI_WRAP_NOT_SUPPORTED);
+
+	__HAL_RCC_DCACHE1_CLK_ENABLE();
+	CLEAR_BIT(DCACHE1->CR, DCACHE_CR_EN);
+
+	while ((DCACHE1->SR & DCACHE_SR_BUSYF) != 0U)
+	{
+		if ((HAL_GetTick() - tickstart) > HAL_OSPI_TIMEOUT_DEFAULT_VALUE)
+		{
+			return HAL_TIMEOUT;
+		}
+	}
+
+	if (Enable == 0)
+	{
+		return HAL_OK;
+	}
+
+	/* Line refills follow the OCTOSPI wrap size, incrementing bursts without it */
+	MODIFY_REG(DCACHE1->CR, DCACHE_CR_HBURST, (wrap != 0) ? 0U : DCACHE_CR_HBURST);
+	SET_BIT(DCACHE1->CR, DCACHE_CR_EN);
+	SET_BIT(DCACHE1->CR, DCACHE_CR_CACHEINV);
+
+	while ((DCACHE1->SR & DCACHE_SR_BUSYF) != 0U)
+	{
+		if ((HAL_GetTick() - tickstart) > HAL_OSPI_TIMEOUT_DEFAULT_VALUE)
+		{
+			return HAL_TIMEOUT;
+		}
+	}
+	WRITE_REG(DCACHE1->FCR, DCACHE_FCR_CBSYENDF);
+
+	return HAL_OK;
+}
+
+/**
+ *  @brief Map the device window as normal memory, write-through with read
+ * 		   allocation, so that DCACHE1 keeps the lines it reads.
+ * 	@param hmram			MRAM device handle.
+ *  @retval HAL status
+ */
+static uint8_t MRAM_MMAP_MPU_Config(EMXXLX_HandleTypeDef *hmram)
+{
+	MPU_Attributes_InitTypeDef MPU_Attributes = {0};
+	MPU_Region_InitTypeDef MPU_Region = {0};
+
+	HAL_MPU_Disable();
+
+	MPU_Attributes.Number = MRAM_MMAP_MPU_ATTRIBUTES;
+	MPU_Attributes.Attributes = INNER_OUTER(MPU_WRITE_THROUGH | MPU_NON_TRANSIENT | MPU_R_ALLOCATE);
+	HAL_MPU_ConfigMemoryAttributes(&MPU_Attributes);
+
+	MPU_Region.Enable = MPU_REGION_ENABLE;
+	MPU_Region.Number = MRAM_MMAP_MPU_REGION;
+	MPU_Region.BaseAddress = MRAM_MMAP_BASE;
+	MPU_Region.LimitAddress = MRAM_MMAP_BASE + (1UL << hmram->hospi->Init.DeviceSize) - 1U;
+	MPU_Region.AttributesIndex = MRAM_MMAP_MPU_ATTRIBUTES;
+	MPU_Region.AccessPermission = MPU_REGION_ALL_RW;
+	MPU_Region.DisableExec = MPU_INSTRUCTION_ACCESS_ENABLE;
+	MPU_Region.IsShareable = MPU_ACCESS_NOT_SHAREABLE;
+	HAL_MPU_ConfigRegion(&MPU_Region);
+
+	HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+
+	return HAL_OK;
+}
@@ -57,6 +57,7 @@
 /* External variables --------------------------------------------------------*/
 extern OSPI_HandleTypeDef hospi1;
 /* USER CODE BEGIN EV */
+extern DMA_HandleTypeDef handle_GPDMA1_Channel0;
 
 /* USER CODE END EV */
 
@@ -214,4 +215,12 @@ void OCTOSPI1_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles GPDMA1 Channel 0 global interrupt.
+  */
+void GPDMA1_Channel0_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&handle_GPDMA1_Channel0);
+}
+
 /* USER CODE END 1 */
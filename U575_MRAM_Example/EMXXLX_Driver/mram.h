@@ -10,6 +10,22 @@
 #ifndef INC_MRAM_H_
 #define INC_MRAM_H_
 
+/* Uncomment to let EMXXLX_Read program the OCTOSPI registers directly instead
+   of going through HAL_OSPI_Command and HAL_OSPI_Receive */
+/* #define EMXXLX_USE_LL_READ */
+
+/* Uncomment to record call counts, bytes and DWT cycles of the blocking
+   operations, read back with EMXXLX_GetStats */
+/* #define EMXXLX_USE_STATS */
+
+/* Uncomment to log every command issued by the driver in the EMXXLX_Trace
+   ring buffer, placed in SRAM4 by the .sram4 section of the linker script */
+/* #define EMXXLX_USE_TRACE */
+
+/* Uncomment to put the device in deep power-down once idle, see
+   EMXXLX_Power_Config. The next command wakes it up */
+/* #define EMXXLX_USE_POWER */
+
 typedef struct
 {
   uint8_t SpiInterfaceMode;     				/*!< It configures the OCTOSPI interface mode.
@@ -46,29 +62,359 @@ typedef struct
                                     	  	  	  	  This parameter can be either MRAM_OTPLOCK_ENABLE or MRAM_OTPLOCK_DISABLE */
 } EMXXLX_ConfigurationTypeDef;
 
+typedef struct
+{
+  OSPI_RegularCmdTypeDef Read;					/*!< Memory read command, address and length set per call */
+
+  OSPI_RegularCmdTypeDef Write;					/*!< Memory write command, address and length set per call */
+
+  OSPI_RegularCmdTypeDef WriteEnable;			/*!< Write enable latch command */
+
+  OSPI_RegularCmdTypeDef ReadFlags;				/*!< Flag status register read command */
+
+  uint32_t ReadCcr;								/*!< CCR value of the read command, used by the low-level read path */
+} EMXXLX_CommandSetTypeDef;
+
+#if defined(EMXXLX_USE_STATS)
+#define EMXXLX_STATS_BUCKETS		16 // Latency histogram buckets, doubling from one to the next
+#define EMXXLX_STATS_FIRST_BUCKET	6 // Bucket n > 0 starts at 2^(n + 6) cycles
+
+/** @defgroup EMXXLX_Stats_Operation EMXXLX Stats Operation
+  * @{
+  */
+#define EMXXLX_STAT_READ						0x00U // EMXXLX_Read
+#define EMXXLX_STAT_WRITE						0x01U // EMXXLX_Write
+#define EMXXLX_STAT_MEMREADY					0x02U // EMXXLX_Polling_MemReady, time spent waiting for ready
+#define EMXXLX_STAT_REGISTER					0x03U // Register reads and writes
+#define EMXXLX_STAT_COUNT						0x04U // Number of instrumented operations
+/**
+  * @}
+  */
+
+typedef struct
+{
+  uint32_t Calls;								/*!< Number of calls */
+
+  uint32_t Errors;								/*!< Calls which did not return HAL_OK */
+
+  uint64_t Bytes;								/*!< Bytes moved by the successful calls */
+
+  uint64_t Cycles;								/*!< Cumulative DWT cycles */
+
+  uint32_t MaxCycles;							/*!< Longest call in DWT cycles */
+
+  uint32_t Histogram[EMXXLX_STATS_BUCKETS];		/*!< Calls per latency bucket, see EMXXLX_STATS_FIRST_BUCKET */
+} EMXXLX_OpStatsTypeDef;
+
+typedef struct
+{
+  EMXXLX_OpStatsTypeDef Op[EMXXLX_STAT_COUNT];	/*!< Indexed by @ref EMXXLX_Stats_Operation */
+} EMXXLX_StatsTypeDef;
+#endif /* EMXXLX_USE_STATS */
+
+#if defined(EMXXLX_USE_TRACE)
+#define EMXXLX_TRACE_ENTRIES		512 // Trace ring buffer entries, a power of 2
+#define EMXXLX_TRACE_MAGIC			0x54584D45U // "EMXT", marks an initialized trace
+
+/** @defgroup EMXXLX_Trace_Mode EMXXLX Trace Mode
+  * @{
+  */
+#define EMXXLX_TRACE_IMODE_Pos					0U // Instruction line mode, 0 for none, n for 2^(n-1) lines
+#define EMXXLX_TRACE_ADMODE_Pos					3U // Address line mode, same encoding
+#define EMXXLX_TRACE_DMODE_Pos					6U // Data line mode, same encoding
+#define EMXXLX_TRACE_DTR						0x0200U // Double transfer rate
+#define EMXXLX_TRACE_DQS						0x0400U // Data sampled on DQS
+#define EMXXLX_TRACE_DUALQUAD					0x0800U // Issued to a dual-quad pair
+/**
+  * @}
+  */
+
+typedef struct
+{
+  uint32_t Timestamp;							/*!< DWT cycle counter when the command is issued */
+
+  uint32_t Address;								/*!< Address phase value */
+
+  uint32_t NbData;								/*!< Data phase length */
+
+  uint8_t Instruction;							/*!< Instruction opcode */
+
+  uint8_t Port;									/*!< OCTOSPI instance, 1 or 2 */
+
+  uint16_t Mode;								/*!< Phase modes, see @ref EMXXLX_Trace_Mode */
+} EMXXLX_TraceEntryTypeDef;
+
+typedef struct
+{
+  uint32_t Magic;								/*!< EMXXLX_TRACE_MAGIC once initialized */
+
+  uint32_t EntrySize;							/*!< sizeof(EMXXLX_TraceEntryTypeDef) */
+
+  uint32_t Entries;								/*!< EMXXLX_TRACE_ENTRIES */
+
+  volatile uint32_t Head;						/*!< Commands logged, the newest is Entry[(Head - 1) % Entries] */
+
+  EMXXLX_TraceEntryTypeDef Entry[EMXXLX_TRACE_ENTRIES];	/*!< Ring buffer */
+} EMXXLX_TraceTypeDef;
+
+extern EMXXLX_TraceTypeDef EMXXLX_Trace;
+#endif /* EMXXLX_USE_TRACE */
+
+#if defined(EMXXLX_USE_POWER)
+#define EMXXLX_DPD_EXIT_US			400U // Device wake-up time after MRAM_DPD_EXIT_CMD
+#define EMXXLX_POWER_VCC_MV			1800U // Supply voltage of the energy estimate
+#define EMXXLX_POWER_STANDBY_UA		150U // Typical standby current, from the datasheet of the part
+#define EMXXLX_POWER_DPD_UA			5U // Typical deep power-down current, from the datasheet of the part
+
+/** @defgroup EMXXLX_Power_State EMXXLX Power State
+  * @{
+  */
+#define EMXXLX_POWER_STANDBY					0x00U // Ready for the next command
+#define EMXXLX_POWER_DPD						0x01U // Deep power-down, woken up by the next command
+#define EMXXLX_POWER_STATES						0x02U // Number of power states
+/**
+  * @}
+  */
+
+typedef struct
+{
+  uint8_t State;								/*!< Current state, a value of @ref EMXXLX_Power_State */
+
+  uint32_t IdleTimeout;							/*!< Idle time in ms before the deep power-down, 0 disables it */
+
+  uint32_t LastAccess;							/*!< HAL tick of the last command */
+
+  uint32_t StateTick;							/*!< HAL tick of the last state change */
+
+  uint64_t TimeMs[EMXXLX_POWER_STATES];			/*!< Time spent in each state, indexed by @ref EMXXLX_Power_State */
+
+  uint32_t Wakeups;								/*!< Deep power-down exits */
+
+  uint64_t WakeCycles;							/*!< Cumulative DWT cycles spent waking up */
+
+  uint32_t MaxWakeCycles;						/*!< Longest wake-up in DWT cycles */
+} EMXXLX_PowerTypeDef;
+
+typedef struct
+{
+  uint64_t TimeMs[EMXXLX_POWER_STATES];			/*!< Time spent in each state, the current one included */
+
+  uint64_t EnergyUj[EMXXLX_POWER_STATES];		/*!< Estimated energy of each state in uJ */
+
+  uint32_t Wakeups;								/*!< Deep power-down exits */
+
+  uint32_t WakeLatencyUs;						/*!< Average wake-up latency in us */
+
+  uint32_t MaxWakeLatencyUs;					/*!< Longest wake-up latency in us */
+} EMXXLX_PowerStatsTypeDef;
+#endif /* EMXXLX_USE_POWER */
+
+typedef struct
+{
+  uint8_t Valid;								/*!< Non zero once EMXXLX_Calibrate found a stable window */
+
+  uint8_t InterfaceMode;						/*!< InterfaceMode given to EMXXLX_Init during the calibration */
+
+  uint32_t ClockPrescaler;						/*!< OCTOSPI clock prescaler */
+
+  uint32_t SampleShifting;						/*!< OCTOSPI sample shifting, HAL_OSPI_SAMPLE_SHIFTING_xxx */
+
+  uint32_t DelayHoldQuarterCycle;				/*!< OCTOSPI data hold, HAL_OSPI_DHQC_xxx */
+
+  uint32_t DelayBlockBypass;					/*!< HAL_OSPI_DELAY_BLOCK_USED or HAL_OSPI_DELAY_BLOCK_BYPASSED */
 
-uint8_t EMXXLX_Init(OSPI_HandleTypeDef *Ctx, EMXXLX_ConfigurationTypeDef Config,
+  uint32_t Units;								/*!< Delay block unit delay */
+
+  uint32_t PhaseSel;							/*!< Delay block output clock phase, center of the window */
+
+  uint8_t DsDelay;								/*!< Added DS delay, see the Added DS Delay Values */
+
+  uint8_t Window;								/*!< Passing delay block phases around PhaseSel */
+} EMXXLX_CalibrationTypeDef;
+
+struct __EMXXLX_HandleTypeDef;
+
+/**
+  * @brief Asynchronous transfer completion callback, called from interrupt
+  * 	   context with the HAL status of the transfer and the caller context.
+  */
+typedef void (*EMXXLX_CallbackTypeDef)(struct __EMXXLX_HandleTypeDef *hmram, uint8_t Status, void *Context);
+
+typedef struct __EMXXLX_HandleTypeDef
+{
+  OSPI_HandleTypeDef *hospi;					/*!< OCTOSPI peripheral driving the device, set before EMXXLX_Init */
+
+  uint32_t InstMode;							/*!< Instruction mode */
+
+  uint32_t Read;								/*!< Read command */
+
+  uint32_t Write;								/*!< Write command */
+
+  uint32_t AddMode;								/*!< Address mode */
+
+  uint32_t DatMode;								/*!< Data mode */
+
+  uint32_t AddSize;								/*!< Address size */
+
+  uint32_t CfgDc;								/*!< Dummy cycles for configuration phase */
+
+  uint32_t DC;									/*!< Dummy cycles for operation phase */
+
+  uint8_t Dtr;									/*!< Non zero when every phase runs at double transfer rate */
+
+  uint32_t DQSMode;								/*!< DQS sampling of the reads, HAL_OSPI_DQS_ENABLE or HAL_OSPI_DQS_DISABLE */
+
+  uint8_t Xip;									/*!< XIP configuration of the device, MRAM_XIP_DISABLE, MRAM_XIP_ENABLE or MRAM_XIP_BOOT */
+
+  uint8_t Wrap;									/*!< Wrap configuration of the memory-mapped reads, see the Wrap Configuration Values */
+
+  uint8_t EraseValue;							/*!< Erased bit value, MRAM_ERASE_VALUE_1 or MRAM_ERASE_VALUE_0 */
+
+  uint8_t Regs[2][9];							/*!< Nonvolatile [0] and volatile [1] configuration registers as last written */
+
+  uint8_t RegsValid;							/*!< Non zero once EMXXLX_Init checked Regs against the device */
+
+  EMXXLX_CommandSetTypeDef CmdSet;				/*!< Command templates of the hot paths */
+
+  EMXXLX_CalibrationTypeDef Calibration;		/*!< Bus timings applied by EMXXLX_Init, see EMXXLX_Calibrate */
+
+  volatile uint8_t XferState;					/*!< Ongoing background transfer, a value of @ref EMXXLX_Transfer_State */
+
+  volatile uint8_t XferStep;					/*!< Step of the ongoing write or erase command, a value of @ref EMXXLX_Transfer_Step */
+
+  uint8_t *XferBuffer;							/*!< Next buffer position to be transferred */
+
+  uint32_t XferAddress;							/*!< Next memory address to be transferred */
+
+  uint32_t XferRemaining;						/*!< Bytes left to be transferred */
+
+  EMXXLX_CallbackTypeDef XferCallback;			/*!< Asynchronous completion callback */
+
+  void *XferContext;							/*!< Caller context given back to XferCallback */
+
+  uint32_t XferSize;							/*!< Bytes of the background erase, see EMXXLX_Erase_Progress */
+
+  uint32_t XferTickstart;						/*!< HAL tick when the background erase started */
+
+  uint32_t XferTimeout;							/*!< Timeout of the background erase in ms, HAL_MAX_DELAY for none */
+#if defined(EMXXLX_USE_STATS)
+
+  EMXXLX_StatsTypeDef Stats;					/*!< Statistics of the blocking operations */
+#endif
+#if defined(EMXXLX_USE_POWER)
+
+  EMXXLX_PowerTypeDef Power;					/*!< Deep power-down manager, see EMXXLX_Power_Config */
+#endif
+} EMXXLX_HandleTypeDef;
+
+#define EMXXLX_STRIPE_DEVICES		2 // Devices of a striped volume, up to EMXXLX_MAX_DEVICES
+
+struct __EMXXLX_StripeTypeDef;
+
+/**
+  * @brief Striped volume completion callback, called from interrupt context
+  * 	   once every device is done, with the HAL status of the transfer.
+  */
+typedef void (*EMXXLX_StripeCallbackTypeDef)(struct __EMXXLX_StripeTypeDef *hstripe, uint8_t Status, void *Context);
+
+typedef struct __EMXXLX_StripeTypeDef
+{
+  EMXXLX_HandleTypeDef *Dev[EMXXLX_STRIPE_DEVICES];	/*!< Initialized devices, on distinct OCTOSPI instances */
+
+  uint32_t StripeSize;							/*!< Bytes stored on one device before moving to the next one */
+
+  uint8_t *Buffer;								/*!< Buffer of the ongoing transfer */
+
+  uint32_t Address;								/*!< Volume address of the ongoing transfer */
+
+  uint32_t Size;								/*!< Size of the ongoing transfer */
+
+  uint32_t Offset[EMXXLX_STRIPE_DEVICES];		/*!< Next buffer offset to be transferred by each device */
+
+  uint8_t State;								/*!< EMXXLX_XFER_RX_DMA or EMXXLX_XFER_TX_DMA */
+
+  volatile uint8_t Pending;						/*!< Bit n is set while Dev[n] is transferring */
+
+  uint8_t Status;								/*!< HAL status of the ongoing transfer */
+
+  EMXXLX_StripeCallbackTypeDef Callback;		/*!< Completion callback */
+
+  void *Context;								/*!< Caller context given back to Callback */
+} EMXXLX_StripeTypeDef;
+
+
+uint8_t EMXXLX_Init(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
+		uint8_t InterfaceMode);
+uint8_t EMXXLX_Set_Mode(EMXXLX_HandleTypeDef *hmram, EMXXLX_ConfigurationTypeDef Config,
 		uint8_t InterfaceMode);
-uint8_t EMXXLX_Refactor(OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_MemoryMapped_Config (OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_Erase_Chip(OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_Reset(OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_Read_ID(OSPI_HandleTypeDef *Ctx, uint8_t *Value);
-uint8_t EMXXLX_Read_Nonvol(OSPI_HandleTypeDef *Ctx,uint32_t address, uint8_t *Value, uint8_t size);
-uint8_t EMXXLX_Read_Vol(OSPI_HandleTypeDef *Ctx,uint32_t address, uint8_t *Value, uint8_t size);
-uint8_t EMXXLX_Write_Nonvol(OSPI_HandleTypeDef *Ctx, uint32_t address, uint8_t *pData, uint8_t size);
-uint8_t EMXXLX_Write_Vol(OSPI_HandleTypeDef *Ctx, uint32_t address, uint8_t *pData, uint8_t size);
-uint8_t EMXXLX_Read_Flags(OSPI_HandleTypeDef *Ctx, uint8_t *Value);
-uint8_t EMXXLX_Clear_flags(OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_Write_Status(OSPI_HandleTypeDef *Ctx, uint8_t *pData);
-uint8_t EMXXLX_Read_Status(OSPI_HandleTypeDef *Ctx, uint8_t *Value);
-uint8_t EMXXLX_Write_Enable(OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_Write_Disable(OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_Read(OSPI_HandleTypeDef *Ctx, uint32_t address, uint8_t *pData, uint32_t size);
-uint8_t EMXXLX_Write(OSPI_HandleTypeDef *Ctx, uint32_t address, uint8_t *Value, uint32_t size);
-uint8_t EMXXLX_4BADD_Enable(OSPI_HandleTypeDef *Ctx);
-uint8_t EMXXLX_Polling_MemReady(OSPI_HandleTypeDef *Ctx, uint32_t Timeout);
-void jesd_reset();
+uint8_t EMXXLX_Refactor(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_MemoryMapped_Config (EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_MemoryMapped_Continuous(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_MemoryMapped_Exit(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Erase_Chip(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Erase_Range(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint32_t size);
+uint8_t EMXXLX_EraseAsync(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint32_t size,
+		uint32_t Timeout, EMXXLX_CallbackTypeDef Callback, void *Context);
+uint8_t EMXXLX_Erase_ChipAsync(EMXXLX_HandleTypeDef *hmram, uint32_t Timeout,
+		EMXXLX_CallbackTypeDef Callback, void *Context);
+uint32_t EMXXLX_Erase_Progress(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Abort(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Reset(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Read_ID(EMXXLX_HandleTypeDef *hmram, uint8_t *Value);
+uint8_t EMXXLX_Read_Nonvol(EMXXLX_HandleTypeDef *hmram,uint32_t address, uint8_t *Value, uint8_t size);
+uint8_t EMXXLX_Read_Vol(EMXXLX_HandleTypeDef *hmram,uint32_t address, uint8_t *Value, uint8_t size);
+uint8_t EMXXLX_Write_Nonvol(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData, uint8_t size);
+uint8_t EMXXLX_Write_Vol(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData, uint8_t size);
+uint8_t EMXXLX_Read_Flags(EMXXLX_HandleTypeDef *hmram, uint8_t *Value);
+uint8_t EMXXLX_Clear_flags(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Write_Status(EMXXLX_HandleTypeDef *hmram, uint8_t *pData);
+uint8_t EMXXLX_Read_Status(EMXXLX_HandleTypeDef *hmram, uint8_t *Value);
+uint8_t EMXXLX_Write_Enable(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Write_Disable(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Read(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData, uint32_t size);
+uint8_t EMXXLX_Write(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value, uint32_t size);
+uint8_t EMXXLX_WriteBuffer(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData, uint32_t size);
+uint8_t EMXXLX_Read_DMA(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData, uint32_t size);
+uint8_t EMXXLX_Write_DMA(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value, uint32_t size);
+uint8_t EMXXLX_WriteAsync_DMA(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value, uint32_t size,
+		EMXXLX_CallbackTypeDef Callback, void *Context);
+uint8_t EMXXLX_ReadAsync(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *pData, uint32_t size,
+		EMXXLX_CallbackTypeDef Callback, void *Context);
+uint8_t EMXXLX_WriteAsync(EMXXLX_HandleTypeDef *hmram, uint32_t address, uint8_t *Value, uint32_t size,
+		EMXXLX_CallbackTypeDef Callback, void *Context);
+uint8_t EMXXLX_Get_XferState(EMXXLX_HandleTypeDef *hmram);
+uint32_t EMXXLX_Xfer_Cycles(EMXXLX_HandleTypeDef *hmram, uint8_t Write, uint32_t size);
+uint32_t EMXXLX_Xfer_Time_ns(EMXXLX_HandleTypeDef *hmram, uint8_t Write, uint32_t size);
+uint8_t EMXXLX_Calibrate(EMXXLX_HandleTypeDef *hmram, uint8_t InterfaceMode, uint32_t address);
+uint8_t EMXXLX_AutoTune(EMXXLX_HandleTypeDef *hmram, uint32_t ClockPrescaler, uint32_t address);
+uint8_t EMXXLX_Set_Dummy(EMXXLX_HandleTypeDef *hmram, uint8_t DummyCycles);
+#if defined(EMXXLX_USE_TRACE)
+void EMXXLX_Trace_Reset(void);
+#endif
+#if defined(EMXXLX_USE_STATS)
+void EMXXLX_GetStats(EMXXLX_HandleTypeDef *hmram, EMXXLX_StatsTypeDef *Stats);
+void EMXXLX_ResetStats(EMXXLX_HandleTypeDef *hmram);
+#endif
+#if defined(EMXXLX_USE_POWER)
+void EMXXLX_Power_Config(EMXXLX_HandleTypeDef *hmram, uint32_t IdleTimeout);
+uint8_t EMXXLX_Power_Process(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Power_Down(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Power_Wake(EMXXLX_HandleTypeDef *hmram);
+void EMXXLX_GetPower(EMXXLX_HandleTypeDef *hmram, EMXXLX_PowerStatsTypeDef *Stats);
+#endif
+uint8_t EMXXLX_Stripe_Read(EMXXLX_StripeTypeDef *hstripe, uint32_t address, uint8_t *pData, uint32_t size,
+		EMXXLX_StripeCallbackTypeDef Callback, void *Context);
+uint8_t EMXXLX_Stripe_Write(EMXXLX_StripeTypeDef *hstripe, uint32_t address, uint8_t *Value, uint32_t size,
+		EMXXLX_StripeCallbackTypeDef Callback, void *Context);
+uint8_t EMXXLX_4BADD_Enable(EMXXLX_HandleTypeDef *hmram);
+uint8_t EMXXLX_Polling_MemReady(EMXXLX_HandleTypeDef *hmram, uint32_t Timeout);
+uint8_t EMXXLX_Polling_MemReady_IT(EMXXLX_HandleTypeDef *hmram, EMXXLX_CallbackTypeDef Callback,
+		void *Context);
+void jesd_reset(EMXXLX_HandleTypeDef *hmram);
+
+void EMXXLX_RxCpltCallback(EMXXLX_HandleTypeDef *hmram);
+void EMXXLX_TxCpltCallback(EMXXLX_HandleTypeDef *hmram);
+void EMXXLX_ErrorCallback(EMXXLX_HandleTypeDef *hmram);
 
 
 /* Exported constants --------------------------------------------------------*/
@@ -78,7 +424,60 @@ void jesd_reset();
 
 #define OSPI_FLASH_SIZE 			27
 #define OSPI_PAGE_SIZE 				256
-#define OSPI_END_ADDR               (1 << OSPI_FLASH_SIZE)
+#define OSPI_END_ADDR               (1UL << OSPI_FLASH_SIZE)
+#define EMXXLX_MAX_DEVICES			2 // Devices driven at the same time, one per OCTOSPI
+#define EMXXLX_DMA_MAX_XFER			0x8000U // Largest data phase of one write command or DMA block
+#define EMXXLX_ISR_BUSY_SPINS		1000U // BUSY flag reads before a command chained from interrupt context fails
+#define EMXXLX_DUALQUAD_MODE		0x44U // InterfaceMode of two quad devices sharing one OCTOSPI port
+#define EMXXLX_QUAD_DTR_MODE		0x48U // InterfaceMode of quad DTR, 4D-4D-4D
+#define EMXXLX_OCTAL_DTR_MODE		0x88U // InterfaceMode of octal DTR, 8D-8D-8D
+#define EMXXLX_CAL_PATTERN_SIZE		32U // Bytes of the calibration reference pattern
+#define EMXXLX_CAL_MAX_PRESCALER	4U // Slowest clock prescaler of the calibration, the pattern is written at it
+#define EMXXLX_CAL_MIN_WINDOW		3U // Passing delay block phases needed to accept a prescaler
+#define EMXXLX_TUNE_PASSES			16U // Pattern reads needed to accept a dummy cycle setting
+
+/** @defgroup EMXXLX_Transfer_State EMXXLX Transfer State
+  * @{
+  */
+#define EMXXLX_XFER_IDLE						0x00U // No background transfer
+#define EMXXLX_XFER_RX_DMA						0x01U // DMA read ongoing
+#define EMXXLX_XFER_TX_DMA						0x02U // DMA write ongoing
+#define EMXXLX_XFER_RX_IT						0x03U // Interrupt driven read ongoing
+#define EMXXLX_XFER_TX_IT						0x04U // Interrupt driven write ongoing
+#define EMXXLX_XFER_POLL_IT						0x05U // Automatic polling of the ready flag ongoing
+#define EMXXLX_XFER_ERASE_IT					0x06U // Interrupt driven block erase ongoing
+/**
+  * @}
+  */
+
+/** @defgroup EMXXLX_Transfer_Step EMXXLX Transfer Step
+  * @{
+  */
+#define EMXXLX_STEP_WEL							0x00U // Write enable command ongoing
+#define EMXXLX_STEP_DATA						0x01U // Write data phase or block erase command ongoing
+#define EMXXLX_STEP_READY						0x02U // Automatic polling of the ready flag ongoing
+/**
+  * @}
+  */
+
+/** @defgroup EMXXLX_Xip_Confirmation EMXXLX Xip Confirmation
+  * @{
+  */
+#define EMXXLX_XIP_CONFIRM						0x00U // Confirmation bit 0, the next read has no opcode
+#define EMXXLX_XIP_EXIT							0x01U // Confirmation bit 1, the device leaves XIP mode
+/**
+  * @}
+  */
+
+/** @defgroup EMXXLX_Erase_Size EMXXLX Erase Size
+  * @{
+  */
+#define EMXXLX_ERASE_4KB						0x1000U // Subsector erased by MRAM_ERASE_4kB_SECTOR_CMD
+#define EMXXLX_ERASE_32KB						0x8000U // Subsector erased by MRAM_ERASE_32kB_SECTOR_CMD
+#define EMXXLX_ERASE_64KB						0x10000U // Sector erased by MRAM_ERASE_SECTOR_CMD
+/**
+  * @}
+  */
 
 /* Configuration Registers Values */
 
@@ -97,6 +496,7 @@ void jesd_reset();
 #define MRAM_ODTR_WO_DS							0xC7U // Octo DTR without DS
 #define MRAM_OSPI_W_DS							0xB7U // Octo SPI with DS
 #define MRAM_OSPI_WO_DS							0x97U // Octo SPI without DS
+#define MRAM_INTERFACE_DS						0x20U // Set in the interface modes with DS
 /**
   * @}
   */
@@ -140,6 +540,9 @@ void jesd_reset();
   * @}
   */
 
+/* Device Identification */
+#define MRAM_MANUFACTURER_ID					0x6BU // Everspin manufacturer ID, first byte of EMXXLX_Read_ID
+
 /* Driver Strength Configuration Values */
 #define MRAM_50_DRIVER_STR						0xFFU // Driver strength 50 Ohm
 #define MRAM_35_DRIVER_STR						0xFEU // Driver strength 35 Ohm
@@ -288,4 +691,8 @@ void jesd_reset();
 #define MRAM_READ_STATUS_REG_CMD				0x05U // Read status register data
 #define MRAM_READ_FLAGS_CMD						0x70U // Read flag status register data
 
+/* Flag Status Register */
+#define MRAM_FLAG_READY							0x80U // Device ready, no write or erase ongoing
+#define MRAM_AUTOPOLLING_INTERVAL				0x10U // Clock cycles between two automatic flag reads
+
 #endif /* INC_MRAM_H_ */